@@ -33,6 +33,7 @@
 
 #include "RGTextOutput.h"
 #include <iostream>
+#include <cstring>
 
 
 using namespace std;
@@ -138,6 +139,80 @@ Boolean RGTextOutput :: Write (int level, const char* s) {
 }
 
 
+Boolean RGTextOutput :: WriteFile (RGFile& source) {
+
+	char block [65536];
+	size_t nRead;
+	Boolean status = TRUE;
+
+	if (!TestCurrentLevel ())
+		return FALSE;
+
+	while ((nRead = fread (block, 1, sizeof (block), source.GetFile ())) > 0) {
+
+		if (!file->Write (block, nRead))
+			status = FALSE;
+
+		if (Echo)
+			cout.write (block, nRead);
+	}
+
+	if (source.Error ())
+		status = FALSE;
+
+	return status;
+}
+
+
+Boolean RGTextOutput :: WriteIntArray (const int* values, int numberOfValues, const RGString& delim) {
+
+	// Formats into a block and writes a block at a time; the text is that of writing values [0] << delim << values [1]...
+
+	char block [65536];
+	size_t delimLength = delim.Length ();
+	size_t position = 0;
+	Boolean status = TRUE;
+
+	if (!TestCurrentLevel ())
+		return FALSE;
+
+	// A delimiter too long for the block is written on its own
+
+	Boolean longDelim = (delimLength > 1024);
+	size_t delimInBlock = longDelim ? 0 : delimLength;
+
+	for (int i=0; i<numberOfValues; i++) {
+
+		if ((position + delimInBlock + 24 > sizeof (block)) || (longDelim && (i > 0) && (position > 0))) {
+
+			if (!WriteBlock (block, position))
+				status = FALSE;
+
+			position = 0;
+		}
+
+		if (i > 0) {
+
+			if (!longDelim) {
+
+				memcpy (block + position, delim.GetData (), delimLength);
+				position += delimLength;
+			}
+
+			else if (!WriteBlock (delim.GetData (), delimLength))
+				status = FALSE;
+		}
+
+		position += FormatInteger ((long)values [i], block + position);
+	}
+
+	if ((position > 0) && !WriteBlock (block, position))
+		status = FALSE;
+
+	return status;
+}
+
+
 RGTextOutput& RGTextOutput :: operator<<(const RGString& s) {
 
 	Write (s);
@@ -154,8 +229,7 @@ RGTextOutput& RGTextOutput :: operator<<(const char* s) {
 
 RGTextOutput& RGTextOutput :: operator<<(int i) {
 
-	GetString ((long)i);
-	file->Write (buffer);
+	file->Write (buffer, GetString ((long)i));
 
 	if (Echo)
 		cout << i;
@@ -166,8 +240,7 @@ RGTextOutput& RGTextOutput :: operator<<(int i) {
 
 RGTextOutput& RGTextOutput :: operator<<(double d) {
 
-	GetString (d);
-	file->Write (buffer);
+	file->Write (buffer, GetString (d));
 
 	if (Echo)
 		cout << d;
@@ -178,8 +251,7 @@ RGTextOutput& RGTextOutput :: operator<<(double d) {
 
 RGTextOutput& RGTextOutput :: operator<<(unsigned long i) {
 
-	GetString ((long)i);
-	file->Write (buffer);
+	file->Write (buffer, GetString ((long)i));
 
 	if (Echo)
 		cout << i;
@@ -201,8 +273,7 @@ RGTextOutput& RGTextOutput :: operator<<(char c) {
 
 RGTextOutput& RGTextOutput :: operator<<(long l) {
 
-	GetString (l);
-	file->Write (buffer);
+	file->Write (buffer, GetString (l));
 
 	if (Echo)
 		cout << l;
@@ -213,8 +284,7 @@ RGTextOutput& RGTextOutput :: operator<<(long l) {
 
 RGTextOutput& RGTextOutput :: operator<<(short s) {
 
-	GetString ((long)s);
-	file->Write (buffer);
+	file->Write (buffer, GetString ((long)s));
 
 	if (Echo)
 		cout << s;
@@ -225,8 +295,7 @@ RGTextOutput& RGTextOutput :: operator<<(short s) {
 
 RGTextOutput& RGTextOutput :: operator<<(unsigned char c) {
 
-	GetString ((long)c);
-	file->Write (buffer);
+	file->Write (buffer, GetString ((long)c));
 
 	if (Echo)
 		cout << c;
@@ -237,8 +306,7 @@ RGTextOutput& RGTextOutput :: operator<<(unsigned char c) {
 
 RGTextOutput& RGTextOutput :: operator<<(unsigned int i) {
 
-	GetString ((long)i);
-	file->Write (buffer);
+	file->Write (buffer, GetString ((long)i));
 
 	if (Echo)
 		cout << i;
@@ -249,8 +317,7 @@ RGTextOutput& RGTextOutput :: operator<<(unsigned int i) {
 
 RGTextOutput& RGTextOutput :: operator<<(unsigned short s) {
 
-	GetString ((long)s);
-	file->Write (buffer);
+	file->Write (buffer, GetString ((long)s));
 
 	if (Echo)
 		cout << s;
@@ -306,6 +373,17 @@ Boolean RGTextOutput :: TestCurrentLevel () const {
 
 
 
+Boolean RGTextOutput :: WriteBlock (const char* block, size_t length) {
+
+	Boolean status = file->Write (block, length);
+
+	if (Echo)
+		cout.write (block, length);
+
+	return status;
+}
+
+
 void RGTextOutput :: EndLine () {
 
 	file->Write ("\n", 1);
@@ -315,17 +393,55 @@ void RGTextOutput :: EndLine () {
 }
 
 
-void RGTextOutput :: GetString (long l) {
-	_ltoa (l, buffer, 10);
+size_t RGTextOutput :: GetString (long l) {
+
+	return FormatInteger (l, buffer);
 }
 
 
-void RGTextOutput :: GetString (double d) {
+size_t RGTextOutput :: GetString (double d) {
+
+	return FormatDouble (d, buffer);
+}
+
+
+size_t RGTextOutput :: FormatInteger (long l, char* str) {
+
+	// Same text as _ltoa (l, str, 10), without the library call and the strlen that follows it
+
+	char digits [24];
+	int n = 0;
+	size_t length = 0;
+	unsigned long value = (unsigned long)l;
+
+	if (l < 0) {
+
+		str [length++] = '-';
+		value = 0UL - value;
+	}
+
+	do {
+
+		digits [n++] = (char)('0' + (value % 10));
+		value /= 10;
+	} while (value > 0);
+
+	while (n > 0)
+		str [length++] = digits [--n];
+
+	str [length] = '\0';
+	return length;
+}
+
+
+size_t RGTextOutput :: FormatDouble (double d, char* str) {
+
+	gcvt (d, RGTextOutput::Resolution, str);
+	size_t l = strlen (str);
 
-	gcvt (d, RGTextOutput::Resolution, buffer);
-	size_t l = strlen (buffer);
+	if ((l > 0) && (str [l-1] == '.'))
+		str [--l] = '\0';
 
-	if ((l > 0) && (buffer [l-1] == '.'))
-		buffer [l-1] = '\0';
+	return l;
 }
 
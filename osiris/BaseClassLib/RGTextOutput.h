@@ -84,6 +84,22 @@ public:
 	virtual Boolean Write (int level, const RGString& s);
 	virtual Boolean Write (int level, const char* s);
 
+	// Copies the rest of source, a block at a time, at the current output level, so that temporary files can be
+	// appended without being read into memory
+
+	Boolean WriteFile (RGFile& source);
+
+	// Write the values separated by delim, at the current output level, formatting into a block rather than writing
+	// one token at a time.  The text is the same as writing the values and delimiters with operator<<.  FALSE if the
+	// output level is off or a write fails
+
+	Boolean WriteIntArray (const int* values, int numberOfValues, const RGString& delim);
+
+	// The text of operator<< for integers and doubles, into str; returns the length
+
+	static size_t FormatInteger (long l, char* str);
+	static size_t FormatDouble (double d, char* str);
+
 	virtual RGTextOutput& operator<<(const RGString& s);
 	virtual RGTextOutput& operator<<(const char* s);
 	virtual RGTextOutput& operator<<(int i);
@@ -111,8 +127,9 @@ private:
 
 	static int Resolution;
 
-	void GetString (long l);
-	void GetString (double d);
+	size_t GetString (long l);
+	size_t GetString (double d);
+	Boolean WriteBlock (const char* block, size_t length);
 };
 
 #endif  /*  _TEXTOUTPUT_H_  */
@@ -131,8 +131,11 @@ typedef unsigned char UINT8;
 
 #ifdef _WIN32
 typedef __int64 INT64;
+typedef unsigned __int64 UINT64;
 #else
+#include <stdint.h>
 typedef int64_t INT64;
+typedef uint64_t UINT64;
 #endif
 
 // the following 3 lines were commented out because
@@ -0,0 +1,246 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: rgmultisearch.cpp
+*
+*/
+//
+// class RGMultiStringSearch, a set of strings compiled into an Aho-Corasick automaton for case independent searches
+// of a target for all of them at once
+//
+
+#include "rgmultisearch.h"
+#include <cctype>
+
+
+const int RGMultiStringSearch::NumberOfCharacters = 256;
+
+
+RGMultiStringSearch :: RGMultiStringSearch () : mLargestId (-1), mCompiled (false) {
+
+}
+
+
+RGMultiStringSearch :: ~RGMultiStringSearch () {
+
+}
+
+
+void RGMultiStringSearch :: Clear () {
+
+	mStrings.clear ();
+	mIds.clear ();
+	mLargestId = -1;
+	mCompiled = false;
+}
+
+
+void RGMultiStringSearch :: AddString (const RGString& str, int id) {
+
+	mStrings.push_back (str);
+	mIds.push_back (id);
+
+	if (id > mLargestId)
+		mLargestId = id;
+
+	mCompiled = false;
+}
+
+
+int RGMultiStringSearch :: FindSmallestId (const RGString& target) {
+
+	if (!mCompiled)
+		Compile ();
+
+	const char* p = target.GetData ();
+	const char* end = p + target.Length ();
+	int node = 0;
+	int answer = -1;
+	int id;
+
+	for (; p<end; p++) {
+
+		node = mNext [node * NumberOfCharacters + Fold (*p)];
+		id = mSmallestId [node];
+
+		if ((id >= 0) && ((answer < 0) || (id < answer)))
+			answer = id;
+	}
+
+	return answer;
+}
+
+
+int RGMultiStringSearch :: FindAllIds (const RGString& target, vector<bool>& found) {
+
+	if (!mCompiled)
+		Compile ();
+
+	const char* p = target.GetData ();
+	const char* end = p + target.Length ();
+	int node = 0;
+	int output;
+	int nFound = 0;
+	size_t i;
+
+	found.assign (mLargestId + 1, false);
+
+	for (; p<end; p++) {
+
+		node = mNext [node * NumberOfCharacters + Fold (*p)];
+
+		for (output = mOutputLink [node]; output > 0; output = mOutputLink [mFailure [output]]) {
+
+			const vector<int>& ids = mEndingIds [output];
+
+			for (i=0; i<ids.size (); i++) {
+
+				if (!found [ids [i]]) {
+
+					found [ids [i]] = true;
+					nFound++;
+				}
+			}
+		}
+	}
+
+	return nFound;
+}
+
+
+void RGMultiStringSearch :: Compile () {
+
+	size_t i;
+	size_t j;
+	int node;
+	int next;
+	int c;
+	const char* p;
+	const char* end;
+
+	mNext.clear ();
+	mFailure.clear ();
+	mSmallestId.clear ();
+	mOutputLink.clear ();
+	mEndingIds.clear ();
+	NewNode ();
+
+	// the trie of folded strings; -1 marks a missing transition until the automaton is completed below
+
+	for (i=0; i<mStrings.size (); i++) {
+
+		if (mStrings [i].Length () == 0)
+			continue;
+
+		node = 0;
+		p = mStrings [i].GetData ();
+		end = p + mStrings [i].Length ();
+
+		for (; p<end; p++) {
+
+			c = Fold (*p);
+			next = mNext [node * NumberOfCharacters + c];
+
+			if (next < 0) {
+
+				next = NewNode ();
+				mNext [node * NumberOfCharacters + c] = next;
+			}
+
+			node = next;
+		}
+
+		mEndingIds [node].push_back (mIds [i]);
+
+		if ((mSmallestId [node] < 0) || (mIds [i] < mSmallestId [node]))
+			mSmallestId [node] = mIds [i];
+	}
+
+	// breadth first, so that failure links point to nodes already completed; missing transitions become the
+	// transitions of the failure node, making the automaton a complete DFA
+
+	vector<int> queue;
+	queue.reserve (mFailure.size ());
+
+	for (c=0; c<NumberOfCharacters; c++) {
+
+		next = mNext [c];
+
+		if (next < 0)
+			mNext [c] = 0;
+
+		else {
+
+			mFailure [next] = 0;
+			queue.push_back (next);
+		}
+	}
+
+	for (j=0; j<queue.size (); j++) {
+
+		node = queue [j];
+		int failure = mFailure [node];
+
+		if ((mSmallestId [failure] >= 0) && ((mSmallestId [node] < 0) || (mSmallestId [failure] < mSmallestId [node])))
+			mSmallestId [node] = mSmallestId [failure];
+
+		mOutputLink [node] = mEndingIds [node].empty () ? mOutputLink [failure] : node;
+
+		for (c=0; c<NumberOfCharacters; c++) {
+
+			next = mNext [node * NumberOfCharacters + c];
+
+			if (next < 0)
+				mNext [node * NumberOfCharacters + c] = mNext [failure * NumberOfCharacters + c];
+
+			else {
+
+				mFailure [next] = mNext [failure * NumberOfCharacters + c];
+				queue.push_back (next);
+			}
+		}
+	}
+
+	mCompiled = true;
+}
+
+
+int RGMultiStringSearch :: NewNode () {
+
+	int node = (int)mFailure.size ();
+	mNext.resize (mNext.size () + NumberOfCharacters, -1);
+	mFailure.push_back (0);
+	mSmallestId.push_back (-1);
+	mOutputLink.push_back (0);
+	mEndingIds.push_back (vector<int> ());
+	return node;
+}
+
+
+int RGMultiStringSearch :: Fold (char c) {
+
+	return (unsigned char) toupper ((unsigned char) c);
+}
+
@@ -0,0 +1,90 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: rgmultisearch.h
+*
+*/
+//
+// class RGMultiStringSearch, a set of strings, each with an integer id, compiled into an Aho-Corasick automaton so that
+// one pass over a target finds every string of the set that the target contains.  Comparisons are case independent,
+// with the results of RGString::FindSubstringCaseIndependent for each string:  an empty string is never found.  The
+// automaton is built on the first search after the set changes
+//
+
+#ifndef _RGMULTISEARCH_H_
+#define _RGMULTISEARCH_H_
+
+#include "rgdefs.h"
+#include "rgstring.h"
+#include <vector>
+
+using namespace std;
+
+
+class RGMultiStringSearch {
+
+public:
+	RGMultiStringSearch ();
+	~RGMultiStringSearch ();
+
+	void Clear ();
+	void AddString (const RGString& str, int id);   // id >= 0; several strings may share an id
+	int GetNumberOfStrings () const { return (int)mStrings.size (); }
+
+	// Smallest id of the strings contained in target, or -1 if there are none
+
+	int FindSmallestId (const RGString& target);
+
+	// Sets found [id] for the id of each string contained in target, resizing found to the largest id + 1.  Returns
+	// the number of distinct ids found
+
+	int FindAllIds (const RGString& target, vector<bool>& found);
+
+protected:
+	vector<RGString> mStrings;
+	vector<int> mIds;
+	int mLargestId;
+	bool mCompiled;
+
+	// Nodes of the trie:  goto transitions in mNext, NumberOfCharacters per node, and failure links.  mSmallestId is
+	// the smallest id ending at the node or at any node on its failure chain; mOutputLink is the nearest node on the
+	// failure chain, including the node itself, at which some string ends
+
+	vector<int> mNext;
+	vector<int> mFailure;
+	vector<int> mSmallestId;
+	vector<int> mOutputLink;
+	vector< vector<int> > mEndingIds;
+
+	static const int NumberOfCharacters;
+
+	void Compile ();
+	int NewNode ();
+	static int Fold (char c);
+};
+
+
+#endif  /*  _RGMULTISEARCH_H_  */
+
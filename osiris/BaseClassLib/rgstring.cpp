@@ -33,6 +33,7 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 #ifdef _WINDOWS
 #include <Windows.h>
 #include <stringapiset.h>
@@ -1450,11 +1451,42 @@ void RGString :: ReadStandardInputLine () {
 
 RGFile& RGString :: ReadTextFile (RGFile& f) {
 	
-	// Read to EOF or null character
+	// Read to EOF or null character, a block at a time rather than a character at a time
 	long fileSize = f.GetSizeOfFile ();
-	IncreaseSizeTo ((size_t)(1.1 * fileSize));
+	size_t blockSize = 65536;
+	size_t nRead;
+	char* text;
+	char* nullCharacter;
 
-	return ReadTextToDelimiter (f, '\0');
+	ResetData ();
+	Data->IncreaseSizeTo ((size_t)(1.1 * fileSize) + 1);
+
+	while (TRUE) {
+
+		if (StringLength + blockSize + 1 > Data->GetDataLength ())
+			Data->IncreaseSizeTo (StringLength + blockSize + 1);
+
+		text = Data->GetData () + StringLength;
+		nRead = fread (text, 1, Data->GetDataLength () - StringLength - 1, f.GetFile ());
+		text [nRead] = '\0';
+		nullCharacter = (char*)memchr (text, '\0', nRead);
+
+		if (nullCharacter != NULL) {
+
+			// The file is left after the block read, not just past the null character:  a relative seek is undefined on
+			// a text mode stream, and no caller reads on after the text
+
+			StringLength += nullCharacter - text;
+			break;
+		}
+
+		StringLength += nRead;
+
+		if (nRead == 0)
+			break;
+	}
+
+	return f;
 }
 
 
@@ -66,6 +66,7 @@ friend class RGStringTokenizer;
 friend class RGStringSearch;
 friend class RGCaseIndependentStringSearch;
 friend class RGSimpleString;
+friend class RGXMLView;
 
 PERSISTENT_DECLARATION (RGString)
 
@@ -153,6 +153,9 @@ RGPersistent* RGWarehouse :: FindType (int Target) {
 
 	Found = (RGIDWrapper*)ClassTypes->Find (&target);
 
+	if (Found == NULL)  // No class registered with this ID
+		return NULL;
+
 	if (RGWarehouse::DebugFlag) {
 
 		cout << "Found class object of type:  " << (Found->GetPointer ())->GetID ();
@@ -0,0 +1,444 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: rgxmlreader.cpp
+*
+*/
+//
+// class RGXMLView, a pointer and length into text owned by someone else, and class RGXMLReader, a single pass pull
+// reader over XML text
+//
+
+#include "rgxmlreader.h"
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+
+
+bool RGXMLView :: IsEqualTo (const char* str) const {
+
+	return (strncmp (mData, str, mLength) == 0) && (str [mLength] == '\0');
+}
+
+
+RGString RGXMLView :: GetString () const {
+
+	RGString answer;
+
+	if (mLength == 0)
+		return answer;
+
+	answer.IncreaseSizeTo (mLength + 1);
+	memcpy (answer.Data->GetData (), mData, mLength);
+	answer.Data->GetData () [mLength] = '\0';
+	answer.StringLength = mLength;
+	return answer;
+}
+
+
+void RGXMLView :: CopyTo (RGString& str) const {
+
+	const char* strData = str.Data->GetData ();
+
+	// The view may be into str itself
+
+	if ((mData >= strData) && (mData < strData + str.Data->GetDataLength ())) {
+
+		str = GetString ();
+		return;
+	}
+
+	str.ResetData ();
+	str.Data->IncreaseSizeTo (mLength + 1);
+	memcpy (str.Data->GetData (), mData, mLength);
+	str.Data->GetData () [mLength] = '\0';
+	str.StringLength = mLength;
+}
+
+
+int RGXMLView :: ConvertToInteger () const {
+
+	// The view need not be terminated, so convert from a terminated copy
+
+	char buffer [64];
+
+	if (mLength >= sizeof (buffer))
+		return GetString ().ConvertToInteger ();
+
+	memcpy (buffer, mData, mLength);
+	buffer [mLength] = '\0';
+	return (int)strtol (buffer, (char**)NULL, 10);
+}
+
+
+double RGXMLView :: ConvertToDouble () const {
+
+	char buffer [64];
+
+	if (mLength >= sizeof (buffer))
+		return GetString ().ConvertToDouble ();
+
+	memcpy (buffer, mData, mLength);
+	buffer [mLength] = '\0';
+	return strtod (buffer, (char**)NULL);
+}
+
+
+
+RGXMLReader :: RGXMLReader (const RGString& xml) : mBegin (xml.GetData ()), mEnd (xml.GetData () + xml.Length ()) {
+
+	Reset ();
+}
+
+
+RGXMLReader :: RGXMLReader (const RGXMLView& xml) : mBegin (xml.GetData ()), mEnd (xml.GetData () + xml.Length ()) {
+
+	Reset ();
+}
+
+
+RGXMLReader :: ~RGXMLReader () {
+
+}
+
+
+void RGXMLReader :: Reset () {
+
+	mCurrent = mTagStart = mBegin;
+	mEvent = EndOfDocument;
+	mDepth = mOpenElements = 0;
+	mEmptyElement = mPendingEnd = false;
+	mName = mAttributes = mText = RGXMLView ();
+}
+
+
+void RGXMLReader :: SetOffset (size_t offset) {
+
+	// Depths are counted from here
+
+	Reset ();
+
+	if (offset < (size_t)(mEnd - mBegin))
+		mCurrent = mBegin + offset;
+
+	else
+		mCurrent = mEnd;
+}
+
+
+int RGXMLReader :: Next () {
+
+	const char* p;
+	const char* nameEnd;
+
+	if (mPendingEnd) {
+
+		// the end of an empty element, <name/>
+
+		mPendingEnd = false;
+		mDepth = mOpenElements;
+		mOpenElements--;
+		mEvent = EndElement;
+		return mEvent;
+	}
+
+	mEmptyElement = false;
+
+	while (mCurrent < mEnd) {
+
+		if (*mCurrent != '<') {
+
+			p = (const char*)memchr (mCurrent, '<', mEnd - mCurrent);
+
+			if (p == NULL)
+				p = mEnd;
+
+			mText = RGXMLView (mCurrent, p - mCurrent);
+			mCurrent = p;
+			mEvent = Text;
+			return mEvent;
+		}
+
+		mTagStart = mCurrent;
+
+		if (IsAt ("<!--", 4)) {
+
+			p = Find (mCurrent + 4, "-->");
+			mCurrent = (p == NULL) ? mEnd : p + 3;
+			continue;
+		}
+
+		if (IsAt ("<![CDATA[", 9)) {
+
+			p = Find (mCurrent + 9, "]]>");
+
+			if (p == NULL)
+				p = mEnd;
+
+			mText = RGXMLView (mCurrent + 9, p - mCurrent - 9);
+			mCurrent = (p == mEnd) ? mEnd : p + 3;
+			mEvent = Text;
+			return mEvent;
+		}
+
+		if (IsAt ("<?", 2)) {
+
+			p = Find (mCurrent + 2, "?>");
+			mCurrent = (p == NULL) ? mEnd : p + 2;
+			continue;
+		}
+
+		if (IsAt ("<!", 2)) {
+
+			p = FindTagEnd (mCurrent + 2);
+			mCurrent = (p == NULL) ? mEnd : p + 1;
+			continue;
+		}
+
+		if (IsAt ("</", 2)) {
+
+			p = FindTagEnd (mCurrent + 2);
+
+			if (p == NULL)
+				break;
+
+			for (nameEnd = mCurrent + 2; (nameEnd < p) && !isspace ((unsigned char)*nameEnd); nameEnd++);
+
+			mName = RGXMLView (mCurrent + 2, nameEnd - mCurrent - 2);
+			mAttributes = RGXMLView ();
+			mDepth = mOpenElements;
+
+			if (mOpenElements > 0)
+				mOpenElements--;
+
+			mCurrent = p + 1;
+			mEvent = EndElement;
+			return mEvent;
+		}
+
+		p = FindTagEnd (mCurrent + 1);
+
+		if (p == NULL)
+			break;
+
+		for (nameEnd = mCurrent + 1; (nameEnd < p) && (*nameEnd != '/') && !isspace ((unsigned char)*nameEnd); nameEnd++);
+
+		mName = RGXMLView (mCurrent + 1, nameEnd - mCurrent - 1);
+		mEmptyElement = (p [-1] == '/');
+		const char* attributes = nameEnd;
+		const char* attributesEnd = mEmptyElement ? p - 1 : p;
+
+		while ((attributes < attributesEnd) && isspace ((unsigned char)*attributes))
+			attributes++;
+
+		mAttributes = RGXMLView (attributes, attributesEnd - attributes);
+
+		mOpenElements++;
+		mDepth = mOpenElements;
+		mPendingEnd = mEmptyElement;
+		mCurrent = p + 1;
+		mEvent = StartElement;
+		return mEvent;
+	}
+
+	mCurrent = mEnd;
+	mEvent = EndOfDocument;
+	return mEvent;
+}
+
+
+bool RGXMLReader :: ReadContent (RGXMLView& content) {
+
+	if (mEvent != StartElement)
+		return false;
+
+	const char* start = mCurrent;
+	int depth = mDepth;
+
+	if (mEmptyElement) {
+
+		content = RGXMLView (start, 0);
+		Next ();
+		return true;
+	}
+
+	while (Next () != EndOfDocument) {
+
+		if ((mEvent == EndElement) && (mDepth == depth)) {
+
+			content = RGXMLView (start, mTagStart - start);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+bool RGXMLReader :: ReadContent (RGString& content) {
+
+	RGXMLView view;
+
+	if (!ReadContent (view))
+		return false;
+
+	view.CopyTo (content);
+	return true;
+}
+
+
+bool RGXMLReader :: SkipElement () {
+
+	RGXMLView content;
+	return ReadContent (content);
+}
+
+
+bool RGXMLReader :: FindNextElement (const char* name) {
+
+	RGXMLReader saved (*this);
+
+	while (Next () != EndOfDocument) {
+
+		if ((mEvent == StartElement) && (mName == name))
+			return true;
+	}
+
+	*this = saved;
+	return false;
+}
+
+
+bool RGXMLReader :: FindNextElement (const char* name, RGXMLView& content) {
+
+	RGXMLReader saved (*this);
+
+	if (!FindNextElement (name))
+		return false;
+
+	if (!ReadContent (content)) {
+
+		*this = saved;
+		return false;
+	}
+
+	return true;
+}
+
+
+bool RGXMLReader :: FindNextElement (const char* name, RGString& content) {
+
+	RGXMLView view;
+
+	if (!FindNextElement (name, view))
+		return false;
+
+	view.CopyTo (content);
+	return true;
+}
+
+
+bool RGXMLReader :: FindNextNonemptyElement (const char* name, RGXMLView& content) {
+
+	RGXMLReader saved (*this);
+
+	while (FindNextElement (name, content)) {
+
+		if (!content.IsEmpty ())
+			return true;
+	}
+
+	*this = saved;
+	return false;
+}
+
+
+bool RGXMLReader :: FindNextNonemptyElement (const char* name, RGString& content) {
+
+	RGXMLView view;
+
+	if (!FindNextNonemptyElement (name, view))
+		return false;
+
+	view.CopyTo (content);
+	return true;
+}
+
+
+bool RGXMLReader :: IsAt (const char* prefix, size_t length) const {
+
+	// a view need not be terminated at mEnd, so never compare past it
+
+	return ((size_t)(mEnd - mCurrent) >= length) && (strncmp (mCurrent, prefix, length) == 0);
+}
+
+
+const char* RGXMLReader :: Find (const char* from, const char* target) const {
+
+	size_t length = strlen (target);
+	const char* p = from;
+
+	while (p + length <= mEnd) {
+
+		p = (const char*)memchr (p, target [0], mEnd - p);
+
+		if ((p == NULL) || (p + length > mEnd))
+			return NULL;
+
+		if (strncmp (p, target, length) == 0)
+			return p;
+
+		p++;
+	}
+
+	return NULL;
+}
+
+
+const char* RGXMLReader :: FindTagEnd (const char* from) const {
+
+	// the closing '>' of a tag, skipping quoted attribute values
+
+	const char* p;
+	char quote = '\0';
+
+	for (p=from; p<mEnd; p++) {
+
+		if (quote != '\0') {
+
+			if (*p == quote)
+				quote = '\0';
+		}
+
+		else if ((*p == '"') || (*p == '\''))
+			quote = *p;
+
+		else if (*p == '>')
+			return p;
+	}
+
+	return NULL;
+}
+
@@ -0,0 +1,130 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: rgxmlreader.h
+*
+*/
+//
+// class RGXMLView, a pointer and length into text owned by someone else, and class RGXMLReader, a single pass pull
+// reader over XML text.  The reader never copies:  names, text and element contents are views into the original buffer,
+// which must outlive the reader and its views.  Element contents are the raw markup between the start and end tags, as
+// returned by RGXMLTagSearch, and FindNextElement has RGXMLTagSearch's semantics (next element of that name anywhere
+// after the current position, in document order), so loaders written as a sequence of tag searches can move over
+// without rescanning or copying subtrees
+//
+
+#ifndef _RGXMLREADER_H_
+#define _RGXMLREADER_H_
+
+#include "rgdefs.h"
+#include "rgstring.h"
+#include <cstddef>
+
+
+class RGXMLView {
+
+public:
+	RGXMLView () : mData (NULL), mLength (0) {}
+	RGXMLView (const char* data, size_t length) : mData (data), mLength (length) {}
+	RGXMLView (const RGString& str) : mData (str.GetData ()), mLength (str.Length ()) {}
+	~RGXMLView () {}
+
+	const char* GetData () const { return mData; }
+	size_t Length () const { return mLength; }
+	bool IsEmpty () const { return mLength == 0; }
+
+	bool IsEqualTo (const char* str) const;
+	bool operator== (const char* str) const { return IsEqualTo (str); }
+	bool operator!= (const char* str) const { return !IsEqualTo (str); }
+
+	RGString GetString () const;
+	void CopyTo (RGString& str) const;
+	int ConvertToInteger () const;
+	double ConvertToDouble () const;
+
+protected:
+	const char* mData;
+	size_t mLength;
+};
+
+
+class RGXMLReader {
+
+public:
+	RGXMLReader (const RGString& xml);
+	RGXMLReader (const RGXMLView& xml);
+	~RGXMLReader ();
+
+	enum {EndOfDocument, StartElement, EndElement, Text};
+
+	void Reset ();
+	void SetOffset (size_t offset);   // resumes reading at an offset from an earlier GetOffset or tag search
+	int Next ();   // advances to and returns the next event; comments, processing instructions and declarations are skipped
+
+	int GetEvent () const { return mEvent; }
+	const RGXMLView& GetName () const { return mName; }   // StartElement and EndElement
+	const RGXMLView& GetAttributes () const { return mAttributes; }   // StartElement:  raw text between the name and the '>'
+	const RGXMLView& GetText () const { return mText; }   // Text:  raw characters, entities not expanded
+	int GetDepth () const { return mDepth; }   // StartElement and EndElement:  1 for the document element
+	bool IsEmptyElement () const { return mEmptyElement; }
+	size_t GetOffset () const { return (size_t)(mCurrent - mBegin); }   // offset of the next unread character
+
+	// From a StartElement:  the contents of the element, leaving the reader at its EndElement.  False if there is no end tag
+
+	bool ReadContent (RGXMLView& content);
+	bool ReadContent (RGString& content);
+	bool SkipElement ();
+
+	// Next element with this name after the current position, at any depth.  On success, the reader is left at the
+	// element's EndElement; otherwise it is left where it was
+
+	bool FindNextElement (const char* name, RGXMLView& content);
+	bool FindNextElement (const char* name, RGString& content);
+	bool FindNextElement (const char* name);   // leaves the reader at the StartElement
+	bool FindNextNonemptyElement (const char* name, RGXMLView& content);
+	bool FindNextNonemptyElement (const char* name, RGString& content);
+
+protected:
+	const char* mBegin;
+	const char* mEnd;
+	const char* mCurrent;
+	const char* mTagStart;
+	int mEvent;
+	int mDepth;
+	int mOpenElements;
+	bool mEmptyElement;
+	bool mPendingEnd;
+	RGXMLView mName;
+	RGXMLView mAttributes;
+	RGXMLView mText;
+
+	bool IsAt (const char* prefix, size_t length) const;   // the next length characters are prefix
+	const char* Find (const char* from, const char* target) const;
+	const char* FindTagEnd (const char* from) const;
+};
+
+
+#endif  /*  _RGXMLREADER_H_  */
+
@@ -86,6 +86,7 @@
 #include "CPanelSampleAlertNotebook.h"
 #include "COsirisIcon.h"
 #include "CPanelPlotPreview.h"
+#include "CPlotData.h"
 #include "CMenuSort.h"
 #include "CMenuBar.h"
 #include "CGridLocusPeaks.h"
@@ -891,6 +892,10 @@ void CFrameAnalysis::CheckSelectionXML(bool bForceUpdate)
     {
       _UpdatePreview();
     }
+    if(bNewRow)
+    {
+      _PrefetchPlots(nRow);
+    }
     UpdateStatusBar();
     m_pButtonEdit->Enable(bEdit);
     bSelection = false; // force SelectBlock() below
@@ -2001,6 +2006,43 @@ void CFrameAnalysis::_UpdatePreview()
     _SetPreviewMenu(m_pPanelPlotPreview->GetMenu());
   }
 }
+void CFrameAnalysis::_PrefetchPlots(int nRow)
+{
+  // parse the plot files of the samples above and below this
+  // one in the background, nearest first, so that the preview
+  // and plot windows find them parsed.  Moving to another row
+  // drops the files not parsed yet.  The plot file name is
+  // found from the sample's summary, so the samples are not loaded
+  const int PREFETCH_COUNT = 3;
+  vector<wxString> vsFiles;
+  if(_XmlFile() && (nRow >= 0))
+  {
+    int nCount = (int)m_SampleSort.GetCount();
+    int anRow[2];
+    COARsample *pSample;
+    wxString sFile;
+    vsFiles.reserve(PREFETCH_COUNT + PREFETCH_COUNT);
+    for(int i = 1; i <= PREFETCH_COUNT; i++)
+    {
+      anRow[0] = nRow + i;
+      anRow[1] = nRow - i;
+      for(int j = 0; j < 2; j++)
+      {
+        pSample = ((anRow[j] >= 0) && (anRow[j] < nCount))
+          ? m_SampleSort.GetSampleNoLoad((size_t)anRow[j]) : NULL;
+        if(pSample != NULL)
+        {
+          sFile = pSample->GetPlotFileName();
+          if(!(sFile.IsEmpty() || m_pParent->FileInProgress(sFile)))
+          {
+            vsFiles.push_back(sFile);
+          }
+        }
+      }
+    }
+  }
+  CPlotDataCache::Prefetch(vsFiles);
+}
 void CFrameAnalysis::DoAcceptLocus(COARsample *pSample, COARlocus *pLocus)
 {
   if(_XmlFile() && 
@@ -2413,7 +2455,9 @@ void CFrameAnalysis::RepaintAllData(const COARsample *p)
   {
     pF->RepaintData();
   }
-  RepaintData();
+  m_pGrid->InvalidateSample(p);
+  m_SampleSort.SampleChanged(const_cast<COARsample *>(p));
+  _PostRepaint();
 }
 
 bool CFrameAnalysis::_CheckPromptNewer()
@@ -3135,7 +3179,8 @@ void CFrameAnalysis::OnSortGrid(wxCommandEvent &e)
       m_pGrid->SetGridCursor((int)nNew,nCol);
     }
   }
-  RepaintData();
+  // the samples are reordered but not changed
+  _PostRepaint();
 }
 
 bool CFrameAnalysis::FileNeedsAttention(bool bCMF, bool bShowMessage)
@@ -181,13 +181,10 @@ public:
   virtual bool FileError();
   void RepaintData()
   {
-    //
-    //  need to defer repaint because it can destroy
-    //  a panel whose event is currently being processed
-    //
-    wxCommandEvent ee(CEventRepaint,GetId());
-    ee.SetEventObject(this);
-    GetEventHandler()->AddPendingEvent(ee);
+    // any sample may have changed
+    m_pGrid->InvalidateAll();
+    m_SampleSort.AllChanged();
+    _PostRepaint();
   }
   void RepaintAllData(const COARsample *p);
   bool FileEmpty();
@@ -282,6 +279,7 @@ private:
   void _OnDeleteDisabled();
   int _GetPreviewColumn();
   void _UpdatePreview();
+  void _PrefetchPlots(int nRow);
   void _SetupLocusPanel(COARsample *pSample, int nChannel, const wxString &sLocusName);
   void _LayoutInfo(wxWindow *pChild);
   void _SetupStatusPanel(COARsample *pSample);
@@ -506,6 +504,16 @@ private:
   bool LoadFile(const wxString &sFileName);
   bool DisplayFile();
   void RepaintGridXML();
+  void _PostRepaint()
+  {
+    //
+    //  need to defer repaint because it can destroy
+    //  a panel whose event is currently being processed
+    //
+    wxCommandEvent ee(CEventRepaint,GetId());
+    ee.SetEventObject(this);
+    GetEventHandler()->AddPendingEvent(ee);
+  }
   void _UpdatePreviewLabelType(int n);
 
 public:
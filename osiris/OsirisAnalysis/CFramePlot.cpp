@@ -436,7 +436,7 @@ CFramePlot::~CFramePlot()
   mainApp::Ping2(PING_EVENT, PING_WINDOW_CLOSE PING_WINDOW_TYPE, PING_WINDOW_NUMBER, GetFrameNumber());
   _CleanupMenuHistoryPopup();
   _CleanupMenuPopup();
-  delete m_pData;
+  CPlotDataCache::Release(m_pData);
 ////  delete m_pMenu;
   _CleanupExportDialog();
 }
@@ -1272,12 +1272,14 @@ void CFramePlot::CheckFileModification()
         {
           if(!sPLTfile.IsEmpty())
           {
-            auto_ptr<CPlotData> pPlotDataHole(m_pData);
-            m_pData = new CPlotData();
-            bReloadPlot = m_pData->LoadFile(sPLTfile);
+            CPlotData *pData = CPlotDataCache::Acquire(sPLTfile);
+            bReloadPlot = (pData != NULL);
             if(bReloadPlot)
             {
+              CPlotData *pPlotDataHole = m_pData;
+              m_pData = pData;
               RebuildAll();
+              CPlotDataCache::Release(pPlotDataHole);
             }
             else
             {
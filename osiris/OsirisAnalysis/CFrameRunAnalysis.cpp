@@ -37,18 +37,23 @@
 *  Author:   Douglas Hoffman
 *
 */
+#include "nwx/stdb.h"
 #include <memory>
+#include <algorithm>
+#include "nwx/stde.h"
 #include "mainApp.h"
 #include <wx/filename.h>
 #include <wx/utils.h>
 #include <wx/mstream.h>
 #include <wx/notebook.h>
+#include <wx/thread.h>
 #include "nwx/nwxTabOrder.h"
 #include "nwx/nwxColorUtil.h"
 #include "nwx/nwxXmlMRU.h"
 #include "nwx/nwxBatch.h"
 // #include "nwx/CPointerHold.h"
 #include "nwx/nwxFileUtil.h"
+#include "nwx/vectorptr.h"
 #include "CFrameRunAnalysis.h"
 #include "CProcessAnalysis.h"
 #include "mainFrame.h"
@@ -84,7 +89,6 @@ CFrameRunAnalysis::CFrameRunAnalysis(
   m_pLabelElapsed(NULL),
   m_pTextOutput(NULL),
   m_pTextErrors(NULL),
-  m_pAnalysis(NULL),
 //  m_pSizer(NULL),
   m_pListDir(NULL),
 //  m_pDlgAnalysis(NULL),
@@ -120,7 +124,6 @@ CFrameRunAnalysis::CFrameRunAnalysis(
   m_pLabelElapsed(NULL),
   m_pTextOutput(NULL),
   m_pTextErrors(NULL),
-  m_pAnalysis(NULL),
 //m_pSizer(NULL),
   m_pListDir(NULL),
 //  m_pDlgAnalysis(NULL),
@@ -188,7 +191,6 @@ CFrameRunAnalysis::CFrameRunAnalysis(
   m_pLabelElapsed(NULL),
   m_pTextOutput(NULL),
   m_pTextErrors(NULL),
-  m_pAnalysis(NULL),
 //  m_pSizer(NULL),
   m_pListDir(NULL),
 //  m_pDlgAnalysis(NULL),
@@ -251,7 +253,6 @@ CFrameRunAnalysis::CFrameRunAnalysis(
   m_pLabelElapsed(NULL),
   m_pTextOutput(NULL),
   m_pTextErrors(NULL),
-  m_pAnalysis(NULL),
 //  m_pSizer(NULL),
   m_pListDir(NULL),
 //  m_pDlgAnalysis(NULL),
@@ -430,7 +431,6 @@ void CFrameRunAnalysis::UpdateOutputText()
   wxString sValue;
   wxString sValueError;
   const wxString SPACER("\n--------------------\n\n");
-  long nCurrent = -1;
   long nCount = (long)m_DirList.GetCount();
   long nInsertionPoint = m_pTextOutput->GetInsertionPoint();
   long nSize = (long) m_pTextOutput->GetValue().Len();
@@ -438,26 +438,27 @@ void CFrameRunAnalysis::UpdateOutputText()
   long nEnd = nCount;
   int nItemCount = m_pListDir->GetSelectedItemCount();
   bool bDoAll = (nCount == 1) || (nCount && !nItemCount);
+  bool bRunningOnly = false;
 
-  if(m_pAnalysis != NULL)
+  if(!m_vpAnalysis.empty() && !nItemCount)
   {
-    nCurrent = m_pAnalysis->GetDirEntry()->GetIndex();
-    if(!nItemCount)
-    {
-      nStart = nCurrent;
-      nEnd = nCurrent + 1;
-      bDoAll = true;
-    }
+    // nothing is selected, show the analyses now running
+    bRunningOnly = true;
+    bDoAll = true;
   }
   wxString sTemp;
   bool bOldAnalysis = m_bFile;
-  size_t nAlloc = bDoAll ? 1 : nItemCount;
+  size_t nAlloc = bRunningOnly
+    ? m_vpAnalysis.size()
+    : (bDoAll ? 1 : nItemCount);
   sValue.Alloc(nAlloc << 13);
   sValueError.Alloc(nAlloc << 5);
 
   for(long i = nStart; i < nEnd; i++)
   {
-    if(bDoAll || m_pListDir->IsSelected(i))
+    if(bRunningOnly
+      ? (m_DirList.At((size_t)i)->GetStatus() == DIRENTRY_RUNNING)
+      : (bDoAll || m_pListDir->IsSelected(i)))
     {
       CDirEntry *pEntry = m_DirList.At(i);
       bOldAnalysis = pEntry->OlderThanErrorLog();
@@ -589,17 +590,9 @@ void CFrameRunAnalysis::_RunAutoExport(CDirEntry *pEntry)
     wxXml2ReceiverHolder xmlrh(this);
     wxBusyCursor yyy;
     const wxString &sFile = pEntry->GetOutputFile();
-    vector<CXSLExportFileType *>::iterator itr;
-    CXSLExportFileType *pXSL;
-    for(itr = vXSL.begin();
-      itr != vXSL.end();
-      ++itr)
+    if(!CXSLExportFileType::AutoTransform(vXSL,sFile))
     {
-      pXSL = *itr;
-      if(!pXSL->AutoTransform(sFile))
-      {
-        pEntry->SetStatus(DIRENTRY_EXPORT_ERROR);
-      }
+      pEntry->SetStatus(DIRENTRY_EXPORT_ERROR);
     }
   }
   // wxXml2ReceiverHolder xxx needs to be out of scope when appending errors
@@ -618,20 +611,87 @@ void CFrameRunAnalysis::_RunAutoExport(CDirEntry *pEntry)
 }
 void CFrameRunAnalysis::OnTimer(wxTimerEvent &)
 {
-  if(m_pAnalysis != NULL)
+  if(!m_vpAnalysis.empty())
   {
-    bool bMod =
-      m_pListDir->IsSelected(m_pAnalysis->GetDirEntry()->GetIndex())
-      ;
-    bool bData = bMod && m_pAnalysis->IsOutputModified();
-    if(m_pAnalysis->IsRunning())
+    // iterate a copy, finished analyses are removed from m_vpAnalysis
+
+    vector<CProcessAnalysis *> vpAnalysis(m_vpAnalysis);
+    vector<CProcessAnalysis *>::iterator itr;
+    auto_ptr<nwxMRUBatch> pBatch(NULL);
+    double dProgress = 0.0;
+    size_t nRunning = 0;
+    bool bUpdate = false;
+    bool bEnded = false;
+    for(itr = vpAnalysis.begin(); itr != vpAnalysis.end(); ++itr)
     {
-      //  OS-679 - removed because access time is unreliable
-      //m_volume.SetInUseOnTimer(e.GetInterval());
-      if(m_pAnalysis->ProcessIO(8192))
+      CProcessAnalysis *pAnalysis = *itr;
+      CDirEntry *pEntry = pAnalysis->GetDirEntry();
+      long ndx = pEntry->GetIndex();
+      bool bMod = m_pListDir->IsSelected(ndx);
+      bool bData = bMod && pAnalysis->IsOutputModified();
+      if(pAnalysis->IsRunning())
+      {
+        //  OS-679 - removed because access time is unreliable
+        //m_volume.SetInUseOnTimer(e.GetInterval());
+        if(pAnalysis->ProcessIO(8192))
+        {
+          bData = true;
+        }
+        dProgress += pAnalysis->GetProgress();
+        nRunning++;
+        m_pListDir->UpdateProgress((int) ndx, pAnalysis->GetProgress());
+      }
+      else
+      {
+        for(int i = 0; pAnalysis->ProcessIO() && (i < 3); i++)
+        {
+          // processIO for up to three seconds
+          ::wxSleep(1);
+          bData = true;
+        }
+        int nExit = pAnalysis->GetExitStatus();
+        CDirEntryStatus nStatus =
+          nExit
+          ? DIRENTRY_ERROR
+          : DIRENTRY_DONE;
+        bool bOpenOne = false;
+        mainApp::Ping2(PING_EVENT, "AnalysisDone", "return", nwxString::FormatNumber(nExit));
+        if(pEntry->GetStatus() == DIRENTRY_RUNNING)
+        {
+          // process ended and the user did NOT cancel;
+          pEntry->SetStatus(nStatus);
+          pEntry->SetStopTime();
+          bOpenOne = (nStatus == DIRENTRY_DONE);
+          if(bOpenOne)
+          {
+            _RunAutoExport(pEntry);
+          }
+        }
+        m_pListDir->UpdateStatus((int) ndx);
+        m_vpAnalysis.erase(
+          find(m_vpAnalysis.begin(), m_vpAnalysis.end(), pAnalysis));
+        delete pAnalysis;
+        bEnded = true;
+
+        if(m_DirList.GetCount() == 1)
+        {
+          m_pGauge->SetValue(0);
+          if(bOpenOne)
+          {
+            auto_ptr<nwxMRUBatch> _pBatch(new nwxMRUBatch(mainApp::GetMRU()));
+            pBatch = _pBatch;  // destructor will be called after _Run()
+            // bOpenOne is true only if the user did not cancel
+            m_pParent->OpenFile(pEntry->GetOutputFile());
+          }
+        }
+      }
+      if(bMod && bData)
       {
-        bData = true;
+        bUpdate = true;
       }
+    }
+    if(nRunning)
+    {
       wxString sValue;
       time_t tElapsed;
       time(&tElapsed);
@@ -654,59 +714,21 @@ void CFrameRunAnalysis::OnTimer(wxTimerEvent &)
         sValue = wxString::Format("%02ld:%02ld",nMin,nSec);
       }
       m_pLabelElapsed->SetLabel(sValue);
-      int nProgress = (int)floor(m_pAnalysis->GetProgress() * 4.0 + 0.5);
+
+      // the gauge shows the average progress of the running analyses
+
+      dProgress /= (double) nRunning;
+      int nProgress = (int)floor(dProgress * 4.0 + 0.5);
       m_pGauge->SetValue(nProgress);
     }
-    else
+    if(bEnded)
     {
-      for(int i = 0; m_pAnalysis->ProcessIO() && (i < 3); i++)
-      {
-        // processIO for up to three seconds
-        ::wxSleep(1);
-        bData = true;
-      }
-      CDirEntry *pEntry = m_pAnalysis->GetDirEntry();
-      long ndx = pEntry->GetIndex();
-      int nExit = m_pAnalysis->GetExitStatus();
-      CDirEntryStatus nStatus =
-        nExit
-        ? DIRENTRY_ERROR
-        : DIRENTRY_DONE;
-      wxString sStatus;
-      bool bOpenOne = false;
-      mainApp::Ping2(PING_EVENT, "AnalysisDone", "return", nwxString::FormatNumber(nExit));
-      if(pEntry->GetStatus() == DIRENTRY_RUNNING)
-      {
-        // process ended and the user did NOT cancel;
-        pEntry->SetStatus(nStatus);
-        pEntry->SetStopTime();
-        bOpenOne = (nStatus == DIRENTRY_DONE);
-        if(bOpenOne)
-        {
-          _RunAutoExport(pEntry);
-        }
-      }
-      m_pListDir->UpdateStatus((int) ndx);
-      Cleanup(); // deletes m_pAnalysis and sets it to NULL
-
-      auto_ptr<nwxMRUBatch> pBatch(NULL);
-      if(m_DirList.GetCount() == 1)
-      {
-        m_pGauge->SetValue(0);
-        if(bOpenOne)
-        {
-          auto_ptr<nwxMRUBatch> _pBatch(new nwxMRUBatch(mainApp::GetMRU()));
-          pBatch = _pBatch;  // destructor will be called after _Run()
-          // bOpenOne is true only if the user did not cancel
-          m_pParent->OpenFile(pEntry->GetOutputFile());
-        }
-      }
-      _Run();  // run next item or save results in .obr file
+      _Run();  // run next items or save results in .obr file
       UpdateButtonState();
     }
-    if(bMod && bData)
+    else if(bUpdate)
     {
-      UpdateOutputText();
+      UpdateOutputText(); // _Run() has already done this
     }
   }
 }
@@ -729,7 +751,7 @@ bool CFrameRunAnalysis::IsDone()
 
 bool CFrameRunAnalysis::CheckIsDone()
 {
-  if(m_pAnalysis != NULL)
+  if(!m_vpAnalysis.empty())
   {
     wxCommandEvent e;
     OnButtonCancelAll(e);
@@ -972,11 +994,24 @@ void CFrameRunAnalysis::OnButtonCancel(wxCommandEvent &)
 }
 void CFrameRunAnalysis::DoCancel(bool bCancelAll)
 {
-  if( (m_pAnalysis != NULL) && m_pAnalysis->IsRunning() )
+  vector<CProcessAnalysis *>::iterator itr;
+  bool bRunning = false;
+  for(itr = m_vpAnalysis.begin();
+    (!bRunning) && (itr != m_vpAnalysis.end());
+    ++itr)
+  {
+    bRunning = (*itr)->IsRunning();
+  }
+  if(bRunning)
   {
     bool bCancel = false;
     {
-      nwxProcessPause x(m_pAnalysis);
+      vectorptr<nwxProcessPause> vPause;
+      vPause.reserve(m_vpAnalysis.size());
+      for(itr = m_vpAnalysis.begin(); itr != m_vpAnalysis.end(); ++itr)
+      {
+        vPause.push_back(new nwxProcessPause(*itr));
+      }
       wxString sMessage("Do you want to cancel the analysis?");
       wxMessageDialog d(
         this,sMessage,"Cancel", wxYES | wxNO | wxICON_QUESTION);
@@ -988,18 +1023,19 @@ void CFrameRunAnalysis::DoCancel(bool bCancelAll)
     {
       long nCount = (long) m_pListDir->GetItemCount();
       CDirEntry *pEntry;
-      if((m_pAnalysis != NULL) && m_pAnalysis->IsRunning())
+      for(itr = m_vpAnalysis.begin(); itr != m_vpAnalysis.end(); ++itr)
       {
-        pEntry = m_pAnalysis->GetDirEntry();
-        if(bCancelAll || m_pListDir->IsSelected(pEntry->GetIndex()))
+        CProcessAnalysis *pAnalysis = *itr;
+        pEntry = pAnalysis->GetDirEntry();
+        if( pAnalysis->IsRunning() &&
+          (bCancelAll || m_pListDir->IsSelected(pEntry->GetIndex())) )
         {
-          m_pAnalysis->Cancel();
-          while(m_pAnalysis->IsRunning())
+          // OnTimer() removes the analysis after it ends
+          pAnalysis->Cancel();
+          while(pAnalysis->IsRunning())
           {
-            m_pAnalysis->ProcessIO();
+            pAnalysis->ProcessIO();
           }
-          // m_pAnalysis->Wait();
-//          Cleanup();
           pEntry->SetStatus(DIRENTRY_CANCELED);
           pEntry->CleanupFiles();
           m_pListDir->UpdateStatus((int)pEntry->GetIndex());
@@ -1023,41 +1059,67 @@ void CFrameRunAnalysis::DoCancel(bool bCancelAll)
 }
 //////////////////////////////////////////////////////////////////////
 //                                                                Run
-void CFrameRunAnalysis::_Run()
+size_t CFrameRunAnalysis::_GetMaxConcurrent()
 {
-  CDirEntry *pDirEntry;
-  if(m_pAnalysis != NULL) {;} // do nothing
-  else if( (pDirEntry = NextDirEntry()) != NULL )
+  // the number of analyses to run at once,
+  // if not set, half of the processors
+  int n = CParmOsiris::GetGlobal()->GetMaxConcurrentAnalyses();
+  if(n < 1)
   {
-    wxString sOutputDir(pDirEntry->GetOutputDir());
-    bool bRunning = false;
-    pDirEntry->ClearStartStopTime();
-    if(wxFileName::Mkdir(sOutputDir,0755,wxPATH_MKDIR_FULL))
-    {
-      CParmOsiris parm(m_parmOsiris);
-      parm.SetInputDirectory(pDirEntry->GetInputDir());
-      parm.SetOutputDirectory(sOutputDir);
-      pDirEntry->SetParmOsiris(parm);
-      pDirEntry->SetStartTime();
-      mainApp::Ping2(PING_EVENT, "Analysis", "kit", m_volume.GetKitName());
-      m_pAnalysis = new CProcessAnalysis(pDirEntry,&m_volume,this,IDprocess);
-      bRunning = m_pAnalysis->IsRunning();
-      pDirEntry->SetStatus(
-        bRunning ? DIRENTRY_RUNNING : DIRENTRY_ERROR);
-      if(!bRunning)
-      {
-        pDirEntry->SetStopTime();
-      }
-    }
-    else
+    n = wxThread::GetCPUCount() / 2;
+  }
+  if(n < 1)
+  {
+    n = 1;
+  }
+  return (size_t) n;
+}
+bool CFrameRunAnalysis::_RunEntry(CDirEntry *pDirEntry)
+{
+  wxString sOutputDir(pDirEntry->GetOutputDir());
+  bool bRunning = false;
+  pDirEntry->ClearStartStopTime();
+  if(wxFileName::Mkdir(sOutputDir,0755,wxPATH_MKDIR_FULL))
+  {
+    CParmOsiris parm(m_parmOsiris);
+    parm.SetInputDirectory(pDirEntry->GetInputDir());
+    parm.SetOutputDirectory(sOutputDir);
+    pDirEntry->SetParmOsiris(parm);
+    pDirEntry->SetStartTime();
+    mainApp::Ping2(PING_EVENT, "Analysis", "kit", m_volume.GetKitName());
+    CProcessAnalysis *pAnalysis =
+      new CProcessAnalysis(pDirEntry,&m_volume,this,IDprocess);
+    m_vpAnalysis.push_back(pAnalysis);
+    bRunning = pAnalysis->IsRunning();
+    pDirEntry->SetStatus(
+      bRunning ? DIRENTRY_RUNNING : DIRENTRY_ERROR);
+    if(!bRunning)
     {
-      mainApp::Ping2(PING_EVENT, "AnalysisError", PING_ERROR, "CannotCreateOutputDir");
-      pDirEntry->SetStatus(DIRENTRY_ERROR);
-      pDirEntry->AppendRunOutput("Cannot create output directory:\n  ");
-      pDirEntry->AppendRunOutput(sOutputDir);
+      pDirEntry->SetStopTime();
     }
-    m_pListDir->UpdateStatus(pDirEntry->GetIndex());
   }
+  else
+  {
+    mainApp::Ping2(PING_EVENT, "AnalysisError", PING_ERROR, "CannotCreateOutputDir");
+    pDirEntry->SetStatus(DIRENTRY_ERROR);
+    pDirEntry->AppendRunOutput("Cannot create output directory:\n  ");
+    pDirEntry->AppendRunOutput(sOutputDir);
+  }
+  m_pListDir->UpdateStatus(pDirEntry->GetIndex());
+  return bRunning;
+}
+void CFrameRunAnalysis::_Run()
+{
+  // start pending entries in list order until the limit is reached
+
+  CDirEntry *pDirEntry;
+  size_t nMax = _GetMaxConcurrent();
+  while( (m_vpAnalysis.size() < nMax) &&
+    ((pDirEntry = NextDirEntry()) != NULL) )
+  {
+    _RunEntry(pDirEntry);
+  }
+  if(!m_vpAnalysis.empty()) {;} // wait for the running analyses
   else if(!m_DirList.GetCount())
   {
     // input directory selected with no input files
@@ -1116,12 +1178,7 @@ CDirEntry *CFrameRunAnalysis::NextDirEntry()
 }
 void CFrameRunAnalysis::Cleanup()
 {
-  if(m_pAnalysis != NULL)
-  {
-//    m_pAnalysis->Wait();
-    delete m_pAnalysis;
-    m_pAnalysis = NULL;
-  }
+  vectorptr<CProcessAnalysis>::cleanup(&m_vpAnalysis);
 }
 void CFrameRunAnalysis::UpdateButtonState()
 {
@@ -1180,9 +1237,11 @@ void CFrameRunAnalysis::UpdateButtonState()
 
 void CFrameRunAnalysis::OnEndProcess(wxProcessEvent &e)
 {
-  if(m_pAnalysis != NULL)
+  // each process ignores the event if the pid is not its own
+  vector<CProcessAnalysis *>::iterator itr;
+  for(itr = m_vpAnalysis.begin(); itr != m_vpAnalysis.end(); ++itr)
   {
-    m_pAnalysis->OnTerminate(e.GetPid(),e.GetExitCode());
+    (*itr)->OnTerminate(e.GetPid(),e.GetExitCode());
   }
   e.Skip(true);
 }
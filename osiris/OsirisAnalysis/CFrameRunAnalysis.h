@@ -93,6 +93,8 @@ private:
   void _RunAutoExport(CDirEntry *pEntry);
   void _BuildWindow(const wxString &sTitle, const wxSize &sz, const char *psWindowType);
   void _Run();
+  bool _RunEntry(CDirEntry *pDirEntry);
+  size_t _GetMaxConcurrent();
   void DoCancel(bool bCancelAll);
   void Cleanup();
   CDirEntry *NextDirEntry();
@@ -115,7 +117,7 @@ private:
   wxTextCtrl *m_pTextOutput;
   wxTextCtrl *m_pTextErrors;
   wxSplitterWindow *m_pSplitter;
-  CProcessAnalysis *m_pAnalysis;
+  vector<CProcessAnalysis *> m_vpAnalysis; // analyses now running
 //  wxBoxSizer *m_pSizer;
   CListProcess *m_pListDir;
 //  CDialogAnalysis *m_pDlgAnalysis;
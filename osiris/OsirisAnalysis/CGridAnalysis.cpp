@@ -36,7 +36,9 @@
 #include "CLabSettings.h"
 #include "nwx/nwxBatch.h"
 #include "nwx/nwxGrid.h"
+#include "nwx/mapptr.h"
 #include "Platform.h"
+#include <climits>
 
 #if USE_WINGDINGS
 wxFont CGridAnalysis::g_fontStatus(8,wxFONTFAMILY_DEFAULT,wxFONTSTYLE_NORMAL,wxFONTWEIGHT_NORMAL,false,"wingdings");
@@ -58,6 +60,7 @@ CGridAnalysis::~CGridAnalysis()
 
 CGridAnalysis::CGridAnalysis(wxWindow *pParent) :
   wxGrid(pParent,IDgrid),
+  m_pTable(NULL),
   m_bgBold(255,255,160),
   m_bgNormal(255,255,255),
   m_bgRowHasAlert(255,255,218),
@@ -70,10 +73,8 @@ CGridAnalysis::CGridAnalysis(wxWindow *pParent) :
   m_nYScroll(0)
 {
   nwxGrid::SetMacFont(this);
-  CreateGrid(1,1);
-  SetRowLabelValue(0,wxEmptyString);
-  SetColLabelValue(0,wxEmptyString);
-  SetReadOnly(0,0,true);
+  m_pTable = new CGridAnalysisTable(this);
+  SetTable(m_pTable,true);
   SetRowLabelAlignment(wxALIGN_LEFT,wxALIGN_CENTRE);
   m_fontNormal = GetDefaultCellFont();
   m_fontItalic = m_fontNormal;
@@ -90,30 +91,8 @@ CGridAnalysis::CGridAnalysis(wxWindow *pParent) :
 #endif
 
 }
-  /*
-void CGridAnalysis::SetCellStyle(
-  int nRow, int nCol, bool bBold, bool bItal,bool bHasAlert)
-{
-  wxFont *pFont(NULL);
-  if(bBold)
-  {
-    pFont = bItal ? &m_fontBoldItalic : &m_fontBold;
-    SetCellFont(nRow,nCol,*pFont);
-    SetCellBackgroundColour(nRow,nCol,m_bgBold);
-    SetCellTextColour(nRow,nCol,m_fgBold);
-  }
-  else
-  {
-    wxColour *pcolor = bHasAlert ? &m_bgRowHasAlert : &m_bgNormal;
-    pFont = bItal ? &m_fontItalic : &m_fontNormal;
-    SetCellFont(nRow,nCol,*pFont);
-    SetCellBackgroundColour(nRow,nCol,*pcolor);
-    SetCellTextColour(nRow,nCol,m_fgNormal);
-  }
-}
-*/
-void CGridAnalysis::SetCellStyle(
-  int nRow, int nCol, GRID_FLAG nFlag)
+void CGridAnalysis::SetupCellAttr(
+  wxGridCellAttr *pAttr, GRID_FLAG nFlag)
 {
   const int BOLD = 1;
   const int ITALIC = 2;
@@ -148,14 +127,14 @@ void CGridAnalysis::SetCellStyle(
     pFont = &m_fontNormal;
     break;
   }
-  SetCellFont(nRow,nCol,*pFont);
+  pAttr->SetFont(*pFont);
   if(pParm->IsGridReverse(nFlag))
   {
     pcFG = &cBG;
     pcBG = &cFG;
   }
-  SetCellBackgroundColour(nRow,nCol,*pcBG);
-  SetCellTextColour(nRow,nCol,*pcFG);
+  pAttr->SetBackgroundColour(*pcBG);
+  pAttr->SetTextColour(*pcFG);
 }
 wxString CGridAnalysis::FormatRowLabel(int nRow, int nRowCount, const wxString &sLabel)
 {
@@ -181,20 +160,6 @@ wxString CGridAnalysis::FormatRowLabel(int nRow, int nRowCount, const wxString &
   sNumberedLabel.Append(sLabel);
   return sNumberedLabel;
 }
-void CGridAnalysis::SetRowLabel(int nRow, const wxString &sLabel)
-{
-  wxString sNumberedLabel = FormatRowLabel(nRow + 1,GetNumberRows(),sLabel);
-  SetRowLabelValue(nRow,sNumberedLabel);
-  if(m_pDC != NULL)
-  {
-    wxSize sz = m_pDC->GetTextExtent(sNumberedLabel);
-    int nSize = sz.GetWidth();
-    if(nSize > m_nLabelSize)
-    {
-      m_nLabelSize = nSize;
-    }
-  }
-}
 void CGridAnalysis::UpdateLabelSize()
 {
   if(m_nLabelSize)
@@ -202,135 +167,107 @@ void CGridAnalysis::UpdateLabelSize()
     SetRowLabelSize(m_nLabelSize + 6);
   }
 }
-
-bool CGridAnalysis::_SetGridSize(int nRowCount, int nColCount)
+void CGridAnalysis::_ComputeLabelSize()
 {
-  // return true if OK, false if error
-  int nRowCurrent = GetNumberRows();
-  int nColCurrent = GetNumberCols();
-  bool bError = false;
+  // the label width is taken from every sample name with room
+  // for both sample level markers, so that it does not depend
+  // on rows that have not been displayed
 
-  ClearSelection();
-  ClearGrid();
+  int nRowCount = GetNumberRows();
+  int nMarkers;
+  int nSize;
+  int i;
+  wxString sMarkers(COARsample::g_sCellChannelEdited);
 
-  if((!nRowCount) || (nColCount < 1))
-  {
-    bError = true;
-    nRowCount = 1;
-    nColCount = 1;
-  }
-  if(nColCurrent > nColCount)
-  {
-    DeleteCols(nColCount,nColCurrent - nColCount);
-  }
-  else if(nColCurrent < nColCount)
-  {
-    AppendCols(nColCount - nColCurrent);
-  }
-  if(nRowCurrent > nRowCount)
-  {
-    DeleteRows(nRowCount,nRowCurrent - nRowCount);
-  }
-  else if(nRowCurrent < nRowCount)
-  {
-    AppendRows(nRowCount - nRowCurrent);
-  }
-  if(bError)
+  m_nLabelSize = 0;
+  if(m_pDC != NULL)
   {
-    SetColLabelValue(0,wxEmptyString);
-    SetRowLabelValue(0,wxEmptyString);
-    SetCellStyle(0,0,GRID_NORMAL);
-    SetCellValue(0,0,wxEmptyString);
+    sMarkers.Append(g_sSampleLevelNeedsAttention);
+    nMarkers = m_pDC->GetTextExtent(sMarkers).GetWidth();
+    for(i = 0; i < nRowCount; i++)
+    {
+      nSize = m_pDC->GetTextExtent(
+        FormatRowLabel(i + 1,nRowCount,m_pTable->GetRowLabelName(i))
+        ).GetWidth() + nMarkers;
+      if(nSize > m_nLabelSize)
+      {
+        m_nLabelSize = nSize;
+      }
+    }
   }
-  return !bError;
 }
 
-void CGridAnalysis::_SetupCellFlag(
-  GRID_FLAG flagBase,
-  bool bSampleDisabled, bool bEdited, bool bAlert,
-  int nAcceptCount, int nAcceptNeeded,
-  int nReviewCount, int nReviewNeeded,
-  GRID_FLAG *pFlag, bool *pbNeedsAttention)
+void CGridAnalysis::_AutoSizeSampleColumns(
+  COARsampleSort *pSort, const set<const COARsample *> &setSamples)
 {
-  GRID_FLAG nFlag = flagBase;
-  if(!bSampleDisabled)
+  // widen the columns, as AutoSize() would, to fit the rows
+  // of edited samples without computing any other row
+
+  wxClientDC dc(GetGridWindow());
+  set<const COARsample *>::const_iterator itr;
+  wxGridCellAttr *pAttr;
+  wxGridCellRenderer *pRenderer;
+  wxSize sz;
+  size_t nRow;
+  int nColCount = GetNumberCols();
+  int nCol;
+  int nWidth;
+
+  for(itr = setSamples.begin(); itr != setSamples.end(); ++itr)
   {
-    if(bAlert)
+    nRow = pSort->GetSampleIndex(const_cast<COARsample *>(*itr));
+    if(nRow == COARsampleSort::NPOS)
     {
-      nFlag |= GRID_ALERT_CELL;
-      if(bEdited) {} // handle edited cell below
-      else if(nAcceptCount >= nAcceptNeeded)
-      {
-        nFlag |= GRID_ACCEPTED;
-      }
-      else
-      {
-        *pbNeedsAttention = true;
-      }
+      continue; // deleted or not in this sort
     }
-    if(bEdited)
+    for(nCol = 0; nCol < nColCount; nCol++)
     {
-      nFlag |= GRID_EDITED_CELL;
-      if(nReviewCount >= nReviewNeeded)
+      pAttr = GetOrCreateCellAttr((int)nRow,nCol);
+      pRenderer = pAttr->GetRenderer(this,(int)nRow,nCol);
+      sz = pRenderer->GetBestSize(*this,*pAttr,dc,(int)nRow,nCol);
+      pRenderer->DecRef();
+      pAttr->DecRef();
+      nWidth = sz.GetWidth() + 10; // wxGrid::AutoSizeColumn() margin
+      if(nWidth > GetColSize(nCol))
       {
-        nFlag |= GRID_REVIEWED;
-      }
-      else
-      {
-        *pbNeedsAttention = true;
+        SetColSize(nCol,nWidth);
       }
     }
   }
-  *pFlag = nFlag;
 }
 
-void CGridAnalysis::SetupRowLabel(
-  COARsample *pSample,
-  int iRow,
-  int nLabelTypeName,
-  bool bEdited,
-  bool bNeedsAttention)
+bool CGridAnalysis::_SetGridSize(int nRowCount, int nColCount)
 {
-  wxString sName;
-  sName = 
-    (nLabelTypeName == IDmenuDisplayNameSample)
-    ? pSample->GetSampleName()
-    : pSample->GetName();
-  if(bEdited)
+  // return true if OK, false if error
+  bool bError = false;
+
+  ClearSelection();
+
+  if((!nRowCount) || (nColCount < 1))
   {
-    sName.Append(COARsample::g_sCellChannelEdited);
+    bError = true;
+    nRowCount = 1;
+    nColCount = 1;
   }
-  if(bNeedsAttention)
+  m_pTable->SetSize(nRowCount,nColCount);
+  if(bError)
   {
-    sName.Append(g_sSampleLevelNeedsAttention);
+    SetColLabelValue(0,wxEmptyString);
   }
-  SetRowLabel(iRow,sName);
+  return !bError;
 }
 
-
 void CGridAnalysis::UpdateGridRowLabels(
-  COARsampleSort *pSort, int nLabelTypeName, wxDC *pDC)
+  COARsampleSort *, int nLabelTypeName, wxDC *pDC)
 {
-  wxString s;
-  COARsample *pSample;
-  size_t nRowCount = pSort->GetCount();
-  size_t i;
-  bool bEdited;
-  bool bNeedsAttention;
   wxDC *pDCuse = (pDC != NULL) ? pDC : GetDC();
   DCholder xx(this,pDCuse);
 
   m_nLabelType = nLabelTypeName;
-  m_nLabelSize = 0;
-  for(i = 0; i < nRowCount; i++)
-  {
-    pSample = pSort->GetSample((size_t)i);
-    s = GetRowLabelValue(i).Right(2);
-    bNeedsAttention = s.Contains(g_sSampleLevelNeedsAttention);
-    bEdited = s.Contains(COARsample::g_sCellChannelEdited);
-    SetupRowLabel(pSample,i,nLabelTypeName,bEdited,bNeedsAttention);
-  }
+  m_pTable->SetLabelTypeName(nLabelTypeName);
+  _ComputeLabelSize();
   UpdateLabelSize();
+  GetGridRowLabelWindow()->Refresh();
 }
 
 void CGridAnalysis::UpdateGrid(
@@ -343,204 +280,30 @@ void CGridAnalysis::UpdateGrid(
   nwxGridBatch xBatch(this);
   wxDC *pDCuse = (pDC != NULL) ? pDC : GetDC();
   DCholder xx(this,pDCuse);
-
-  wxString sChannel;
-  wxString sCell;
-  int iRow;
-  int nCol;
-  int nReviewCount;
-  int nAcceptCount;
-  int nReviewNeeded;
-  int nAcceptNeeded;
-  size_t nNumberRows = (size_t)GetNumberRows();
-  size_t nRowCount = pSort->GetCount();
-  size_t nAlleleColCount = pFile->GetLocusCount();
-  size_t i;
-  COARlocus *pLocus;
-  COARsample *pSample;
-  const COARmessages *pMsgs = pFile->GetMessages();
-  GRID_FLAG flagBase;
-  GRID_FLAG flag;
-  bool bAlert;
-  bool bEdited;
-  bool bSampleHasAlert;
-  bool bSampleEdited;
-  bool bNeedsAttention;
-  bool bSampleDisabled;
-  m_nLabelSize = 0;
+  set<const COARsample *> setInvalid(m_pTable->GetInvalidSamples());
+  bool bAll = m_pTable->Setup(
+    pFile,pSort,nLabelType,nLabelTypeName,pHistory);
   m_nLabelType = nLabelTypeName;
   
   // OS-657 - row count may need to be reduced
 
-  if(nNumberRows > nRowCount)
-  {
-    DeleteRows(nRowCount,nNumberRows - nRowCount);
-  }
-  else if(nNumberRows < nRowCount)
-  {
-    AppendRows(nRowCount - nNumberRows);
-  }
+  m_pTable->SetSize((int)pSort->GetCount(),GetNumberCols());
 
-  // set up cells
-  pFile->GetReviewerCounts(&nReviewNeeded,&nAcceptNeeded,CLabReview::REVIEW_SAMPLE);
+  // cells are computed by the table when they are displayed,
+  // only the column widths need every row and only when all
+  // of them may have changed
 
-  for(iRow = 0; iRow < (int)nRowCount; ++iRow)
+  if(bAll)
   {
-    // setup sample info
-    flagBase = GRID_NORMAL;
-    bNeedsAttention = false;
-    pSample = pSort->GetSample((size_t)iRow);
-    bSampleHasAlert = pSample->HasAnyAlerts(pMsgs,pHistory);
-    bSampleEdited = pSample->IsEdited(pMsgs,pHistory);
-    bSampleDisabled = pSample->IsDisabled(pHistory);
-    const COARsampleReviewAccept &accept(pSample->GetAcceptance());
-    const COARsampleReviewAccept &review(pSample->GetReviews());
-
-    if(bSampleDisabled)
-    {
-      flagBase |= GRID_DISABLED;
-    }
-    else 
-    {
-      if(bSampleHasAlert)
-      {
-        flagBase |= GRID_ALERT_SAMPLE;
-      }
-      if(bSampleEdited)
-      {
-        flagBase |= GRID_EDITED_SAMPLE;
-      }
-    }
-    //  Setup Row Label for sample
-    bEdited = pSample->IsSampleLevelEdited(pMsgs,pHistory);
-    bAlert = pSample->HasSampleAlert(pMsgs,pHistory);
-    nAcceptCount = accept.GetSampleCount(pHistory);
-    nReviewCount = review.GetSampleCount(pHistory);
-    _SetupCellFlag(
-      flagBase,
-      bSampleDisabled,bEdited,bAlert,
-      nAcceptCount, nAcceptNeeded,
-      nReviewCount, nReviewNeeded,
-      &flag,&bNeedsAttention);
-    SetupRowLabel(pSample,iRow,nLabelTypeName,bEdited,bNeedsAttention);
-
-
-    // ILS alert column
-
-    bAlert = bSampleHasAlert && pSample->HasILSAlert(pMsgs,pHistory);
-    bEdited = pSample->IsCellILSEdited(pMsgs,pHistory);
-    nAcceptCount = accept.GetILSCount(pHistory);
-    nReviewCount = review.GetILSCount(pHistory);
-    pFile->GetReviewerCounts(&nReviewNeeded,&nAcceptNeeded,CLabReview::REVIEW_ILS);
-    _SetupCellFlag(
-      flagBase,
-      bSampleDisabled,bEdited,bAlert,
-      nAcceptCount, nAcceptNeeded,
-      nReviewCount, nReviewNeeded,
-      &flag,&bNeedsAttention);
-    SetCellValue(iRow,CFrameAnalysis::ILS_COLUMN,pSample->GetCellILS(pMsgs,pHistory));
-    SetCellStyle(
-      iRow,CFrameAnalysis::ILS_COLUMN,flag);
-
-    // channel alert column
-
-    sChannel = pSample->GetCellChannel(pMsgs,pHistory);
-    bAlert = bSampleHasAlert && COARsample::HasChannelAlert(sChannel);
-    bEdited = bSampleEdited && pSample->IsCellChannelEdited(pMsgs,pHistory);
-    nAcceptCount = accept.GetChannelCount(pHistory);
-    nReviewCount = review.GetChannelCount(pHistory);
-    pFile->GetReviewerCounts(&nReviewNeeded,&nAcceptNeeded,CLabReview::REVIEW_CHANNEL);
-
-    _SetupCellFlag(
-      flagBase,
-      bSampleDisabled,bEdited,bAlert,
-      nAcceptCount, nAcceptNeeded,
-      nReviewCount, nReviewNeeded,
-      &flag,&bNeedsAttention);
-    SetCellValue(iRow,CFrameAnalysis::CHANNEL_ALERT_COLUMN,sChannel);
-    SetCellStyle(iRow,CFrameAnalysis::CHANNEL_ALERT_COLUMN,flag);
-
-    SetReadOnly(iRow,CFrameAnalysis::ILS_COLUMN,true);
-    SetReadOnly(iRow,CFrameAnalysis::CHANNEL_ALERT_COLUMN,true);
-    SetReadOnly(iRow,CFrameAnalysis::STATUS_COLUMN,true);
-
-    pFile->GetReviewerCounts(&nReviewNeeded,&nAcceptNeeded,CLabReview::REVIEW_LOCUS);
-    for(i = 0, nCol = CFrameAnalysis::FIRST_LOCUS_COLUMN;
-        i < nAlleleColCount;
-        ++i, ++nCol)
-    {
-      SetReadOnly(iRow,nCol,true);
-      pLocus = pSample->FindLocus(pFile->GetLocusName(i));
-      if(pLocus != NULL)
-      {
-        sCell = pLocus->GetCell(nLabelType,pHistory);
-        bAlert = bSampleHasAlert && pLocus->HasAlerts(pMsgs,pHistory);
-        const COARchannel *pChannel =
-          pFile->GetChannelFromLocus(pLocus->GetName());
-        int nChannel = pChannel->GetChannelNr();
-        nAcceptCount = pLocus->GetAcceptanceCount(pHistory);
-        nReviewCount = pLocus->GetReviewCount(pHistory);
-        bEdited = pLocus->HasBeenEdited(
-          pMsgs,pSample,nChannel,pHistory);
-        _SetupCellFlag(flagBase,
-          bSampleDisabled,bEdited,bAlert,
-          nAcceptCount,nAcceptNeeded,
-          nReviewCount,nReviewNeeded,
-          &flag,&bNeedsAttention);
-        if(sCell.IsEmpty())
-        {
-          if(bAlert)
-          {
-            sCell = "?";
-          }
-          else if(bEdited)
-          {
-            sCell = COARsample::g_sCellChannelEdited;
-          }
-        }
-        SetCellValue(iRow,nCol,sCell);
-        SetCellStyle(iRow,nCol,flag);
-      }
-      else
-      {
-        SetCellValue(iRow,nCol,wxEmptyString);
-        SetCellStyle(iRow,nCol,flagBase);
-      }
-    }
-    // setup control cell
-
-    SetReadOnly(iRow,nCol,true);
-    SetCellValue(iRow,nCol,pSample->GetPositiveControl());
-    SetCellStyle(iRow,nCol,flagBase);
-
-    // setup status cell
-    SetReadOnly(iRow,CFrameAnalysis::STATUS_COLUMN,true);
-    if(bSampleDisabled)
-    {
-      SetCellValue(iRow,CFrameAnalysis::STATUS_COLUMN,"");
-      SetCellStyle(iRow,CFrameAnalysis::STATUS_COLUMN,flagBase);
-    }
-    else 
-    {
-      CParmOsirisGlobal parm;
-      const wxColour &clFg(parm->GetStatusForeground(bNeedsAttention));
-      const wxColour &clBg(parm->GetStatusBackground(bNeedsAttention));
-      const wxString &s(
-        bNeedsAttention ? g_sStatusNeedsAttention : g_sStatusOK);
-      SetCellValue(iRow,CFrameAnalysis::STATUS_COLUMN,s);
-      SetCellFont(iRow,CFrameAnalysis::STATUS_COLUMN,g_fontStatus);
-      SetCellBackgroundColour(iRow,CFrameAnalysis::STATUS_COLUMN,clBg);
-      SetCellTextColour(iRow,CFrameAnalysis::STATUS_COLUMN,clFg);
-      SetCellAlignment(
-        iRow,CFrameAnalysis::STATUS_COLUMN,
-        wxALIGN_CENTRE,wxALIGN_CENTRE);
-      SetCellAlignment(
-        iRow,CFrameAnalysis::ILS_COLUMN,
-        wxALIGN_CENTRE,wxALIGN_CENTRE);
-    }
+    AutoSize();
   }
-  AutoSize();
+  else if(!setInvalid.empty())
+  {
+    _AutoSizeSampleColumns(pSort,setInvalid);
+  }
+  _ComputeLabelSize();
   UpdateLabelSize();
+  ForceRefresh();
 }
 
 bool CGridAnalysis::TransferDataToGrid(
@@ -563,9 +326,15 @@ bool CGridAnalysis::TransferDataToGrid(
   m_setColChannelChange.clear();
   nwxGridBatch xBatch(this);
 
+  m_pTable->InvalidateAll();
   bError = (!nRowCount) || (!nAlleleColCount) ||
     (!_SetGridSize((int) nRowCount,(int)nColCount));
-  if(!bError)
+  if(bError)
+  {
+    _SetGridSize(0,0);
+    m_pTable->Setup(NULL,NULL,nLabelType,nLabelTypeName,NULL);
+  }
+  else
   {
     // set up column headers
     wxString sLabel;
@@ -615,6 +384,503 @@ bool CGridAnalysis::TransferDataToGrid(
   return !bError;
 }
 
+//**************************************************** CGridAnalysisTable
+
+CGridAnalysisTable::CGridAnalysisTable(CGridAnalysis *pGrid) :
+  m_pGrid(pGrid),
+  m_pFile(NULL),
+  m_pSort(NULL),
+  m_nRowCount(1),
+  m_nColCount(1),
+  m_nLabelType(0),
+  m_nLabelTypeName(0),
+  m_bHistory(false),
+  m_bInvalidAll(true)
+{
+  m_pAttrStatus[0] = NULL;
+  m_pAttrStatus[1] = NULL;
+  m_vsColLabel.resize(1);
+}
+CGridAnalysisTable::~CGridAnalysisTable()
+{
+  mapptr<CRowKey,CRow>::cleanup(&m_mapRows);
+  _ClearAttrs();
+}
+int CGridAnalysisTable::GetNumberRows()
+{
+  return m_nRowCount;
+}
+int CGridAnalysisTable::GetNumberCols()
+{
+  return m_nColCount;
+}
+bool CGridAnalysisTable::IsEmptyCell(int nRow, int nCol)
+{
+  return GetValue(nRow,nCol).IsEmpty();
+}
+wxString CGridAnalysisTable::GetValue(int nRow, int nCol)
+{
+  CRow *pRow = _GetRow(nRow);
+  if( (pRow != NULL) && (nCol >= 0) && 
+      (nCol < (int)pRow->m_vsCell.size()) )
+  {
+    return pRow->m_vsCell.at((size_t)nCol);
+  }
+  return wxEmptyString;
+}
+void CGridAnalysisTable::SetValue(int, int, const wxString &)
+{
+  // all cells are read only
+}
+wxString CGridAnalysisTable::GetRowLabelName(int nRow)
+{
+  wxString sName;
+  if( (m_pSort != NULL) && (nRow >= 0) &&
+      ((size_t)nRow < m_pSort->GetCount()) )
+  {
+    COARsample *pSample = m_pSort->GetSample((size_t)nRow);
+    sName = 
+      (m_nLabelTypeName == IDmenuDisplayNameSample)
+      ? pSample->GetSampleName()
+      : pSample->GetName();
+  }
+  return sName;
+}
+wxString CGridAnalysisTable::GetRowLabelValue(int nRow)
+{
+  wxString sName;
+  CRow *pRow = _GetRow(nRow);
+  if(pRow != NULL)
+  {
+    sName = GetRowLabelName(nRow);
+    if(pRow->m_bEdited)
+    {
+      sName.Append(COARsample::g_sCellChannelEdited);
+    }
+    if(pRow->m_bSampleNeedsAttention)
+    {
+      sName.Append(CGridAnalysis::g_sSampleLevelNeedsAttention);
+    }
+    sName = CGridAnalysis::FormatRowLabel(nRow + 1,m_nRowCount,sName);
+  }
+  return sName;
+}
+wxString CGridAnalysisTable::GetColLabelValue(int nCol)
+{
+  if( (nCol >= 0) && (nCol < (int)m_vsColLabel.size()) )
+  {
+    return m_vsColLabel.at((size_t)nCol);
+  }
+  return wxEmptyString;
+}
+void CGridAnalysisTable::SetColLabelValue(int nCol, const wxString &s)
+{
+  if(nCol >= 0)
+  {
+    if(nCol >= (int)m_vsColLabel.size())
+    {
+      m_vsColLabel.resize((size_t)nCol + 1);
+    }
+    m_vsColLabel.at((size_t)nCol) = s;
+  }
+}
+wxGridCellAttr *CGridAnalysisTable::GetAttr(
+  int nRow, int nCol, wxGridCellAttr::wxAttrKind)
+{
+  wxGridCellAttr *pAttr;
+  CRow *pRow = _GetRow(nRow);
+  if( (pRow == NULL) || (nCol < 0) ||
+      (nCol >= (int)pRow->m_vnFlag.size()) )
+  {
+    pAttr = _GetFlagAttr(GRID_NORMAL,false);
+  }
+  else if(pRow->m_bDisabled)
+  {
+    pAttr = _GetFlagAttr(pRow->m_vnFlag.at((size_t)nCol),false);
+  }
+  else if(nCol == CFrameAnalysis::STATUS_COLUMN)
+  {
+    pAttr = _GetStatusAttr(pRow->m_bNeedsAttention);
+  }
+  else
+  {
+    pAttr = _GetFlagAttr(
+      pRow->m_vnFlag.at((size_t)nCol),
+      nCol == CFrameAnalysis::ILS_COLUMN);
+  }
+  pAttr->IncRef();
+  return pAttr;
+}
+bool CGridAnalysisTable::Setup(
+  COARfile *pFile, COARsampleSort *pSort,
+  int nLabelType, int nLabelTypeName,
+  const wxDateTime *pHistory)
+{
+  bool bHistory = (pHistory != NULL);
+  bool bAll = m_bInvalidAll ||
+    (pFile != m_pFile) ||
+    (pSort != m_pSort) ||
+    (nLabelType != m_nLabelType) ||
+    (bHistory != m_bHistory) ||
+    (bHistory && (*pHistory != m_dtHistory));
+  m_pFile = pFile;
+  m_pSort = pSort;
+  m_nLabelType = nLabelType;
+  m_nLabelTypeName = nLabelTypeName;
+  m_bHistory = bHistory;
+  if(bHistory)
+  {
+    m_dtHistory = *pHistory;
+  }
+  if(pFile == NULL)
+  {
+    mapptr<CRowKey,CRow>::cleanup(&m_mapRows);
+  }
+  m_setInvalid.clear();
+  m_bInvalidAll = false;
+  return bAll;
+}
+void CGridAnalysisTable::SetSize(int nRowCount, int nColCount)
+{
+  wxGrid *pView = GetView();
+  int nRowOld = m_nRowCount;
+  int nColOld = m_nColCount;
+  m_nRowCount = nRowCount;
+  m_nColCount = nColCount;
+  m_vsColLabel.resize((size_t)nColCount);
+  if(pView != NULL)
+  {
+    if(nColCount < nColOld)
+    {
+      wxGridTableMessage msg(
+        this,wxGRIDTABLE_NOTIFY_COLS_DELETED,nColCount,nColOld - nColCount);
+      pView->ProcessTableMessage(msg);
+    }
+    else if(nColCount > nColOld)
+    {
+      wxGridTableMessage msg(
+        this,wxGRIDTABLE_NOTIFY_COLS_APPENDED,nColCount - nColOld);
+      pView->ProcessTableMessage(msg);
+    }
+    if(nRowCount < nRowOld)
+    {
+      wxGridTableMessage msg(
+        this,wxGRIDTABLE_NOTIFY_ROWS_DELETED,nRowCount,nRowOld - nRowCount);
+      pView->ProcessTableMessage(msg);
+    }
+    else if(nRowCount > nRowOld)
+    {
+      wxGridTableMessage msg(
+        this,wxGRIDTABLE_NOTIFY_ROWS_APPENDED,nRowCount - nRowOld);
+      pView->ProcessTableMessage(msg);
+    }
+  }
+}
+void CGridAnalysisTable::InvalidateSample(const COARsample *pSample)
+{
+  // rows are ordered by sample first, so all of the sample's
+  // cell types and history times are together
+
+  MAP_ROWS::iterator itr =
+    m_mapRows.lower_bound(CRowKey(pSample,INT_MIN,NULL));
+  while( (itr != m_mapRows.end()) && (itr->first.m_pSample == pSample) )
+  {
+    delete itr->second;
+    m_mapRows.erase(itr++);
+  }
+  m_setInvalid.insert(pSample);
+}
+void CGridAnalysisTable::InvalidateAll()
+{
+  mapptr<CRowKey,CRow>::cleanup(&m_mapRows);
+  _ClearAttrs(); // grid colors may have changed
+  m_setInvalid.clear();
+  m_bInvalidAll = true;
+}
+CGridAnalysisTable::CRow *CGridAnalysisTable::_GetRow(int nRow)
+{
+  CRow *pRow = NULL;
+  if( (m_pFile != NULL) && (nRow >= 0) && (nRow < m_nRowCount) &&
+      ((size_t)nRow < m_pSort->GetCount()) )
+  {
+    COARsample *pSample = m_pSort->GetSample((size_t)nRow);
+    CRowKey key(pSample,m_nLabelType,m_bHistory ? &m_dtHistory : NULL);
+    MAP_ROWS::iterator itr = m_mapRows.find(key);
+    if(itr != m_mapRows.end())
+    {
+      pRow = itr->second;
+    }
+    else
+    {
+      pRow = new CRow;
+      _BuildRow(pSample,pRow);
+      m_mapRows.insert(MAP_ROWS::value_type(key,pRow));
+    }
+  }
+  return pRow;
+}
+
+void CGridAnalysisTable::_SetupCellFlag(
+  GRID_FLAG flagBase,
+  bool bSampleDisabled, bool bEdited, bool bAlert,
+  int nAcceptCount, int nAcceptNeeded,
+  int nReviewCount, int nReviewNeeded,
+  GRID_FLAG *pFlag, bool *pbNeedsAttention)
+{
+  GRID_FLAG nFlag = flagBase;
+  if(!bSampleDisabled)
+  {
+    if(bAlert)
+    {
+      nFlag |= GRID_ALERT_CELL;
+      if(bEdited) {} // handle edited cell below
+      else if(nAcceptCount >= nAcceptNeeded)
+      {
+        nFlag |= GRID_ACCEPTED;
+      }
+      else
+      {
+        *pbNeedsAttention = true;
+      }
+    }
+    if(bEdited)
+    {
+      nFlag |= GRID_EDITED_CELL;
+      if(nReviewCount >= nReviewNeeded)
+      {
+        nFlag |= GRID_REVIEWED;
+      }
+      else
+      {
+        *pbNeedsAttention = true;
+      }
+    }
+  }
+  *pFlag = nFlag;
+}
+
+void CGridAnalysisTable::_BuildRow(COARsample *pSample, CRow *pRow)
+{
+  COARfile *pFile = m_pFile;
+  const wxDateTime *pHistory = m_bHistory ? &m_dtHistory : NULL;
+  int nLabelType = m_nLabelType;
+  wxString sChannel;
+  wxString sCell;
+  int nCol;
+  int nReviewCount;
+  int nAcceptCount;
+  int nReviewNeeded;
+  int nAcceptNeeded;
+  size_t nAlleleColCount = pFile->GetLocusCount();
+  size_t nColCount = nAlleleColCount + CFrameAnalysis::FIRST_LOCUS_COLUMN + 1;
+  size_t i;
+  COARlocus *pLocus;
+  const COARmessages *pMsgs = pFile->GetMessages();
+  GRID_FLAG flagBase;
+  GRID_FLAG flag;
+  bool bAlert;
+  bool bEdited;
+  bool bSampleHasAlert;
+  bool bSampleEdited;
+  bool bNeedsAttention;
+  bool bSampleDisabled;
+
+  pRow->m_vsCell.clear();
+  pRow->m_vsCell.resize(nColCount);
+  pRow->m_vnFlag.clear();
+  pRow->m_vnFlag.resize(nColCount,GRID_NORMAL);
+
+  pFile->GetReviewerCounts(&nReviewNeeded,&nAcceptNeeded,CLabReview::REVIEW_SAMPLE);
+
+  // setup sample info
+  flagBase = GRID_NORMAL;
+  bNeedsAttention = false;
+  bSampleHasAlert = pSample->HasAnyAlerts(pMsgs,pHistory);
+  bSampleEdited = pSample->IsEdited(pMsgs,pHistory);
+  bSampleDisabled = pSample->IsDisabled(pHistory);
+  const COARsampleReviewAccept &accept(pSample->GetAcceptance());
+  const COARsampleReviewAccept &review(pSample->GetReviews());
+
+  if(bSampleDisabled)
+  {
+    flagBase |= GRID_DISABLED;
+  }
+  else 
+  {
+    if(bSampleHasAlert)
+    {
+      flagBase |= GRID_ALERT_SAMPLE;
+    }
+    if(bSampleEdited)
+    {
+      flagBase |= GRID_EDITED_SAMPLE;
+    }
+  }
+  //  Setup Row Label for sample
+  bEdited = pSample->IsSampleLevelEdited(pMsgs,pHistory);
+  bAlert = pSample->HasSampleAlert(pMsgs,pHistory);
+  nAcceptCount = accept.GetSampleCount(pHistory);
+  nReviewCount = review.GetSampleCount(pHistory);
+  _SetupCellFlag(
+    flagBase,
+    bSampleDisabled,bEdited,bAlert,
+    nAcceptCount, nAcceptNeeded,
+    nReviewCount, nReviewNeeded,
+    &flag,&bNeedsAttention);
+  pRow->m_bEdited = bEdited;
+  pRow->m_bSampleNeedsAttention = bNeedsAttention;
+  pRow->m_bDisabled = bSampleDisabled;
+
+
+  // ILS alert column
+
+  bAlert = bSampleHasAlert && pSample->HasILSAlert(pMsgs,pHistory);
+  bEdited = pSample->IsCellILSEdited(pMsgs,pHistory);
+  nAcceptCount = accept.GetILSCount(pHistory);
+  nReviewCount = review.GetILSCount(pHistory);
+  pFile->GetReviewerCounts(&nReviewNeeded,&nAcceptNeeded,CLabReview::REVIEW_ILS);
+  _SetupCellFlag(
+    flagBase,
+    bSampleDisabled,bEdited,bAlert,
+    nAcceptCount, nAcceptNeeded,
+    nReviewCount, nReviewNeeded,
+    &flag,&bNeedsAttention);
+  pRow->m_vsCell.at(CFrameAnalysis::ILS_COLUMN) = pSample->GetCellILS(pMsgs,pHistory);
+  pRow->m_vnFlag.at(CFrameAnalysis::ILS_COLUMN) = flag;
+
+  // channel alert column
+
+  sChannel = pSample->GetCellChannel(pMsgs,pHistory);
+  bAlert = bSampleHasAlert && COARsample::HasChannelAlert(sChannel);
+  bEdited = bSampleEdited && pSample->IsCellChannelEdited(pMsgs,pHistory);
+  nAcceptCount = accept.GetChannelCount(pHistory);
+  nReviewCount = review.GetChannelCount(pHistory);
+  pFile->GetReviewerCounts(&nReviewNeeded,&nAcceptNeeded,CLabReview::REVIEW_CHANNEL);
+
+  _SetupCellFlag(
+    flagBase,
+    bSampleDisabled,bEdited,bAlert,
+    nAcceptCount, nAcceptNeeded,
+    nReviewCount, nReviewNeeded,
+    &flag,&bNeedsAttention);
+  pRow->m_vsCell.at(CFrameAnalysis::CHANNEL_ALERT_COLUMN) = sChannel;
+  pRow->m_vnFlag.at(CFrameAnalysis::CHANNEL_ALERT_COLUMN) = flag;
+
+  pFile->GetReviewerCounts(&nReviewNeeded,&nAcceptNeeded,CLabReview::REVIEW_LOCUS);
+  for(i = 0, nCol = CFrameAnalysis::FIRST_LOCUS_COLUMN;
+      i < nAlleleColCount;
+      ++i, ++nCol)
+  {
+    pLocus = pSample->FindLocus(pFile->GetLocusName(i));
+    if(pLocus != NULL)
+    {
+      sCell = pLocus->GetCell(nLabelType,pHistory);
+      bAlert = bSampleHasAlert && pLocus->HasAlerts(pMsgs,pHistory);
+      const COARchannel *pChannel =
+        pFile->GetChannelFromLocus(pLocus->GetName());
+      int nChannel = pChannel->GetChannelNr();
+      nAcceptCount = pLocus->GetAcceptanceCount(pHistory);
+      nReviewCount = pLocus->GetReviewCount(pHistory);
+      bEdited = pLocus->HasBeenEdited(
+        pMsgs,pSample,nChannel,pHistory);
+      _SetupCellFlag(flagBase,
+        bSampleDisabled,bEdited,bAlert,
+        nAcceptCount,nAcceptNeeded,
+        nReviewCount,nReviewNeeded,
+        &flag,&bNeedsAttention);
+      if(sCell.IsEmpty())
+      {
+        if(bAlert)
+        {
+          sCell = "?";
+        }
+        else if(bEdited)
+        {
+          sCell = COARsample::g_sCellChannelEdited;
+        }
+      }
+      pRow->m_vsCell.at(nCol) = sCell;
+      pRow->m_vnFlag.at(nCol) = flag;
+    }
+    else
+    {
+      pRow->m_vnFlag.at(nCol) = flagBase;
+    }
+  }
+  // setup control cell
+
+  pRow->m_vsCell.at(nCol) = pSample->GetPositiveControl();
+  pRow->m_vnFlag.at(nCol) = flagBase;
+
+  // setup status cell, its colors are in _GetStatusAttr()
+
+  pRow->m_bNeedsAttention = bNeedsAttention;
+  pRow->m_vnFlag.at(CFrameAnalysis::STATUS_COLUMN) = flagBase;
+  if(!bSampleDisabled)
+  {
+    pRow->m_vsCell.at(CFrameAnalysis::STATUS_COLUMN) =
+      bNeedsAttention 
+      ? CGridAnalysis::g_sStatusNeedsAttention
+      : CGridAnalysis::g_sStatusOK;
+  }
+}
+
+wxGridCellAttr *CGridAnalysisTable::_GetFlagAttr(
+  GRID_FLAG nFlag, bool bCentre)
+{
+  wxGridCellAttr *pAttr;
+  int nKey = ((int)nFlag << 1) | (bCentre ? 1 : 0);
+  map<int, wxGridCellAttr *>::iterator itr = m_mapAttr.find(nKey);
+  if(itr != m_mapAttr.end())
+  {
+    pAttr = itr->second;
+  }
+  else
+  {
+    pAttr = new wxGridCellAttr;
+    m_pGrid->SetupCellAttr(pAttr,nFlag);
+    pAttr->SetReadOnly(true);
+    if(bCentre)
+    {
+      pAttr->SetAlignment(wxALIGN_CENTRE,wxALIGN_CENTRE);
+    }
+    m_mapAttr.insert(map<int, wxGridCellAttr *>::value_type(nKey,pAttr));
+  }
+  return pAttr;
+}
+wxGridCellAttr *CGridAnalysisTable::_GetStatusAttr(bool bNeedsAttention)
+{
+  int n = bNeedsAttention ? 1 : 0;
+  if(m_pAttrStatus[n] == NULL)
+  {
+    CParmOsirisGlobal parm;
+    wxGridCellAttr *pAttr = new wxGridCellAttr;
+    pAttr->SetFont(CGridAnalysis::GetFontStatus());
+    pAttr->SetBackgroundColour(parm->GetStatusBackground(bNeedsAttention));
+    pAttr->SetTextColour(parm->GetStatusForeground(bNeedsAttention));
+    pAttr->SetAlignment(wxALIGN_CENTRE,wxALIGN_CENTRE);
+    pAttr->SetReadOnly(true);
+    m_pAttrStatus[n] = pAttr;
+  }
+  return m_pAttrStatus[n];
+}
+void CGridAnalysisTable::_ClearAttrs()
+{
+  map<int, wxGridCellAttr *>::iterator itr;
+  for(itr = m_mapAttr.begin(); itr != m_mapAttr.end(); ++itr)
+  {
+    itr->second->DecRef();
+  }
+  m_mapAttr.clear();
+  for(int i = 0; i < 2; i++)
+  {
+    if(m_pAttrStatus[i] != NULL)
+    {
+      m_pAttrStatus[i]->DecRef();
+      m_pAttrStatus[i] = NULL;
+    }
+  }
+}
 
 int CGridAnalysis::GetChannelNumber(const wxString &s)
 {
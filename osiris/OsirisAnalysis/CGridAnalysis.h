@@ -41,11 +41,130 @@
 #include "nwx/stdb.h"
 #include <vector>
 #include <set>
+#include <map>
 #include "nwx/stde.h"
 
 class COARsampleSort;
 class COARsample;
 class COARfile;
+class CGridAnalysis;
+
+//**************************************************** CGridAnalysisTable
+//
+//  virtual table for CGridAnalysis.  The text and flags of a row are
+//  computed when wxGrid first asks for one of its cells and are kept
+//  for each (sample, cell type, history time) until the sample is
+//  invalidated after an edit
+//
+class CGridAnalysisTable : public wxGridTableBase
+{
+public:
+  CGridAnalysisTable(CGridAnalysis *pGrid);
+  virtual ~CGridAnalysisTable();
+
+  virtual int GetNumberRows();
+  virtual int GetNumberCols();
+  virtual bool IsEmptyCell(int nRow, int nCol);
+  virtual wxString GetValue(int nRow, int nCol);
+  virtual void SetValue(int nRow, int nCol, const wxString &s);
+  virtual wxString GetRowLabelValue(int nRow);
+  virtual wxString GetColLabelValue(int nCol);
+  virtual void SetColLabelValue(int nCol, const wxString &s);
+  virtual bool CanHaveAttributes()
+  {
+    return true;
+  }
+  virtual wxGridCellAttr *GetAttr(
+    int nRow, int nCol, wxGridCellAttr::wxAttrKind kind);
+
+  // Setup() returns true if every cell may have changed since the last call
+  bool Setup(
+    COARfile *pFile, COARsampleSort *pSort,
+    int nLabelType, int nLabelTypeName,
+    const wxDateTime *pHistory);
+  void SetSize(int nRowCount, int nColCount);
+  void SetLabelTypeName(int n)
+  {
+    m_nLabelTypeName = n;
+  }
+  wxString GetRowLabelName(int nRow);
+  void InvalidateSample(const COARsample *pSample);
+  void InvalidateAll();
+  const set<const COARsample *> &GetInvalidSamples()
+  {
+    return m_setInvalid;
+  }
+private:
+  class CRow
+  {
+  public:
+    vector<wxString> m_vsCell;
+    vector<GRID_FLAG> m_vnFlag;
+    bool m_bEdited;                 // sample level, for the row label
+    bool m_bSampleNeedsAttention;   // sample level, for the row label
+    bool m_bNeedsAttention;         // any cell, for the status column
+    bool m_bDisabled;
+  };
+  class CRowKey
+  {
+  public:
+    CRowKey(const COARsample *pSample, int nLabelType, const wxDateTime *pHistory) :
+      m_pSample(pSample),
+      m_nTime((pHistory == NULL) ? wxLongLong(0) : pHistory->GetValue()),
+      m_nLabelType(nLabelType),
+      m_bHistory(pHistory != NULL)
+    {}
+    bool operator <(const CRowKey &x) const
+    {
+      if(m_pSample != x.m_pSample)
+      {
+        return m_pSample < x.m_pSample;
+      }
+      if(m_nLabelType != x.m_nLabelType)
+      {
+        return m_nLabelType < x.m_nLabelType;
+      }
+      if(m_bHistory != x.m_bHistory)
+      {
+        return x.m_bHistory;
+      }
+      return m_nTime < x.m_nTime;
+    }
+    const COARsample *m_pSample;
+    wxLongLong m_nTime;
+    int m_nLabelType;
+    bool m_bHistory;
+  };
+  typedef map<CRowKey, CRow *> MAP_ROWS;
+
+  CRow *_GetRow(int nRow);
+  void _BuildRow(COARsample *pSample, CRow *pRow);
+  void _SetupCellFlag(
+    GRID_FLAG flagBase,
+    bool bSampleDisabled,bool bEdited, bool bAlert,
+    int nAcceptCount, int nAcceptNeeded,
+    int nReviewCount, int nReviewNeeded,
+    GRID_FLAG *pFlag, bool *pbNeedsAttention);
+  wxGridCellAttr *_GetFlagAttr(GRID_FLAG nFlag, bool bCentre);
+  wxGridCellAttr *_GetStatusAttr(bool bNeedsAttention);
+  void _ClearAttrs();
+
+  MAP_ROWS m_mapRows;
+  map<int, wxGridCellAttr *> m_mapAttr;
+  set<const COARsample *> m_setInvalid;
+  vector<wxString> m_vsColLabel;
+  wxGridCellAttr *m_pAttrStatus[2];
+  CGridAnalysis *m_pGrid;
+  COARfile *m_pFile;
+  COARsampleSort *m_pSort;
+  wxDateTime m_dtHistory;
+  int m_nRowCount;
+  int m_nColCount;
+  int m_nLabelType;
+  int m_nLabelTypeName;
+  bool m_bHistory;
+  bool m_bInvalidAll;
+};
 
 //**************************************************** CGridAnalysis
 class CGridAnalysis : public wxGrid
@@ -86,8 +205,7 @@ public:
     bool bItal = false, bool bHasAlerts = false);
 */
   static wxString FormatRowLabel(int nRow, int nRowCount,const wxString &sLabel);
-  void SetCellStyle(int nRow, int nCol,GRID_FLAG nFlag);
-  void SetRowLabel(int nRow, const wxString &sLabel);
+  void SetupCellAttr(wxGridCellAttr *pAttr,GRID_FLAG nFlag);
   void UpdateLabelSize();
   void ResetLabelSize()
   {
@@ -117,6 +235,17 @@ public:
     int nLabelType = 0, 
     int nLabelTypeName = 0,
     const wxDateTime *pHistory = NULL, wxDC *pDC = NULL);
+
+  // a sample has been edited; its row is rebuilt by the next UpdateGrid()
+  void InvalidateSample(const COARsample *pSample)
+  {
+    m_pTable->InvalidateSample(pSample);
+  }
+  // samples were added, removed, or edited in bulk, or settings changed
+  void InvalidateAll()
+  {
+    m_pTable->InvalidateAll();
+  }
   void SaveScrollPosition()
   {
     GetViewStart(&m_nXScroll,&m_nYScroll);
@@ -150,19 +279,9 @@ public:
     return g_fontStatus;
   }
 private:
-  void SetupRowLabel(
-    COARsample *pSample,
-    int iRow,
-    int nLabelTypeName,
-    bool bEdited,
-    bool bNeedsAttention);
-
-  void _SetupCellFlag(
-    GRID_FLAG flagBase,
-    bool bSampleDisabled,bool bEdited, bool bAlert,
-    int nAcceptCount, int nAcceptNeeded,
-    int nReviewCount, int nReviewNeeded,
-    GRID_FLAG *pFlag, bool *pbNeedsAttention);
+  void _ComputeLabelSize();
+  void _AutoSizeSampleColumns(
+    COARsampleSort *pSort, const set<const COARsample *> &setSamples);
   bool _SetGridSize(int nRowsCount, int nColCount);
   wxDC *GetDC()
   {
@@ -178,8 +297,8 @@ private:
   }
   static int GetChannelNumber(const wxString &s);
 
-  vector<COARsample *> m_vpSamples;
   set<int> m_setColChannelChange;
+  CGridAnalysisTable *m_pTable;
 
 
   wxColour m_bgBold;
@@ -196,3 +196,17 @@ void CListProcess::UpdateStatus(int nItem)
   mainApp::ReRender(GetParent());
 //  Refresh();
 }
+void CListProcess::UpdateProgress(int nItem, double dProgress)
+{
+  // percent complete of a running analysis, dProgress is 0 - 100
+  if( (nItem >= 0) && (nItem < (int) m_pDirList->GetCount()) )
+  {
+    CDirEntry *pDirEntry = m_pDirList->At((size_t)nItem);
+    if(pDirEntry->GetStatus() == DIRENTRY_RUNNING)
+    {
+      wxString sStatus = pDirEntry->GetStatusString();
+      sStatus.Append(wxString::Format(" %d%%",(int)floor(dProgress + 0.5)));
+      SetItem((long)nItem,ITEM_STATUS,sStatus);
+    }
+  }
+}
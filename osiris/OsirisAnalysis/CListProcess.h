@@ -45,6 +45,7 @@ public:
   virtual ~CListProcess();
   virtual bool TransferDataToWindow();
   void UpdateStatus(int nItem = -1);
+  void UpdateProgress(int nItem, double dProgress);
   void GetInfo(wxListItem &itm, long ndx = 0)
   {
     itm.SetStateMask(-1);
@@ -37,8 +37,12 @@
 #include "CXMLmessageBook.h"
 #include <wx/log.h>
 #include <wx/datetime.h>
+#include <wx/file.h>
+#include <wx/mstream.h>
 #include "nwx/stdb.h"
 #include <memory>
+#include <algorithm>
+#include <string.h>
 #include "nwx/stde.h"
 #include "nwx/nwxString.h"
 #include "nwx/nwxXmlCMF.h"
@@ -203,19 +207,40 @@ const COARchannel *COARfile::GetChannelFromLocus(const wxString &sLocusName) con
 COARsample *COARfile::GetSampleByName(const wxString &sName)
 {
   COARsample *pRtn(NULL);
+  map<wxString,COARsample *>::iterator itr;
+  _BuildSampleNameMap();
+  itr = m_mapSampleName.find(_SampleNameKey(sName));
+  if(itr != m_mapSampleName.end())
+  {
+    pRtn = itr->second;
+    LoadSample(pRtn);
+  }
+  return pRtn;
+}
+wxString COARfile::_SampleNameKey(const wxString &sName)
+{
+  // same equality as nwxString::FileNameStringEqual()
+#ifdef __WXMSW__
+  return sName.Lower();
+#else
+  return sName;
+#endif
+}
+void COARfile::__BuildSampleNameMap()
+{
+  // the first sample with a name is found, as in a linear search
+
   vector<COARsample *> *vpSample(m_vpTable.Get());
   vector<COARsample *>::iterator itr;
+  m_mapSampleName.clear();
   for(itr = vpSample->begin();
     itr != vpSample->end();
     ++itr)
   {
-    if(nwxString::FileNameStringEqual(sName,(*itr)->GetName()))
-    {
-      pRtn = *itr;
-      break;
-    }
+    m_mapSampleName.insert(
+      map<wxString,COARsample *>::value_type(
+        _SampleNameKey((*itr)->GetName()),*itr));
   }
-  return pRtn;
 }
 void COARfile::FormatText(wxString *ps, int nIndent)
 {
@@ -357,41 +382,62 @@ CXMLmessageBook *COARfile::GetMessageBook()
   }
   return m_pMsgBook;
 }
-wxString COARfile::FindFileByName(const wxString &sName) const
+const vector<wxString> &COARfile::_GetSearchDirectories() const
 {
-  //  7/14/17 - very inefficient, should not rebuild the
-  //    directory array on every call
-  vector<wxString> vsPath;
-  wxString sPath;
-  size_t PATHCOUNT = 3;
-
-  vsPath.reserve(PATHCOUNT);
-  sPath = GetFileName();
-  vsPath.push_back(sPath);
-  sPath = GetHeadingFileName();
-  vsPath.push_back(sPath);
-  sPath = GetHeadingNewFileName();
-  vsPath.push_back(sPath);
-  for(size_t i = 0; i < PATHCOUNT; i++)
-  {
-    sPath = vsPath.at(i);
-    if(!sPath.IsEmpty())
+  // directories of this file, the original .oar, and the new
+  // .oar, without duplicates, rebuilt only when one of the
+  // file names changes
+  wxString sKey(GetFileName());
+  sKey.Append(wxT("\n"));
+  sKey.Append(GetHeadingFileName());
+  sKey.Append(wxT("\n"));
+  sKey.Append(GetHeadingNewFileName());
+  if(m_vsSearchDir.empty() || (sKey != m_sSearchDirKey))
+  {
+    const wxString *psPath[] =
     {
-      wxFileName fn(sPath);
-      sPath = fn.GetPath();
-      nwxFileUtil::EndWithSeparator(&sPath);
-      sPath.Append(sName);
-      if(wxFileName::FileExists(sPath))
-      {
-        i = PATHCOUNT; // loop exit
-      }
-      else
+      &GetFileName(),
+      &GetHeadingFileName(),
+      &GetHeadingNewFileName()
+    };
+    const size_t PATHCOUNT = sizeof(psPath) / sizeof(psPath[0]);
+    wxString sPath;
+    m_sSearchDirKey = sKey;
+    m_vsSearchDir.clear();
+    m_vsSearchDir.reserve(PATHCOUNT);
+    for(size_t i = 0; i < PATHCOUNT; i++)
+    {
+      if(!psPath[i]->IsEmpty())
       {
-        sPath.Empty();
+        wxFileName fn(*psPath[i]);
+        sPath = fn.GetPath();
+        nwxFileUtil::EndWithSeparator(&sPath);
+        if(find(m_vsSearchDir.begin(),m_vsSearchDir.end(),sPath) ==
+            m_vsSearchDir.end())
+        {
+          m_vsSearchDir.push_back(sPath);
+        }
       }
     }
   }
-  return sPath;
+  return m_vsSearchDir;
+}
+wxString COARfile::FindFileByName(const wxString &sName) const
+{
+  const vector<wxString> &vsDir(_GetSearchDirectories());
+  vector<wxString>::const_iterator itr;
+  wxString sPath;
+  wxString sRtn;
+  for(itr = vsDir.begin(); sRtn.IsEmpty() && (itr != vsDir.end()); ++itr)
+  {
+    sPath = *itr;
+    sPath.Append(sName);
+    if(wxFileName::FileExists(sPath))
+    {
+      sRtn = sPath;
+    }
+  }
+  return sRtn;
 }
 
 wxString COARfile::FindMessageBookFile() const
@@ -1318,8 +1364,17 @@ bool COARfile::LoadFile(const wxString &sFileName)
 {
   m_dtLastLoad.SetToCurrent();
   _ClearLocusInfo();
+  m_mapSampleName.clear();
   _ClearMessageBook();
   bool bRtn = nwxXmlPersist::LoadFile(sFileName);
+  if(bRtn && !_SetupLazySamples())
+  {
+    // the samples found in the file text are not the ones
+    // loaded, load everything from the file
+    m_bLazyLoad = false;
+    bRtn = nwxXmlPersist::LoadFile(sFileName);
+    m_bLazyLoad = true;
+  }
   m_bModified = false;
   if(bRtn)
   {
@@ -1335,6 +1390,306 @@ bool COARfile::LoadFile(const wxString &sFileName)
   }
   return bRtn;
 }
+bool COARfile::LoadDocument(wxXmlDocument *pDoc, const wxString &sFileName)
+{
+  // most of an .oar file is the detail of each sample.  Load the
+  // document with only the summary elements of each sample and
+  // keep the file text to load the rest of a sample when it
+  // is first used, see LoadSample()
+
+  std::string sSummary;
+  bool bRtn = false;
+  _ClearLazyText();
+  m_vnLazyOffset.clear();
+  m_vnLazyLength.clear();
+  if( m_bLazyLoad &&
+      _ReadFile(sFileName,&m_sLazyText) &&
+      _IndexSamples(&sSummary) )
+  {
+    wxMemoryInputStream stream(sSummary.data(),sSummary.size());
+    bRtn = pDoc->Load(stream);
+  }
+  if(!bRtn)
+  {
+    _ClearLazyText();
+    m_vnLazyOffset.clear();
+    m_vnLazyLength.clear();
+    bRtn = nwxXmlPersist::LoadDocument(pDoc,sFileName);
+  }
+  return bRtn;
+}
+bool COARfile::_ReadFile(const wxString &sFileName, std::string *ps)
+{
+  wxFile file;
+  bool bRtn = false;
+  if(wxFileName::FileExists(sFileName) && file.Open(sFileName))
+  {
+    wxFileOffset nLength = file.Length();
+    if(nLength > 0)
+    {
+      ps->resize((size_t)nLength);
+      bRtn = (file.Read(&(*ps)[0],(size_t)nLength) == (ssize_t)nLength);
+    }
+    file.Close();
+  }
+  return bRtn;
+}
+size_t COARfile::_FindTagEnd(const std::string &s, size_t nPos)
+{
+  // find the '>' ending a tag, skipping quoted attribute values
+  size_t nLen = s.size();
+  char cQuote = 0;
+  char c;
+  size_t nRtn = std::string::npos;
+  for(; nPos < nLen; ++nPos)
+  {
+    c = s[nPos];
+    if(cQuote)
+    {
+      if(c == cQuote)
+      {
+        cQuote = 0;
+      }
+    }
+    else if((c == '"') || (c == '\''))
+    {
+      cQuote = c;
+    }
+    else if(c == '>')
+    {
+      nRtn = nPos;
+      break;
+    }
+  }
+  return nRtn;
+}
+bool COARfile::_IndexSamples(std::string *psSummary)
+{
+  // copy m_sLazyText to *psSummary with only the summary elements
+  // in each <Sample> in <Table>, and save the offset and length of
+  // each sample in m_sLazyText.  Depth 1 is the root element,
+  // 2 is <Table>, 3 is <Sample>, and 4 is an element in a sample
+
+  const std::string &s(m_sLazyText);
+  const size_t NPOS = std::string::npos;
+  size_t nLen = s.size();
+  size_t nPos = 0;        // next character to scan
+  size_t nCopied = 0;     // text before this is in *psSummary
+  size_t nSample = NPOS;  // start of the current sample
+  size_t nChild = NPOS;   // start of the current element in the sample
+  size_t nTag;
+  size_t nEnd;
+  size_t nName;
+  int nDepth = 0;
+  bool bTable = false;
+  bool bKeep = false;
+  bool bEmpty;
+  bool bRtn = true;
+
+  psSummary->clear();
+  psSummary->reserve(nLen >> 3);
+  if(!s.compare(0,5,"<?xml"))
+  {
+    nEnd = s.find("?>");
+    if(nEnd != NPOS)
+    {
+      m_sLazyProlog = s.substr(0,nEnd + 2);
+    }
+  }
+  while(bRtn && (nPos < nLen) &&
+    ((nTag = s.find('<',nPos)) != NPOS))
+  {
+    if(!s.compare(nTag,4,"<!--"))
+    {
+      nEnd = s.find("-->",nTag + 4);
+      bRtn = (nEnd != NPOS);
+      nPos = nEnd + 3;
+    }
+    else if(!s.compare(nTag,9,"<![CDATA["))
+    {
+      nEnd = s.find("]]>",nTag + 9);
+      bRtn = (nEnd != NPOS);
+      nPos = nEnd + 3;
+    }
+    else if(!s.compare(nTag,2,"<?"))
+    {
+      nEnd = s.find("?>",nTag + 2);
+      bRtn = (nEnd != NPOS);
+      nPos = nEnd + 2;
+    }
+    else if( (nEnd = _FindTagEnd(s,nTag + 1)) == NPOS )
+    {
+      bRtn = false;
+    }
+    else if(s[nTag + 1] == '!')
+    {
+      // declaration
+      nPos = nEnd + 1;
+    }
+    else if(s[nTag + 1] == '/')
+    {
+      // end tag
+      nPos = nEnd + 1;
+      if(nSample == NPOS) {}
+      else if(nDepth == 4)
+      {
+        if(bKeep)
+        {
+          psSummary->append(s,nChild,nPos - nChild);
+        }
+        nChild = NPOS;
+      }
+      else if(nDepth == 3)
+      {
+        psSummary->append(s,nTag,nPos - nTag);
+        m_vnLazyOffset.push_back(nSample);
+        m_vnLazyLength.push_back(nPos - nSample);
+        nCopied = nPos;
+        nSample = NPOS;
+      }
+      if((nDepth == 2) && bTable)
+      {
+        bTable = false;
+      }
+      nDepth--;
+    }
+    else
+    {
+      // start tag
+      nPos = nEnd + 1;
+      bEmpty = (s[nEnd - 1] == '/');
+      for(nName = nTag + 1;
+        (nName < nEnd) && !strchr(" \t\r\n/",s[nName]);
+        ++nName) {}
+      nName -= nTag + 1;
+      nDepth++;
+      if((nDepth == 2) && !bEmpty)
+      {
+        bTable = !s.compare(nTag + 1,nName,"Table");
+      }
+      else if((nDepth == 3) && bTable && !s.compare(nTag + 1,nName,"Sample"))
+      {
+        psSummary->append(s,nCopied,nPos - nCopied);
+        if(bEmpty)
+        {
+          m_vnLazyOffset.push_back(nTag);
+          m_vnLazyLength.push_back(nPos - nTag);
+          nCopied = nPos;
+        }
+        else
+        {
+          nSample = nTag;
+        }
+      }
+      else if((nDepth == 4) && (nSample != NPOS))
+      {
+        nChild = nTag;
+        bKeep = COARsample::IsSummaryElement(s.c_str() + nTag + 1,nName);
+        if(bEmpty && bKeep)
+        {
+          psSummary->append(s,nTag,nPos - nTag);
+        }
+      }
+      if(bEmpty)
+      {
+        nDepth--;
+      }
+    }
+  }
+  if(nSample != NPOS)
+  {
+    bRtn = false;
+  }
+  if(bRtn)
+  {
+    psSummary->append(s,nCopied,NPOS);
+  }
+  else
+  {
+    m_vnLazyOffset.clear();
+    m_vnLazyLength.clear();
+  }
+  return bRtn;
+}
+bool COARfile::_SetupLazySamples()
+{
+  // give each sample its text in the file, see LoadDocument()
+  size_t nCount = m_vnLazyOffset.size();
+  bool bRtn = true;
+  m_nLazyCount = 0;
+  if(m_sLazyText.empty()) {}
+  else if(nCount != m_vpTable.Size())
+  {
+    _ClearLazyText();
+    bRtn = false;
+  }
+  else if(!nCount)
+  {
+    _ClearLazyText();
+  }
+  else
+  {
+    for(size_t i = 0; i < nCount; ++i)
+    {
+      m_vpTable.at(i)->SetLazyText(
+        m_vnLazyOffset.at(i),m_vnLazyLength.at(i));
+    }
+    m_nLazyCount = nCount;
+  }
+  m_vnLazyOffset.clear();
+  m_vnLazyLength.clear();
+  return bRtn;
+}
+void COARfile::_LoadSample(const COARsample *pSample) const
+{
+  // this instance owns its samples, loading one
+  // does not change what it contains
+
+  COARsample *p = const_cast<COARsample *>(pSample);
+  COARfile *pThis = const_cast<COARfile *>(this);
+  size_t nOffset = p->GetLazyOffset();
+  size_t nLength = p->GetLazyLength();
+  bool bRtn = (nOffset + nLength <= m_sLazyText.size());
+  p->SetLazyText(0,0);
+  if(bRtn)
+  {
+    std::string sXml(m_sLazyProlog);
+    sXml.append(m_sLazyText,nOffset,nLength);
+    wxMemoryInputStream stream(sXml.data(),sXml.size());
+    wxXmlDocument doc;
+    bRtn = doc.Load(stream) &&
+      (doc.GetRoot() != NULL) &&
+      p->LoadFromNode(doc.GetRoot());
+  }
+  p->PostProcessFile(pThis);
+  if(!bRtn)
+  {
+    // the file would be saved without this sample
+    mainApp::LogMessageV(wxS("Cannot load sample %ls from %ls"),
+      p->GetName().wc_str(),m_sFileName.wc_str());
+    pThis->SetReadOnly(true);
+  }
+  if(m_nLazyCount && !(--m_nLazyCount))
+  {
+    _ClearLazyText();
+  }
+}
+void COARfile::LoadAllSamples() const
+{
+  vector<COARsample *>::const_iterator itr;
+  for(itr = m_vpTable.Get()->begin();
+    (m_nLazyCount > 0) && (itr != m_vpTable.Get()->end());
+    ++itr)
+  {
+    LoadSample(*itr);
+  }
+}
+void COARfile::_ClearLazyText() const
+{
+  std::string().swap(m_sLazyText);
+  m_sLazyProlog.clear();
+  m_nLazyCount = 0;
+}
 void COARfile::_CleanupOsirisVersion() const
 {
   if(m_pOsirisVersion != NULL)
@@ -1634,8 +1989,18 @@ size_t COARfile::DeleteDisabledSamples(const wxString &sUserID)
       itrndx != vnKill.end();
       ++itrndx)
     {
+      if(m_nLazyCount && !m_vpTable.at(*itrndx)->IsLoaded())
+      {
+        // this sample will never be loaded from m_sLazyText
+        m_nLazyCount--;
+      }
       m_vpTable.removeAt(*itrndx);
     }
+    if(!m_nLazyCount)
+    {
+      _ClearLazyText();
+    }
+    m_mapSampleName.clear();
     wxString s = sUserID.IsEmpty() ? wxGetUserId() : sUserID;
     AppendNotesDir(sNotes,s);
     SetIsModified(true);
@@ -45,6 +45,10 @@
 #include "COARreview.h"
 #include "COARMsgExport.h"
 #include "CAlertViewStatus.h"
+#include "nwx/stdb.h"
+#include <string>
+#include <vector>
+#include "nwx/stde.h"
 class nwxXmlCMF;
 class nwxXmlCMFSpecimen;
 class CXMLmessageBook;
@@ -94,6 +98,8 @@ public:
     m_bCheckVersion = true;
     m_pOsirisVersion = NULL;
     m_nLadderFree = LADDER_FREE_NOT_SET;
+    m_nLazyCount = 0;
+    m_bLazyLoad = true;
     RegisterAll(true);
   }
   COARfile(const COARfile &x) :
@@ -104,12 +110,15 @@ public:
     m_pOsirisVersion = NULL;
     m_pMsgBook = NULL;
     m_bCheckedMsgBook = false;
+    m_nLazyCount = 0;
+    m_bLazyLoad = true;
     RegisterAll(true);
     m_messages.SetMsgExport(&m_mapExportSpecifications);
     (*this) = x;
   }
   COARfile &operator=(const COARfile &x)
   {
+    x.LoadAllSamples(); // the copy does not have the file text
     LocalInit();
     COARcopy(m_dtLastLoad);
     COARcopy(m_bModified);
@@ -194,6 +203,7 @@ public:
   virtual bool LoadFile(const wxString &sFileName);
   virtual bool SaveFile(const wxString &sFileName)
   {
+    LoadAllSamples();
     m_heading.SetNewFileName(sFileName);
     m_heading.SetNewFileCreationTime();
     bool bRtn = nwxXmlPersist::SaveFile(sFileName);
@@ -371,12 +381,30 @@ public:
   }
   COARsample *GetSample(size_t n)
   {
-    return m_vpTable.at(n);
+    COARsample *pRtn = m_vpTable.at(n);
+    LoadSample(pRtn);
+    return pRtn;
   }
   const COARsample *GetSample(size_t n) const
   {
+    const COARsample *pRtn = m_vpTable.at(n);
+    LoadSample(pRtn);
+    return pRtn;
+  }
+  COARsample *GetSampleNoLoad(size_t n)
+  {
+    // only the summary of the sample is needed,
+    // see COARsample::IsSummaryElement()
     return m_vpTable.at(n);
   }
+  void LoadSample(const COARsample *pSample) const
+  {
+    if(!pSample->IsLoaded())
+    {
+      _LoadSample(pSample);
+    }
+  }
+  void LoadAllSamples() const;
   COARsample *GetSampleByName(const wxString &sName);
   void LocalInit()
   {
@@ -387,10 +415,14 @@ public:
     m_sFileName.Clear();
     m_bModified = false;
     m_mapInputPath.clear();
+    m_vsSearchDir.clear();
+    m_sSearchDirKey.Empty();
     m_sInputType.Empty();
     m_bSetupInputPath = false;
     m_nLadderFree = LADDER_FREE_NOT_SET;
     m_vpTable.Init();
+    _ClearLazyText();
+    m_mapSampleName.clear();
     m_pvOldNotes.Init();
     m_messages.Init();
     _ClearLocusInfo();
@@ -770,12 +802,26 @@ private:
   COARmsgExportMap m_mapExportSpecifications;
   mutable wxString m_sInputType;
   mutable map<wxString,wxString> m_mapInputPath;
+  mutable vector<wxString> m_vsSearchDir; // see FindFileByName()
+  mutable wxString m_sSearchDirKey;
   mutable map<wxString,const COARchannel *> m_mapLocusChannel; //**
+  map<wxString,COARsample *> m_mapSampleName; //**
   mutable vector<wxString> m_vsLocus; //**
   mutable vector<int> m_vnChannelNr; //**
   mutable const COARsample *m_pLastSampleDisabled; //**
   mutable COsirisVersion *m_pOsirisVersion;
   mutable LADDER_FREE_STATUS m_nLadderFree;
+
+  // lazy loading, the text of the file and the offset and length
+  // of each sample in it, see LoadDocument()
+
+  mutable std::string m_sLazyText; //**
+  mutable std::string m_sLazyProlog; //**
+  vector<size_t> m_vnLazyOffset; //**
+  vector<size_t> m_vnLazyLength; //**
+  mutable size_t m_nLazyCount; //**
+  bool m_bLazyLoad; //**
+
   bool m_bModified; //**
   bool m_bCheckedMsgBook; //**
   mutable bool m_bSetupInputPath;
@@ -799,6 +845,7 @@ private:
     const wxDateTime *pTime = NULL,
     bool bReverse = false) const;
   bool _SetupInputPath() const;
+  const vector<wxString> &_GetSearchDirectories() const;
 
   void _ClearMessageBook();
   void _ClearLocusInfo() const
@@ -815,6 +862,23 @@ private:
       __BuildLocusMap();
     }
   }
+  static bool _ReadFile(const wxString &sFileName, std::string *ps);
+  static size_t _FindTagEnd(const std::string &s, size_t nPos);
+  bool _IndexSamples(std::string *psSummary);
+  bool _SetupLazySamples();
+  void _LoadSample(const COARsample *pSample) const;
+  void _ClearLazyText() const;
+  static wxString _SampleNameKey(const wxString &sName);
+  void __BuildSampleNameMap();
+  void _BuildSampleNameMap()
+  {
+    if(m_mapSampleName.empty())
+    {
+      __BuildSampleNameMap();
+    }
+  }
+protected:
+  virtual bool LoadDocument(wxXmlDocument *pDoc, const wxString &sFileName);
 };
 
 
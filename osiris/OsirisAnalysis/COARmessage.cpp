@@ -316,30 +316,51 @@ const COARmessage *COARmessages::GetMessageByNumber(int n) const
 const COARmessage *COARmessages::GetMessageByNumber(int n, const wxDateTime *pTime) const
 {
   // get the 'newest' message by number (n)
-  // where update time <= pTime
+  // where update time <= pTime, from the history index
+
+  const COARmessage *pRtn(NULL);
+  if(pTime == NULL)
+  {
+    pRtn = GetMessageByNumber(n);
+  }
+  else
+  {
+    _BuildHistoryIndex();
+    size_t nSlot = _GetSlot(n);
+    if(nSlot != (size_t)-1)
+    {
+      pRtn = _GetSnapshot(_CountTimesAtOrBefore(*pTime))->m_vpMsg.at(nSlot);
+    }
+  }
+  return pRtn;
+}
+const COARmessage *COARmessages::_FindMessage(int n, const wxDateTime &t) const
+{
+  // get the 'newest' message by number (n)
+  // where update time <= t
 
   // the time original message for each number is unspecified
-  // therefore it will be used even if *pTime is less than
+  // therefore it will be used even if t is less than
   // the time the original file was created...
 
   const COARmessage *pRtn(GetMessageByNumber(n));
-  if( (pTime == NULL) || (pRtn == NULL) ) {;} // no time specified or no message found, we are done
-  else if( pRtn->GetTime() > *pTime )
+  if(pRtn == NULL) {;} // no message found, we are done
+  else if( pRtn->GetTime() > t )
   {
     // no message yet or message is too new
     const COARmessage *pMsg;
     pRtn = NULL;
-    __BuildMapEdited();
+    _BuildMapEdited();
     pair<MITR,MITR> itrs = m_mapMessageEdited.equal_range(n);
     MITR itr;
     for(itr = itrs.first; itr != itrs.second; ++itr)
     {
       pMsg = itr->second;
       const wxDateTime &dt(pMsg->GetTime());
-      if(dt > *pTime) {;} // skip this one
+      if(dt > t) {;} // skip this one
       else if( (pRtn == NULL) || (dt > pRtn->GetTime()) )
       {
-        // this one is newer and still <= *pTime
+        // this one is newer and still <= t
         pRtn = pMsg;
       }
     }
@@ -349,24 +370,203 @@ const COARmessage *COARmessages::GetMessageByNumber(int n, const wxDateTime *pTi
 bool COARmessages::IsMessageEdited(int n, const wxDateTime *pTime) const
 {
   bool bRtn = false;
-  _BuildMapEdited();
-  pair<MITR,MITR> itrs = m_mapMessageEdited.equal_range(n);
-  if(pTime == NULL)
+  size_t nSlot = (size_t)-1;
+  if(pTime != NULL)
+  {
+    _BuildHistoryIndex();
+    nSlot = _GetSlot(n);
+  }
+  if(nSlot != (size_t)-1)
   {
-    bRtn = (itrs.first != itrs.second);
+    // edited before *pTime, from the history index
+    bRtn = _GetSnapshot(_CountTimesBefore(*pTime))->m_vbEdited.at(nSlot);
   }
   else
   {
-    const COARmessage *pMsg;
-    for(MITR itr = itrs.first; (itr != itrs.second) && (!bRtn); ++itr)
+    _BuildMapEdited();
+    pair<MITR,MITR> itrs = m_mapMessageEdited.equal_range(n);
+    if(pTime == NULL)
     {
-      pMsg = itr->second;
-      const wxDateTime &dt(pMsg->GetTime());
-      if((dt.GetTicks() > 0) && (dt < *pTime))
+      bRtn = (itrs.first != itrs.second);
+    }
+    else
+    {
+      const COARmessage *pMsg;
+      for(MITR itr = itrs.first; (itr != itrs.second) && (!bRtn); ++itr)
       {
-        bRtn = true;
+        pMsg = itr->second;
+        const wxDateTime &dt(pMsg->GetTime());
+        if((dt.GetTicks() > 0) && (dt < *pTime))
+        {
+          bRtn = true;
+        }
       }
     }
   }
   return bRtn;
 }
+
+void COARmessages::__BuildHistoryIndex() const
+{
+  vector<COARmessage *>::const_iterator itr;
+  size_t nCount = m_vpMessage.size();
+  size_t i;
+  int n;
+  int nMax = 0;
+  bool bDense = true;
+
+  _ClearHistoryIndex();
+  m_vdtHistory.reserve(nCount + m_vpMessageEdited.size());
+  for(itr = m_vpMessage.begin(); itr != m_vpMessage.end(); ++itr)
+  {
+    m_vdtHistory.push_back((*itr)->GetTime());
+    n = (*itr)->GetMessageNumber();
+    if(n < 0)
+    {
+      bDense = false;
+    }
+    else if(n > nMax)
+    {
+      nMax = n;
+    }
+  }
+  for(itr = m_vpMessageEdited.begin(); itr != m_vpMessageEdited.end(); ++itr)
+  {
+    m_vdtHistory.push_back((*itr)->GetTime());
+  }
+  sort(m_vdtHistory.begin(),m_vdtHistory.end());
+  m_vdtHistory.erase(
+    unique(m_vdtHistory.begin(),m_vdtHistory.end()),
+    m_vdtHistory.end());
+  m_vpHistory.resize(m_vdtHistory.size() + 1,NULL);
+
+  // message numbers are normally 1 to the number of messages;
+  // the first message with a number is used, as in m_mapMessage
+
+  if(bDense && ((size_t)nMax > (nCount << 2) + 256))
+  {
+    bDense = false;
+  }
+  if(bDense)
+  {
+    m_vnSlot.resize((size_t)nMax + 1,(size_t)-1);
+  }
+  for(i = nCount; i > 0; --i)
+  {
+    n = m_vpMessage.at(i - 1)->GetMessageNumber();
+    if(bDense)
+    {
+      m_vnSlot.at((size_t)n) = i - 1;
+    }
+    else
+    {
+      m_mapSlot[n] = i - 1;
+    }
+  }
+  m_bHistoryIndex = true;
+}
+void COARmessages::_ClearHistoryIndex() const
+{
+  vectorptr<CHistorySnapshot>::cleanup(&m_vpHistory);
+  m_vdtHistory.clear();
+  m_vnSlot.clear();
+  m_mapSlot.clear();
+  m_bHistoryIndex = false;
+}
+void COARmessages::_UpdateHistoryIndex(
+  const COARmessage *pCurrent, const COARmessage *pOld,
+  const wxDateTime &t)
+{
+  // pCurrent has been updated at time t and its previous
+  // version copied to pOld.  Edits are normally newer than
+  // every message, which leaves the built snapshots valid except
+  // for this message, otherwise the index is rebuilt when used
+
+  if(!m_bHistoryIndex) {;}
+  else if(m_vdtHistory.empty() || !(t > m_vdtHistory.back()))
+  {
+    _ClearHistoryIndex();
+  }
+  else
+  {
+    size_t nSlot = _GetSlot(pCurrent->GetMessageNumber());
+    size_t nSize = m_vpHistory.size();
+    const wxDateTime &dtOld(pOld->GetTime());
+    bool bEdited = (dtOld.GetTicks() > 0);
+    CHistorySnapshot *pSnap;
+    for(size_t j = 1; j < nSize; j++)
+    {
+      pSnap = m_vpHistory.at(j);
+      if((pSnap != NULL) && (nSlot != (size_t)-1))
+      {
+        if(pSnap->m_vpMsg.at(nSlot) == pCurrent)
+        {
+          pSnap->m_vpMsg.at(nSlot) = pOld;
+        }
+        if(bEdited && (dtOld <= m_vdtHistory.at(j - 1)))
+        {
+          pSnap->m_vbEdited.at(nSlot) = true;
+        }
+      }
+    }
+    m_vdtHistory.push_back(t);
+    m_vpHistory.push_back(NULL);
+  }
+}
+size_t COARmessages::_GetSlot(int n) const
+{
+  size_t nRtn = (size_t)-1;
+  if(!m_vnSlot.empty())
+  {
+    if((n >= 0) && ((size_t)n < m_vnSlot.size()))
+    {
+      nRtn = m_vnSlot.at((size_t)n);
+    }
+  }
+  else
+  {
+    map<int,size_t>::const_iterator itr = m_mapSlot.find(n);
+    if(itr != m_mapSlot.end())
+    {
+      nRtn = itr->second;
+    }
+  }
+  return nRtn;
+}
+const COARmessages::CHistorySnapshot *COARmessages::_GetSnapshot(size_t j) const
+{
+  CHistorySnapshot *pRtn = m_vpHistory.at(j);
+  if(pRtn == NULL)
+  {
+    size_t nCount = m_vpMessage.size();
+    pRtn = new CHistorySnapshot;
+    pRtn->m_vpMsg.resize(nCount,NULL);
+    pRtn->m_vbEdited.resize(nCount,false);
+    if(j > 0)
+    {
+      // no message has a version as of a time before all of them
+      const wxDateTime &t(m_vdtHistory.at(j - 1));
+      const COARmessage *pMsg;
+      int n;
+      _BuildMapEdited();
+      for(size_t i = 0; i < nCount; i++)
+      {
+        n = m_vpMessage.at(i)->GetMessageNumber();
+        pRtn->m_vpMsg.at(i) = _FindMessage(n,t);
+        pair<MITR,MITR> itrs = m_mapMessageEdited.equal_range(n);
+        for(MITR itr = itrs.first; itr != itrs.second; ++itr)
+        {
+          pMsg = itr->second;
+          const wxDateTime &dt(pMsg->GetTime());
+          if((dt.GetTicks() > 0) && (dt <= t))
+          {
+            pRtn->m_vbEdited.at(i) = true;
+            break;
+          }
+        }
+      }
+    }
+    m_vpHistory.at(j) = pRtn;
+  }
+  return pRtn;
+}
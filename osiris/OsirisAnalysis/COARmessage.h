@@ -31,6 +31,9 @@
 #define __C_OAR_MESSAGE_H__
 
 #include "COARmisc.h"
+#include "nwx/stdb.h"
+#include <algorithm>
+#include "nwx/stde.h"
 
 class COARmsgExportMap;
 
@@ -155,11 +158,12 @@ private:
 class COARmessages : public nwxXmlPersist
 {
 public:
-  COARmessages() : m_pMsgExport(NULL)
+  COARmessages() : m_pMsgExport(NULL), m_bHistoryIndex(false)
   {
     RegisterAll(true);
   }
-  COARmessages(const COARmessages &x) : m_pMsgExport(NULL)
+  COARmessages(const COARmessages &x) :
+    m_pMsgExport(NULL), m_bHistoryIndex(false)
   {
     RegisterAll(true);
     (*this) = x;
@@ -395,6 +399,7 @@ public:
       _InitMapEdited();
       (*pmsg) = msg;
       pmsg->SetTime(t);
+      _UpdateHistoryIndex(pmsg,pNew,t);
       bRtn = true;
     }
     return bRtn;
@@ -440,6 +445,7 @@ private:
   void _InitMap() const
   {
     m_mapMessage.clear();
+    _ClearHistoryIndex();
   }
   void _InitMaps() const
   {
@@ -447,9 +453,51 @@ private:
     _InitMapEdited();
   }
 
+  // history index, for each distinct message time, the version of
+  // every message and whether it had been edited as of that time.
+  // Snapshot j applies to the query times after exactly j of the
+  // distinct times, and is built when first used
+
+  class CHistorySnapshot
+  {
+  public:
+    vector<const COARmessage *> m_vpMsg; // by index in m_vpMessage
+    vector<bool> m_vbEdited;
+  };
+  const COARmessage *_FindMessage(int n, const wxDateTime &t) const;
+  void __BuildHistoryIndex() const;
+  void _BuildHistoryIndex() const
+  {
+    if(!m_bHistoryIndex)
+    {
+      __BuildHistoryIndex();
+    }
+  }
+  void _ClearHistoryIndex() const;
+  void _UpdateHistoryIndex(
+    const COARmessage *pCurrent, const COARmessage *pOld,
+    const wxDateTime &t);
+  size_t _GetSlot(int n) const;
+  const CHistorySnapshot *_GetSnapshot(size_t j) const;
+  size_t _CountTimesAtOrBefore(const wxDateTime &t) const
+  {
+    return upper_bound(m_vdtHistory.begin(),m_vdtHistory.end(),t) -
+      m_vdtHistory.begin();
+  }
+  size_t _CountTimesBefore(const wxDateTime &t) const
+  {
+    return lower_bound(m_vdtHistory.begin(),m_vdtHistory.end(),t) -
+      m_vdtHistory.begin();
+  }
+
   mutable map<int,COARmessage *> m_mapMessage;
   mutable multimap<int,COARmessage *> m_mapMessageEdited;
   mutable const COARmsgExportMap *m_pMsgExport;
+  mutable vector<wxDateTime> m_vdtHistory;
+  mutable vector<CHistorySnapshot *> m_vpHistory;
+  mutable vector<size_t> m_vnSlot;     // message number to index in m_vpMessage
+  mutable map<int,size_t> m_mapSlot;   // when message numbers are sparse
+  mutable bool m_bHistoryIndex;
 
   vector<COARmessage *> m_vpMessage;
   vector<COARmessage *> m_vpMessageEdited;
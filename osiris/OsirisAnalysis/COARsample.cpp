@@ -34,6 +34,7 @@
 #include <set>
 #include <map>
 #include <memory>
+#include <string.h>
 #include "nwx/stde.h"
 #include "nwx/nsstd.h"
 #include "nwx/nwxString.h"
@@ -121,6 +122,35 @@ void COARsample::LocalInit()
   vectorptr<COARnotes>::cleanup(&m_vpOldNotesChannel);
   vectorptr<COARnotes>::cleanup(&m_vpOldNotesILS);
   m_mapIDchannel.clear();
+  m_nLazyOffset = 0;
+  m_nLazyLength = 0;
+}
+bool COARsample::IsSummaryElement(const char *pName, size_t nLen)
+{
+  // elements used to list, sort, and enable or disable samples
+  // before they are loaded.  Everything else in a sample is only
+  // used when it is displayed, exported, or edited
+  static const char *LIST[] =
+  {
+    "Name",
+    "SampleName",
+    "Comment",
+    "RunStart",
+    "EnableHistory",
+    "Type",
+    "Info",
+    "PositiveControl",
+    NULL
+  };
+  bool bRtn = false;
+  for(const char **ps = LIST; (*ps != NULL) && !bRtn; ++ps)
+  {
+    if( (strlen(*ps) == nLen) && !strncmp(*ps,pName,nLen) )
+    {
+      bRtn = true;
+    }
+  }
+  return bRtn;
 }
 
 
@@ -231,14 +231,18 @@ public:
       m_pvAlertInterLocus("Alert"),
       m_Reviews(true),
       m_Acceptance(false),
-      m_pFile(pFile)
+      m_pFile(pFile),
+      m_nLazyOffset(0),
+      m_nLazyLength(0)
   {
     RegisterAll(true);
   }
   COARsample(const COARsample &x) :
       m_pvChannelAlerts("Channel"),
       m_pvAlertInterLocus("Alert"),
-      m_pFile(NULL)
+      m_pFile(NULL),
+      m_nLazyOffset(0),
+      m_nLazyLength(0)
   {
     RegisterAll(true);
     (*this) = x;
@@ -291,6 +295,29 @@ public:
   }
   const wxString &GetPlotFileName() const;
   void PostProcessFile(COARfile *pFile = NULL); // whatever needs to be done after file is loaded
+
+  // a sample loaded from an .oar file has only its summary
+  // elements until COARfile::LoadSample() loads the rest of
+  // it from the file text, see COARfile::LoadDocument()
+
+  static bool IsSummaryElement(const char *pName, size_t nLen);
+  bool IsLoaded() const
+  {
+    return !m_nLazyLength;
+  }
+  size_t GetLazyOffset() const
+  {
+    return m_nLazyOffset;
+  }
+  size_t GetLazyLength() const
+  {
+    return m_nLazyLength;
+  }
+  void SetLazyText(size_t nOffset, size_t nLength)
+  {
+    m_nLazyOffset = nOffset;
+    m_nLazyLength = nLength;
+  }
   size_t CountAlerts(const COARmessages *, const wxDateTime *pTime = NULL) const;
   bool HasAnyAlerts(const COARmessages *, const wxDateTime *pTime = NULL) const;
       // used to determine background color for cells without alerts
@@ -927,6 +954,8 @@ private:
   typedef std::map<int,int> map_ID_CHANNEL;
   mutable map_ID_CHANNEL  m_mapIDchannel;
   COARfile *m_pFile;
+  size_t m_nLazyOffset; // text of this sample in COARfile
+  size_t m_nLazyLength; // 0 if loaded
 
 private:
   TnwxXmlIOPersistVector<COARlocus> m_ioLocus;
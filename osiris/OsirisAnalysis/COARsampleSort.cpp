@@ -126,6 +126,7 @@ public:
   virtual void Insert(COARsample *pSample)
   {
     size_t n = m_pv.size();
+    m_pFile->LoadSample(pSample);
     size_t nSeverity = pSample->CountAlerts(m_pFile->GetMessages(),*m_pTime);
     SeverityPair xpair(n,nSeverity);
     m_set.insert(xpair);
@@ -142,14 +143,21 @@ public:
     if(m_itr != m_set.end())
     {
       pRtn = m_pv.at(m_itr->first);
+      m_last = *m_itr;
       m_itr++;
     }
     return pRtn;
   }
+  const SeverityPair &GetLast() const
+  {
+    // order and severity of the sample last returned by Next()
+    return m_last;
+  }
 
 private:
   COARfile *m_pFile;
   CHistoryTime *m_pTime;
+  SeverityPair m_last;
   SeveritySet m_set;
   vector<COARsample *> m_pv;
   SeveritySet::iterator m_itr;
@@ -190,9 +198,25 @@ private:
 
 void COARsampleSort::Sort(COARfile *pFile, const wxDateTime *pTime)
 {
+  bool bSame = 
+    (pFile == m_pFile) &&
+    (!m_bAllChanged) &&
+    (m_nLastSort >= 0) &&
+    (m_dtLastLoad == pFile->GetLastLoad()) &&
+    (m_vpSamples.size() == pFile->GetSampleCount()) &&
+    m_histTime.IsEqualTo(pTime) &&
+    (m_nLastSort == CGridAnalysisDisplay::GetSortType()) &&
+    (m_bLastControlOnTop == CGridAnalysisDisplay::GetControlsOnTop());
   m_pFile = pFile;
   m_histTime.SetDateTime(pTime);
-  _Sort();
+  if(bSame)
+  {
+    _Resort();
+  }
+  else
+  {
+    _Sort();
+  }
 }
 
 void COARsampleSort::_CheckUpdate()
@@ -207,16 +231,34 @@ void COARsampleSort::_CheckUpdate()
     }
   }
 }
+void COARsampleSort::_Append(
+  COARsample *pSample, size_t nOrder, size_t nSeverity)
+{
+  m_mapIndex.insert(
+    map<COARsample *, size_t>::value_type(pSample,m_vpSamples.size()));
+  m_vpSamples.push_back(pSample);
+  m_vnOrder.push_back(nOrder);
+  m_vnSeverity.push_back(nSeverity);
+}
 void COARsampleSort::_Sort()
 {
 
   size_t nRowCount = m_pFile->GetSampleCount();
   auto_ptr<ISampleSorter> pSort(NULL);
+  SampleSortSeverity *pSortSeverity = NULL;
 
   m_bLastControlOnTop = CGridAnalysisDisplay::GetControlsOnTop();
   m_nLastSort = CGridAnalysisDisplay::GetSortType();
+  m_dtLastLoad = m_pFile->GetLastLoad();
+  m_bAllChanged = false;
+  m_setChanged.clear();
+  m_mapIndex.clear();
   m_vpSamples.clear();
   m_vpSamples.reserve(nRowCount);
+  m_vnOrder.clear();
+  m_vnOrder.reserve(nRowCount);
+  m_vnSeverity.clear();
+  m_vnSeverity.reserve(nRowCount);
 
   if(m_nLastSort == SAMPLE_NAME)
   {
@@ -224,7 +266,8 @@ void COARsampleSort::_Sort()
   }
   else if(m_nLastSort == SEVERITY)
   {
-    pSort = auto_ptr<ISampleSorter>(new SampleSortSeverity(m_pFile,&m_histTime));
+    pSortSeverity = new SampleSortSeverity(m_pFile,&m_histTime);
+    pSort = auto_ptr<ISampleSorter>(pSortSeverity);
   }
   else if(m_nLastSort == RUN_TIME)
   {
@@ -238,40 +281,124 @@ void COARsampleSort::_Sort()
   COARsample *pSample;
   for(i = 0; i < nRowCount; i++)
   {
-    pSample = m_pFile->GetSample(i);
+    // samples are loaded when used, see COARfile::LoadSample()
+    pSample = m_pFile->GetSampleNoLoad(i);
     if((!m_bLastControlOnTop) || pSample->IsSampleType())
     {
-      pSort->Insert(m_pFile->GetSample(i));
+      pSort->Insert(pSample);
     }
     else
     {
-      m_vpSamples.push_back(pSample);
+      _Append(pSample,0,0);
     }
   }
+  m_nFirstSorted = m_vpSamples.size();
   for(pSample = pSort->First(); pSample != NULL; pSample = pSort->Next())
   {
-    m_vpSamples.push_back(pSample);
+    if(pSortSeverity != NULL)
+    {
+      const SeverityPair &xpair(pSortSeverity->GetLast());
+      _Append(pSample,xpair.first,xpair.second);
+    }
+    else
+    {
+      _Append(pSample,0,0);
+    }
+  }
+
+}
+void COARsampleSort::_Resort()
+{
+  // the samples, sort type and history time are unchanged, so only
+  // edited samples can be out of place, and only when sorted by
+  // severity because names and run times are not edited
+
+  if(m_nLastSort == SEVERITY)
+  {
+    const COARmessages *pMsgs = m_pFile->GetMessages();
+    set<COARsample *>::iterator itr;
+    map<COARsample *, size_t>::iterator itrIndex;
+    size_t nSeverity;
+    for(itr = m_setChanged.begin(); itr != m_setChanged.end(); ++itr)
+    {
+      itrIndex = m_mapIndex.find(*itr);
+      if( (itrIndex != m_mapIndex.end()) &&
+          (itrIndex->second >= m_nFirstSorted) )
+      {
+        nSeverity = (*itr)->CountAlerts(pMsgs,m_histTime);
+        if(nSeverity != m_vnSeverity.at(itrIndex->second))
+        {
+          _MoveSample(itrIndex->second,nSeverity);
+        }
+      }
+    }
   }
+  m_setChanged.clear();
+}
+void COARsampleSort::_MoveSample(size_t nFrom, size_t nSeverity)
+{
+  COARsample *pSample = m_vpSamples.at(nFrom);
+  size_t nOrder = m_vnOrder.at(nFrom);
+  SeverityPair xpair(nOrder,nSeverity);
+  SeverityLess less;
+  size_t nLo;
+  size_t nHi;
+  size_t nMid;
 
+  m_vpSamples.erase(m_vpSamples.begin() + nFrom);
+  m_vnOrder.erase(m_vnOrder.begin() + nFrom);
+  m_vnSeverity.erase(m_vnSeverity.begin() + nFrom);
+
+  // first sorted row that does not sort before the sample
+
+  nLo = m_nFirstSorted;
+  nHi = m_vpSamples.size();
+  while(nLo < nHi)
+  {
+    nMid = (nLo + nHi) >> 1;
+    if(less(SeverityPair(m_vnOrder.at(nMid),m_vnSeverity.at(nMid)),xpair))
+    {
+      nLo = nMid + 1;
+    }
+    else
+    {
+      nHi = nMid;
+    }
+  }
+  m_vpSamples.insert(m_vpSamples.begin() + nLo,pSample);
+  m_vnOrder.insert(m_vnOrder.begin() + nLo,nOrder);
+  m_vnSeverity.insert(m_vnSeverity.begin() + nLo,nSeverity);
+  if(nLo < nFrom)
+  {
+    _UpdateIndex(nLo,nFrom);
+  }
+  else
+  {
+    _UpdateIndex(nFrom,nLo);
+  }
+}
+void COARsampleSort::_UpdateIndex(size_t nFirst, size_t nLast)
+{
+  for(size_t i = nFirst; i <= nLast; ++i)
+  {
+    m_mapIndex[m_vpSamples.at(i)] = i;
+  }
 }
 const size_t COARsampleSort::NPOS = ~((size_t)0);
 
 size_t COARsampleSort::GetSampleIndex(COARsample *pSample)
 {
   size_t nRtn = NPOS;
-  size_t nSize = GetCount();
-  for(size_t i = 0; i < nSize; ++i)
+  map<COARsample *, size_t>::iterator itr;
+  _CheckUpdate();
+  itr = m_mapIndex.find(pSample);
+  if(itr != m_mapIndex.end())
   {
-    if(pSample == GetSample(i))
-    {
-      nRtn = i;
-      i = nSize;
-    }
+    nRtn = itr->second;
   }
   return nRtn;
 }
 
-
 /*
 void COARsampleSort::_SortByFileName()
 {
@@ -32,6 +32,10 @@
 
 #include "COARfile.h"
 #include "CHistoryTime.h"
+#include "nwx/stdb.h"
+#include <map>
+#include <set>
+#include "nwx/stde.h"
 
 
 
@@ -45,7 +49,12 @@ public:
   static const int RUN_TIME;
 
 
-  COARsampleSort(COARfile *pFile)
+  COARsampleSort(COARfile *pFile) :
+    m_pFile(NULL),
+    m_nFirstSorted(0),
+    m_nLastSort(-1),
+    m_bLastControlOnTop(false),
+    m_bAllChanged(false)
   {
     m_dtLastLoad = pFile->GetLastLoad();
     Sort(pFile,NULL);
@@ -53,11 +62,16 @@ public:
   COARsampleSort() : 
     m_dtLastLoad((time_t)0),
     m_pFile(NULL),
+    m_nFirstSorted(0),
     m_nLastSort(-1),
-    m_bLastControlOnTop(false)
+    m_bLastControlOnTop(false),
+    m_bAllChanged(false)
   {; }
   virtual ~COARsampleSort() {;}
 
+  // if nothing but sample edits changed since the last sort,
+  // Sort() only repositions the edited samples
+
   void Sort(COARfile *pFile, const wxDateTime *pTime = NULL);
   void UpdateSort()
   {
@@ -66,13 +80,31 @@ public:
       _Sort();
     }
   }
+  void SampleChanged(COARsample *pSample)
+  {
+    m_setChanged.insert(pSample);
+  }
+  void AllChanged()
+  {
+    m_bAllChanged = true;
+  }
   const vector<COARsample *> *GetSamples()
   {
     _CheckUpdate();
+    _LoadAllSamples();
     return &m_vpSamples;
   }
   COARsample *GetSample(size_t i)
   {
+    _CheckUpdate();
+    COARsample *pRtn = m_vpSamples.at(i);
+    m_pFile->LoadSample(pRtn);
+    return pRtn;
+  }
+  COARsample *GetSampleNoLoad(size_t i)
+  {
+    // only the summary of the sample is needed,
+    // see COARsample::IsSummaryElement()
     _CheckUpdate();
     return m_vpSamples.at(i);
   }
@@ -84,13 +116,26 @@ public:
   vector<COARsample *> *operator ->()
   {
     _CheckUpdate();
+    _LoadAllSamples();
     return &m_vpSamples;
   }
   size_t GetSampleIndex(COARsample *pSample);
   static const size_t NPOS;
 private:
+  void _LoadAllSamples()
+  {
+    // every sample can be used, see COARfile::LoadSample()
+    if(m_pFile != NULL)
+    {
+      m_pFile->LoadAllSamples();
+    }
+  }
   void _CheckUpdate();
   void _Sort();
+  void _Resort();
+  void _Append(COARsample *pSample, size_t nOrder, size_t nSeverity);
+  void _MoveSample(size_t nFrom, size_t nSeverity);
+  void _UpdateIndex(size_t nFirst, size_t nLast);
 //  void _SortBySeverity();
 //  void _SortBySampleName();
 //  void _SortByFileName();
@@ -98,11 +143,21 @@ private:
   void _SortByDisplay(int nDisplay);
   vector<COARsample *> m_vpSamples;
 
+  // for each row, the sample's position among the sorted samples
+  // in file order and its severity, used by SEVERITY only
+
+  vector<size_t> m_vnOrder;
+  vector<size_t> m_vnSeverity;
+  map<COARsample *, size_t> m_mapIndex;
+  set<COARsample *> m_setChanged;
+
   CHistoryTime m_histTime;
   wxDateTime m_dtLastLoad;
   COARfile *m_pFile;
+  size_t m_nFirstSorted;  // controls on top are not sorted
   int m_nLastSort;
   bool m_bLastControlOnTop;
+  bool m_bAllChanged;
 };
 
 
@@ -366,6 +366,7 @@ void CPanelPlot::_BuildPanel(
   m_pSizer->Add(m_pPlotCtrl,1,wxEXPAND);
 
   m_pPlotCtrl->SetDrawSymbols(false);
+  m_pPlotCtrl->SetCacheCurves(true);
   m_pPlotCtrl->SetXLabels(_GetXAxisLabel());
   m_pPlotCtrl->SetYLabels("RFU");
   m_pPlotCtrl->SetShowXAxisLabel(true);
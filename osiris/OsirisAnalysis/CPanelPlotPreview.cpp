@@ -276,7 +276,7 @@ void CPanelPlotPreview::_Cleanup(size_t n)
     pPanel = *itr;
     pData = pPanel->GetPlotData();
     pPanel->Destroy();
-    delete pData;
+    CPlotDataCache::Release(pData);
     m_listPlots.pop_back();
   }
 }
@@ -301,7 +301,7 @@ bool CPanelPlotPreview::_RemoveFile(const wxString &sFileName)
         m_pSizer->Detach(pPanel);
       }
       pPanel->Destroy();
-      delete pData;
+      CPlotDataCache::Release(pData);
       m_listPlots.erase(itr);
       bRtn = true;
       break;
@@ -334,13 +334,13 @@ CPanelPlot *CPanelPlotPreview::_Create(const wxString &sFileName)
   if(wxFileName::IsFileReadable(sFileName))
   {
     wxBusyCursor xxx;
-    auto_ptr<CPlotData> pData(new CPlotData());
-    if(pData->LoadFile(sFileName))
+    CPlotData *pData = CPlotDataCache::Acquire(sFileName);
+    if(pData != NULL)
     {
       pRtn = new CPanelPlot(
         this,
         m_pFrameAnalysis,
-        pData.release(),
+        pData,
         m_pOARfile,
         m_pColors
       );
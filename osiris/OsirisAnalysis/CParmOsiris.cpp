@@ -88,6 +88,7 @@ CParmOsiris &CParmOsiris::operator =(const CParmOsiris &x)
   CP(m_nSampleDetectionThreshold);
   CP(m_sAnalysisOverride);
   CP(m_nAnalysisSplitPos);
+  CP(m_nMaxConcurrentAnalyses);
   CP(m_anChannelRFU);
   CP(m_anChannelDetection);
   CP(m_bTimeStampSubDir);
@@ -258,6 +259,7 @@ bool CParmOsiris::IsEqual(const CParmOsiris &x) const
   CP(m_nSampleDetectionThreshold)
   CP(m_sAnalysisOverride)
   CP(m_nAnalysisSplitPos)
+  CP(m_nMaxConcurrentAnalyses)
   CP(m_anChannelRFU)
   CP(m_anChannelDetection)
   CP(m_bTimeStampSubDir)
@@ -265,9 +267,9 @@ bool CParmOsiris::IsEqual(const CParmOsiris &x) const
 
   //  CMF settings
 
-  CP(m_sCMFsourceLab)
 
   if(!bRtn) {}
+  CP(m_sCMFsourceLab)
   CP(m_sCMFdestLab)
   CP(m_sCMFdefaultSample)
   CP(m_sCMFbatchFormat)
@@ -290,9 +292,9 @@ bool CParmOsiris::IsEqual(const CParmOsiris &x) const
   CP(m_bHideGraphicScrollbar)
   CP(m_bHideTextToolbar)
   CP(m_bHideSampleToolbar)
-  CP(m_bStartupMRU)
 
   if(!bRtn) {}
+  CP(m_bStartupMRU)
   CP(m_bCheckBeforeExit)
   CP(m_bWarnOnHistory)
   CP(m_dZoomLocusMargin)
@@ -321,9 +323,9 @@ bool CParmOsiris::IsEqual(const CParmOsiris &x) const
   //  plot settings
 
   CP(m_bPlotDataAnalyzed)
-  CP(m_bPlotDataRaw)
 
   if(!bRtn) {}
+  CP(m_bPlotDataRaw)
   CP(m_bPlotDataLadder)
   CP(m_bPlotDataBaseline)
   CP(m_bPlotDataXBPS)
@@ -346,9 +348,9 @@ bool CParmOsiris::IsEqual(const CParmOsiris &x) const
   CP(m_bPrintCurveLadderLabels)
   CP(m_bPrintCurveLadderBins)
   CP(m_bPrintCurveDisabledAlleles)
-  CP(m_bPrintCurveBaseline)
 
   if(!bRtn) {}
+  CP(m_bPrintCurveBaseline)
   CP(m_bPrintCurveILSvertical)
   CP(m_bPrintCurveMinRFU)
   CP(m_bPrintXaxisILSBPS)
@@ -368,9 +370,9 @@ bool CParmOsiris::IsEqual(const CParmOsiris &x) const
   CP(m_sPrintHeadingNotes)
   CP(m_nPrintChannelsSamples)
   CP(m_nPrintChannelsLadders)
-  CP(m_nPrintChannelsNegCtrl)
 
   if(!bRtn) {}
+  CP(m_nPrintChannelsNegCtrl)
   CP(m_bPrintChannelsOmitILS)
   CP(m_bPrintSamplesLadders)
   CP(m_bPrintSamplesPosCtrl)
@@ -393,9 +395,9 @@ bool CParmOsiris::IsEqual(const CParmOsiris &x) const
   CP(m_nPrintPlotPaperType)
   CP(m_nPrintPlotPaperWidth)
   CP(m_nPrintPlotPaperHeight)
-  CP(m_bPrintPlotLandscape)
 
   if(!bRtn) {}
+  CP(m_bPrintPlotLandscape)
   CP(m_nPrintPreviewZoom)
 
   //  XSLT saved parameter info
@@ -446,6 +448,7 @@ void CParmOsiris::RegisterAll(bool bInConstructor)
   RegisterInt("minRFUsampleDetection", &m_nSampleDetectionThreshold);
   RegisterWxString("AnalysisOverride", &m_sAnalysisOverride);
   RegisterInt("AnalysisSplitPos", &m_nAnalysisSplitPos);
+  RegisterInt("MaxConcurrentAnalyses", &m_nMaxConcurrentAnalyses);
   RegisterIntVector("ChannelRFU", &m_anChannelRFU);
   RegisterIntVector("ChannelDetection", &m_anChannelDetection);
   RegisterBool("TimeStampSubDir", &m_bTimeStampSubDir);
@@ -626,6 +629,7 @@ void CParmOsiris::SetDefaults()
   m_nSampleDetectionThreshold = -1;
   m_sAnalysisOverride.Empty();
   m_nAnalysisSplitPos = 0;
+  m_nMaxConcurrentAnalyses = 0;
   m_anChannelRFU.clear();
   m_anChannelRFU.push_back(-1);
   m_anChannelDetection.clear();
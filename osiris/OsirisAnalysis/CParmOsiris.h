@@ -175,6 +175,10 @@ public:
   {
     return m_nAnalysisSplitPos;
   }
+  int GetMaxConcurrentAnalyses() const
+  {
+    return m_nMaxConcurrentAnalyses;
+  }
   const vector<int> &GetChannelRFU() const
   {
     return m_anChannelRFU;
@@ -851,6 +855,10 @@ public:
   {
     __SET_VALUE(m_nAnalysisSplitPos, n);
   }
+  void SetMaxConcurrentAnalyses(int n)
+  {
+    __SET_VALUE(m_nMaxConcurrentAnalyses, n);
+  }
   void SetChannelRFU(const vector<int> &an)
   {
     __SET_VALUE(m_anChannelRFU, an);
@@ -1464,6 +1472,7 @@ protected:
   int m_nSampleDetectionThreshold;
   wxString m_sAnalysisOverride;
   int m_nAnalysisSplitPos;
+  int m_nMaxConcurrentAnalyses;
   vector<int> m_anChannelRFU;
   vector<int> m_anChannelDetection;
   bool m_bTimeStampSubDir;
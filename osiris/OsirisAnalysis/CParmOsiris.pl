@@ -75,6 +75,8 @@ my $VARLIST =
   ["m_nSampleDetectionThreshold", "int", "-1", "minRFUsampleDetection"],
   ["m_sAnalysisOverride","wxString"],
   ["m_nAnalysisSplitPos", "int"],
+  # analyses run at once in a batch, 0 - half the processors, at least one
+  ["m_nMaxConcurrentAnalyses", "int"],
   
   ##  this is awful - putting channel RFU and Detection in arrays
   
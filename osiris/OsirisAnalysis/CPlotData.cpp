@@ -50,11 +50,16 @@
 #include "COARfile.h"
 #include "nwx/stdb.h"
 #include <map>
+#include <memory>
 #include <math.h>
 #include "nwx/stde.h"
 #include "nwx/nsstd.h"
 #include "nwx/nwxLog.h"
 #include "OsirisMath/coordtrans.h"
+#include "OsirisMath/plotsidecar.h"
+#include <wx/file.h>
+#include <wx/mstream.h>
+#include <wx/thread.h>
 
 const wxString g_TagRawPoints();
 const wxString g_TagAnalyzedPoints();
@@ -382,6 +387,162 @@ bool CPlotData::LoadFromNode(wxXmlNode *pNode)
   return bRtn;
 }
 
+bool CPlotData::LoadFile(const wxString &sFileName)
+{
+  // if the sidecar cannot be used after all, or the file does
+  // not exist, load it as before
+  CPlotDataParsed parsed;
+  bool bRtn = ParseFile(sFileName,&parsed) && LoadParsed(&parsed);
+  if(!bRtn)
+  {
+    bRtn = nwxXmlPersist::LoadFile(sFileName);
+  }
+  return bRtn;
+}
+bool CPlotData::ParseFile(const wxString &sFileName, CPlotDataParsed *pParsed)
+{
+  // the trace arrays are most of a .plt file, if the analysis
+  // wrote them to a binary sidecar (.pltb), take them from there
+  // and parse only the rest of the XML
+  wxFileName fn(sFileName);
+  bool bRtn = fn.FileExists();
+  pParsed->m_sFileName = sFileName;
+  if(bRtn)
+  {
+    // before reading, so that a later change marks the data stale
+    pParsed->m_dtFileModTime = fn.GetModificationTime();
+    if(!_ParseWithSidecar(sFileName,pParsed))
+    {
+      pParsed->m_sidecar.Clear();
+      bRtn = pParsed->m_doc.Load(sFileName);
+    }
+  }
+  return bRtn;
+}
+bool CPlotData::LoadParsed(CPlotDataParsed *pParsed)
+{
+  bool bRtn = pParsed->m_doc.IsOk() &&
+    LoadFromNode(pParsed->m_doc.GetRoot()) &&
+    _SetSidecarArrays(&pParsed->m_sidecar);
+  if(bRtn)
+  {
+    _SetFileName(pParsed->m_sFileName);
+    m_dtFileModTime = pParsed->m_dtFileModTime;
+  }
+  else
+  {
+    Init();
+    _SetFileName(wxEmptyString);
+  }
+  return bRtn;
+}
+bool CPlotData::_ReadFile(const wxString &sFileName, std::string *ps)
+{
+  wxFile file;
+  bool bRtn = false;
+  if(wxFileName::FileExists(sFileName) && file.Open(sFileName))
+  {
+    wxFileOffset nLength = file.Length();
+    if(nLength > 0)
+    {
+      ps->resize((size_t)nLength);
+      bRtn = (file.Read(&(*ps)[0],(size_t)nLength) == (ssize_t)nLength);
+    }
+    file.Close();
+  }
+  return bRtn;
+}
+bool CPlotData::_ParseWithSidecar(
+  const wxString &sFileName, CPlotDataParsed *pParsed)
+{
+  std::string sPlt;
+  std::string sSidecar;
+  std::string sXml;
+  PlotSidecar &sidecar(pParsed->m_sidecar);
+  wxString sSidecarFile = wxString::FromUTF8(
+    PlotSidecar::SidecarFileName(std::string(sFileName.utf8_str())).c_str());
+  bool bRtn =
+    (sSidecarFile != sFileName) &&
+    _ReadFile(sSidecarFile,&sSidecar) &&
+    _ReadFile(sFileName,&sPlt) &&
+    sidecar.Decode(sSidecar.data(),sSidecar.size()) &&
+    sidecar.MatchesPltText(sPlt.data(),sPlt.size());
+  const vector<PlotSidecarArray *> &vArrays(sidecar.GetArrays());
+  vector<PlotSidecarArray *>::const_iterator itr;
+  if(bRtn)
+  {
+    // copy the .plt without the text of the arrays, which are
+    // in file order, leaving their elements empty
+    size_t nPos = 0;
+    sXml.reserve(sPlt.size() >> 2);
+    for(itr = vArrays.begin(); bRtn && (itr != vArrays.end()); ++itr)
+    {
+      if((*itr)->textOffset < nPos)
+      {
+        bRtn = false;
+      }
+      else
+      {
+        sXml.append(sPlt,nPos,(*itr)->textOffset - nPos);
+        nPos = (*itr)->textOffset + (*itr)->textLength;
+      }
+    }
+    sXml.append(sPlt,nPos,std::string::npos);
+  }
+  if(bRtn)
+  {
+    wxMemoryInputStream stream(sXml.data(),sXml.size());
+    bRtn = pParsed->m_doc.Load(stream);
+  }
+  return bRtn;
+}
+bool CPlotData::_SetSidecarArrays(PlotSidecar *pSidecar)
+{
+  // the arrays are moved, not copied, from the sidecar
+  const vector<PlotSidecarArray *> &vArrays(pSidecar->GetArrays());
+  vector<PlotSidecarArray *>::const_iterator itr;
+  CPlotChannel *pChan;
+  vector<int> *pv;
+  bool bRtn = true;
+  for(itr = vArrays.begin(); bRtn && (itr != vArrays.end()); ++itr)
+  {
+    pChan = ((*itr)->channel > 0) ? FindChannel((unsigned int)(*itr)->channel) : NULL;
+    pv = NULL;
+    if(pChan != NULL)
+    {
+      switch((*itr)->type)
+      {
+      case PlotSidecar::RawPoints:
+        pv = &pChan->m_vnRawPoints;
+        break;
+      case PlotSidecar::AnalyzedPoints:
+        pv = &pChan->m_vnAnalyzedPoints;
+        break;
+      case PlotSidecar::LadderPoints:
+        pv = &pChan->m_vnLadderPoints;
+        break;
+      case PlotSidecar::BaselinePoints:
+        pv = &pChan->m_vnBaselinePoints;
+        break;
+      }
+    }
+    if(pv == NULL)
+    {
+      bRtn = false;
+    }
+    else
+    {
+      pv->swap((*itr)->values);
+      pChan->m_nPointCount = 0;
+    }
+  }
+  if(!vArrays.empty())
+  {
+    m_nPointCount = 0;
+  }
+  return bRtn;
+}
+
 size_t CPlotData::GetPointCount()
 {
   if( (!m_nPointCount) && (m_nInterval > 0) &&
@@ -399,6 +560,26 @@ size_t CPlotData::GetPointCount()
   return m_nPointCount;
 }
 
+size_t CPlotData::GetMemoryEstimate()
+{
+  // the trace arrays as read and as converted to double
+  size_t nRtn = GetPointCount() * sizeof(double);
+  size_t nPoints;
+  CPlotChannel *pChan;
+  for(vector<CPlotChannel *>::iterator itr = m_vChannels.begin();
+    itr != m_vChannels.end();
+    ++itr)
+  {
+    pChan = *itr;
+    nPoints = pChan->m_vnRawPoints.size() +
+      pChan->m_vnAnalyzedPoints.size() +
+      pChan->m_vnLadderPoints.size() +
+      pChan->m_vnBaselinePoints.size();
+    nRtn += nPoints * (sizeof(int) + sizeof(double));
+  }
+  return nRtn;
+}
+
 bool CPlotData::HasBaseline()
 {
   bool bRtn = false;
@@ -730,3 +911,349 @@ wxString CPlotData::FindAnalysisFile() const
   return sRtn;
 }
 
+// CPlotDataPrefetch - worker thread for CPlotDataCache::Prefetch()
+//  reading and parsing plot files into CPlotDataParsed.  CPlotData
+//  has GUI objects, wxColour in its parameters, so it is made and
+//  deleted only on the UI thread.  The queue, the files wanted and
+//  the finished data are shared with the UI thread under m_mutex,
+//  which is never held while parsing.  The cache itself is used
+//  only by the UI thread, which takes finished data with TakeReady()
+
+class CPlotDataPrefetch : public wxThread
+{
+public:
+  CPlotDataPrefetch() :
+    wxThread(wxTHREAD_JOINABLE),
+    m_cond(m_mutex),
+    m_bStop(false)
+  {}
+  virtual ~CPlotDataPrefetch()
+  {
+    _CleanupReady();
+  }
+  void SetFiles(const vector<wxString> &vsFileNames);
+  void TakeReady(vector< pair<wxString,CPlotDataParsed *> > *pv);
+  void Stop();
+protected:
+  virtual ExitCode Entry();
+private:
+  bool _Next(wxString *psFileName);
+  void _Done(const wxString &sFileName, CPlotDataParsed *pParsed);
+  bool _IsWanted(const wxString &sFileName) const;
+  void _CleanupReady();
+
+  wxMutex m_mutex;
+  wxCondition m_cond;
+  list<wxString> m_listQueue;
+  vector<wxString> m_vsWanted;
+  vector< pair<wxString,CPlotDataParsed *> > m_vReady;
+  bool m_bStop;
+};
+
+void CPlotDataPrefetch::SetFiles(const vector<wxString> &vsFileNames)
+{
+  // replaces the files from the last call, finished data that is
+  // no longer wanted is deleted, and a file being parsed that is
+  // no longer wanted is deleted by _Done()
+  wxMutexLocker lock(m_mutex);
+  vector< pair<wxString,CPlotDataParsed *> > vReady;
+  vector< pair<wxString,CPlotDataParsed *> >::iterator itr;
+  m_vsWanted = vsFileNames;
+  m_listQueue.clear();
+  m_listQueue.insert(m_listQueue.end(),vsFileNames.begin(),vsFileNames.end());
+  for(itr = m_vReady.begin(); itr != m_vReady.end(); ++itr)
+  {
+    if(_IsWanted(itr->first))
+    {
+      vReady.push_back(*itr);
+    }
+    else
+    {
+      delete itr->second;
+    }
+  }
+  m_vReady.swap(vReady);
+  m_cond.Signal();
+}
+
+void CPlotDataPrefetch::TakeReady(vector< pair<wxString,CPlotDataParsed *> > *pv)
+{
+  wxMutexLocker lock(m_mutex);
+  pv->insert(pv->end(),m_vReady.begin(),m_vReady.end());
+  m_vReady.clear();
+}
+
+void CPlotDataPrefetch::Stop()
+{
+  {
+    wxMutexLocker lock(m_mutex);
+    m_bStop = true;
+    m_listQueue.clear();
+    m_cond.Signal();
+  }
+  Wait();
+}
+
+wxThread::ExitCode CPlotDataPrefetch::Entry()
+{
+  wxString sFileName;
+  while(_Next(&sFileName))
+  {
+    auto_ptr<CPlotDataParsed> pParsed(new CPlotDataParsed());
+    _Done(sFileName,
+      CPlotData::ParseFile(sFileName,pParsed.get()) ? pParsed.release() : NULL);
+  }
+  return (ExitCode)0;
+}
+
+bool CPlotDataPrefetch::_Next(wxString *psFileName)
+{
+  wxMutexLocker lock(m_mutex);
+  while(m_listQueue.empty() && !m_bStop)
+  {
+    m_cond.Wait();
+  }
+  if(!m_bStop)
+  {
+    *psFileName = m_listQueue.front();
+    m_listQueue.pop_front();
+  }
+  return !m_bStop;
+}
+
+void CPlotDataPrefetch::_Done(const wxString &sFileName, CPlotDataParsed *pParsed)
+{
+  if(pParsed != NULL)
+  {
+    wxMutexLocker lock(m_mutex);
+    if(m_bStop || !_IsWanted(sFileName))
+    {
+      delete pParsed;
+    }
+    else
+    {
+      m_vReady.push_back(pair<wxString,CPlotDataParsed *>(sFileName,pParsed));
+    }
+  }
+}
+
+bool CPlotDataPrefetch::_IsWanted(const wxString &sFileName) const
+{
+  vector<wxString>::const_iterator itr;
+  for(itr = m_vsWanted.begin();
+    (itr != m_vsWanted.end()) && (*itr != sFileName);
+    ++itr) {}
+  return (itr != m_vsWanted.end());
+}
+
+void CPlotDataPrefetch::_CleanupReady()
+{
+  vector< pair<wxString,CPlotDataParsed *> >::iterator itr;
+  for(itr = m_vReady.begin(); itr != m_vReady.end(); ++itr)
+  {
+    delete itr->second;
+  }
+  m_vReady.clear();
+}
+
+// CPlotDataCache
+
+list<CPlotDataCache::CEntry *> CPlotDataCache::g_listEntries;
+size_t CPlotDataCache::g_nMaxBytes = 128 * 1024 * 1024;
+CPlotDataPrefetch *CPlotDataCache::g_pPrefetch = NULL;
+
+list<CPlotDataCache::CEntry *>::iterator CPlotDataCache::_Find(
+  const wxString &sFileName)
+{
+  // entry for the file as it is now, entries for an older version
+  // of the file are marked stale
+  wxDateTime dtMod;
+  wxFileName fn(sFileName);
+  if(fn.FileExists())
+  {
+    dtMod = fn.GetModificationTime();
+  }
+  CEntry *pEntry;
+  list<CEntry *>::iterator itrRtn = g_listEntries.end();
+  list<CEntry *>::iterator itr;
+  for(itr = g_listEntries.begin();
+    (itrRtn == g_listEntries.end()) && (itr != g_listEntries.end());
+    ++itr)
+  {
+    pEntry = *itr;
+    if( pEntry->m_bStale ||
+        !nwxString::FileNameStringEqual(pEntry->m_sFileName,sFileName) )
+    {;}
+    else if( dtMod.IsValid() &&
+      (dtMod == pEntry->m_pData->GetFileModTime()) )
+    {
+      itrRtn = itr;
+    }
+    else
+    {
+      // the file was modified after it was loaded, windows
+      // using this data keep it until they release it
+      pEntry->m_bStale = true;
+    }
+  }
+  return itrRtn;
+}
+
+void CPlotDataCache::_AdoptPrefetched()
+{
+  // make plot data from files parsed by the prefetch thread and
+  // add it to the cache, unused, unless the file was loaded here
+  // in the meantime
+  if(g_pPrefetch != NULL)
+  {
+    vector< pair<wxString,CPlotDataParsed *> > vReady;
+    vector< pair<wxString,CPlotDataParsed *> >::iterator itr;
+    g_pPrefetch->TakeReady(&vReady);
+    for(itr = vReady.begin(); itr != vReady.end(); ++itr)
+    {
+      if(_Find(itr->first) == g_listEntries.end())
+      {
+        auto_ptr<CPlotData> pData(new CPlotData());
+        if(pData->LoadParsed(itr->second))
+        {
+          CEntry *pEntry = new CEntry(itr->first,pData.release());
+          pEntry->m_nRef = 0;
+          g_listEntries.push_front(pEntry);
+        }
+      }
+      delete itr->second;
+    }
+  }
+}
+
+CPlotData *CPlotDataCache::Acquire(const wxString &sFileName)
+{
+  CPlotData *pRtn = NULL;
+  CEntry *pEntry;
+  _AdoptPrefetched();
+  list<CEntry *>::iterator itr = _Find(sFileName);
+  if(itr != g_listEntries.end())
+  {
+    // move to the front, most recently used
+    pEntry = *itr;
+    pEntry->m_nRef++;
+    pRtn = pEntry->m_pData;
+    g_listEntries.erase(itr);
+    g_listEntries.push_front(pEntry);
+  }
+  else
+  {
+    // if the prefetch thread is parsing this file, parse
+    // it here too rather than wait for it
+    auto_ptr<CPlotData> pData(new CPlotData());
+    if(pData->LoadFile(sFileName))
+    {
+      pRtn = pData.release();
+      g_listEntries.push_front(new CEntry(sFileName,pRtn));
+    }
+  }
+  _Trim();
+  return pRtn;
+}
+
+void CPlotDataCache::Prefetch(const vector<wxString> &vsFileNames)
+{
+  vector<wxString> vsParse;
+  vector<wxString>::const_iterator itr;
+  _AdoptPrefetched();
+  vsParse.reserve(vsFileNames.size());
+  for(itr = vsFileNames.begin(); itr != vsFileNames.end(); ++itr)
+  {
+    if( (!itr->IsEmpty()) && (_Find(*itr) == g_listEntries.end()) )
+    {
+      vsParse.push_back(*itr);
+    }
+  }
+  if((g_pPrefetch == NULL) && !vsParse.empty())
+  {
+    g_pPrefetch = new CPlotDataPrefetch();
+    if(g_pPrefetch->Run() != wxTHREAD_NO_ERROR)
+    {
+      delete g_pPrefetch;
+      g_pPrefetch = NULL;
+      mainApp::LogMessage(wxT("Cannot start plot prefetch thread"));
+    }
+  }
+  if(g_pPrefetch != NULL)
+  {
+    // an empty list cancels the last one
+    g_pPrefetch->SetFiles(vsParse);
+  }
+  _Trim();
+}
+
+void CPlotDataCache::Release(CPlotData *pData)
+{
+  if(pData != NULL)
+  {
+    list<CEntry *>::iterator itr;
+    for(itr = g_listEntries.begin();
+      (itr != g_listEntries.end()) && ((*itr)->m_pData != pData);
+      ++itr) {}
+    if(itr == g_listEntries.end())
+    {
+      // not from Acquire()
+      delete pData;
+    }
+    else
+    {
+      (*itr)->m_nRef--;
+      _Trim();
+    }
+  }
+}
+
+void CPlotDataCache::_Trim()
+{
+  // remove unused data that is stale or least recently used
+  // until the total size of unused data is under the limit
+  size_t nUnused = 0;
+  CEntry *pEntry;
+  list<CEntry *>::iterator itr = g_listEntries.begin();
+  while(itr != g_listEntries.end())
+  {
+    pEntry = *itr;
+    if(pEntry->m_nRef > 0)
+    {
+      ++itr;
+    }
+    else if( pEntry->m_bStale ||
+      (nUnused + pEntry->m_nBytes > g_nMaxBytes) )
+    {
+      delete pEntry;
+      itr = g_listEntries.erase(itr);
+    }
+    else
+    {
+      nUnused += pEntry->m_nBytes;
+      ++itr;
+    }
+  }
+}
+
+void CPlotDataCache::StaticCleanup()
+{
+  if(g_pPrefetch != NULL)
+  {
+    g_pPrefetch->Stop();
+    delete g_pPrefetch;
+    g_pPrefetch = NULL;
+  }
+  // data still used by a window is left for the window to
+  // delete, Release() deletes data not found here
+  list<CEntry *>::iterator itr;
+  for(itr = g_listEntries.begin(); itr != g_listEntries.end(); ++itr)
+  {
+    if((*itr)->m_nRef > 0)
+    {
+      (*itr)->m_pData = NULL;
+    }
+    delete *itr;
+  }
+  g_listEntries.clear();
+}
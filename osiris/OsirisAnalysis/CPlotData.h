@@ -45,6 +45,10 @@
 #include "nwx/nwxRound.h"
 #include "CParmOsiris.h"
 #include "COARpeak.h"
+#include "OsirisMath/plotsidecar.h"
+#include "nwx/stdb.h"
+#include <list>
+#include "nwx/stde.h"
 
 #define FREEPTR(x) if((x) != NULL) { free(x); x = NULL;}
 
@@ -873,6 +877,25 @@ private:
   unsigned int m_nChannel;
 };
 
+class CPlotDataParsed
+{
+  // a plot file as read by CPlotData::ParseFile(), the XML and,
+  // if the file has a sidecar, its trace arrays.  It has no GUI
+  // objects, so it can be made on a worker thread and given to
+  // CPlotData::LoadParsed() on the UI thread
+public:
+  CPlotDataParsed() {}
+  ~CPlotDataParsed() {}
+  wxString m_sFileName;
+  wxDateTime m_dtFileModTime;
+  wxXmlDocument m_doc;
+  PlotSidecar m_sidecar;
+private:
+  // declared and not defined, the document is not copied
+  CPlotDataParsed(const CPlotDataParsed &);
+  CPlotDataParsed &operator =(const CPlotDataParsed &);
+};
+
 class CPlotData : public nwxXmlPersist
 {
 public:
@@ -922,6 +945,13 @@ public:
   }
 
   virtual bool LoadFromNode(wxXmlNode *pNode);
+  using nwxXmlPersist::LoadFile;
+  virtual bool LoadFile(const wxString &sFileName);
+
+  // LoadFile() in two steps, ParseFile() uses no GUI objects
+  // and may run on any thread, LoadParsed() runs on the UI thread
+  static bool ParseFile(const wxString &sFileName, CPlotDataParsed *pParsed);
+  bool LoadParsed(CPlotDataParsed *pParsed);
   size_t GetPointCount();
   bool HasBaseline();
   unsigned int GetChannelCount()
@@ -1130,6 +1160,7 @@ public:
   {
     return !CannotSetBPS();
   }
+  size_t GetMemoryEstimate();
 protected:
   virtual void RegisterAll(bool b = false);
 private:
@@ -1146,6 +1177,9 @@ private:
   static double _Interpolate(double dX, const double *pdXlist, const double *pdYlist, size_t nCount);
   void _FixBaseline();
   void _Cleanup();
+  static bool _ParseWithSidecar(const wxString &sFileName, CPlotDataParsed *pParsed);
+  bool _SetSidecarArrays(PlotSidecar *pSidecar);
+  static bool _ReadFile(const wxString &sFileName, std::string *ps);
   CPlotChannel *FindChannel(unsigned int n);
   CParmOsirisLite m_parm;
   wxString m_sVersion;
@@ -1174,4 +1208,64 @@ private:
 };
 
 
+class CPlotDataPrefetch;
+
+class CPlotDataCache
+{
+  // parsed plot files shared by all plot windows and previews,
+  // keyed by file name and modification time.  Data from Acquire()
+  // is given back with Release() instead of being deleted.  Data
+  // that is no longer used is kept, most recently used first,
+  // until its total size is over GetMaxBytes()
+
+public:
+  static CPlotData *Acquire(const wxString &sFileName);
+  static void Release(CPlotData *pData);
+
+  // read and parse these files, in order, on a background thread,
+  // so that Acquire() finds them in the cache.  The plot data is
+  // made from them on the UI thread, by the next Acquire() or
+  // Prefetch().  Files from an earlier call that have not been
+  // parsed are dropped.  Acquire() never waits for the thread
+  static void Prefetch(const vector<wxString> &vsFileNames);
+  static size_t GetMaxBytes()
+  {
+    return g_nMaxBytes;
+  }
+  static void SetMaxBytes(size_t n)
+  {
+    g_nMaxBytes = n;
+    _Trim();
+  }
+  static void StaticCleanup();
+private:
+  class CEntry
+  {
+  public:
+    CEntry(const wxString &sFileName, CPlotData *pData) :
+      m_sFileName(sFileName),
+      m_pData(pData),
+      m_nBytes(pData->GetMemoryEstimate()),
+      m_nRef(1),
+      m_bStale(false)
+    {}
+    ~CEntry()
+    {
+      delete m_pData;
+    }
+    wxString m_sFileName;
+    CPlotData *m_pData;
+    size_t m_nBytes;
+    int m_nRef;
+    bool m_bStale; // file was modified, not returned by Acquire()
+  };
+  static list<CEntry *>::iterator _Find(const wxString &sFileName);
+  static void _AdoptPrefetched();
+  static void _Trim();
+  static list<CEntry *> g_listEntries;
+  static size_t g_nMaxBytes;
+  static CPlotDataPrefetch *g_pPrefetch;
+};
+
+
 #endif
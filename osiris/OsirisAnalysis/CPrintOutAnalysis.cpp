@@ -261,16 +261,17 @@ bool CPrintOutAnalysis::_OnPrintPage(int page)
   const CPrintPage &printPage(GetPages().at(page - 1));
   const COARsample *pSample(printPage.pSample);
   const wxString sPlotFile = pSample->GetPlotFileName();
-  CPlotData plotData;
+  CPlotData *pPlotData =
+    sPlotFile.IsEmpty() ? NULL : CPlotDataCache::Acquire(sPlotFile);
   wxBitmap *pBitmap(NULL);
   wxDC *pdc = GetDC();
   _setupPageBitmap(pdc);
-  if( (!sPlotFile.IsEmpty()) && plotData.LoadFile(sPlotFile) )
+  if(pPlotData != NULL)
   {
     _IncrementPageCount();
     CPanelPlot *panel = new CPanelPlot(
       m_pFrameAnalysis,
-      &plotData, m_pFile);
+      pPlotData, m_pFile);
     CWindowPointer pw(panel);
     panel->Show(false);
     panel->SetRenderingToWindow(false);
@@ -288,6 +289,7 @@ bool CPrintOutAnalysis::_OnPrintPage(int page)
     // could not open plt file, show a message
     pBitmap = _GetErrorBitmap(pSample);
   }
+  CPlotDataCache::Release(pPlotData);
   std::unique_ptr<wxBitmap> px(pBitmap);
   wxRect r = GetLogicalPageMarginsRect(*GetPageSetupData());
   pdc->DestroyClippingRegion();
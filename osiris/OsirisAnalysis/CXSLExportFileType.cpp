@@ -36,6 +36,7 @@
 #include <wx/filefn.h>
 #include <wx/arrstr.h>
 #include <wx/string.h>
+#include <wx/thread.h>
 
 #define COPY(z)  z = x.z
 #define NOTEQ(z) (z != x.z)
@@ -560,113 +561,315 @@ bool CXSLExportFileType::UpdateExePath()
   return bRtn;
 }
 
-bool CXSLExportFileType::AutoTransform(const wxString &sInputFileName)
+bool CXSLExportFileType::_AutoOutputFile(
+  const wxFileName &fn,
+  set<wxString> *psetUsed,
+  wxString *psOutFileName,
+  wxString *psError)
 {
-  wxString sAutoError;
+  // name of the next automatic export file, psetUsed holds
+  // the names already taken by other exports of the same input
+  wxString sLocation;
   bool bRtn = false;
-  if(!HasAutoTransform())
+  if(m_auto.IsAnalysisLocation())
+  {
+    sLocation = fn.GetPath();
+  }
+  else
+  {
+    sLocation = m_auto.GetLocation();
+  }
+  if(sLocation.IsEmpty()) 
   {
-    sAutoError = "Automatic export is not specified";
+    *psError = "Location for automatic export is not specified.";
   }
-  else if(!XSLfileOK())
+  else if(!wxFileName::IsDirWritable(sLocation))
   {
-    sAutoError = "Cannot export ";
-    sAutoError.Append(m_sName);
-    sAutoError.Append(
-      ".  Stylesheet is either invalid or not found");
+    *psError = "Cannot export file to location, ";
+    psError->Append(sLocation);
+    psError->Append(", permission denied");
   }
   else
   {
-    wxFileName fn(sInputFileName);
-    wxString sLocation;
-    wxXml2Document doc;
-    if(!fn.IsFileReadable()) 
+    // figure out file extension
+    const wxString &sExtTmp(m_auto.GetFileExt());
+    wxString sExt;
+    if(!sExtTmp.IsEmpty())
     {
-       // we are done
-      sAutoError = "Cannot read input file, ";
-      sAutoError.Append(sInputFileName);
+      sExt = ".";
+      sExt.Append(sExtTmp);
     }
-    else if(!doc.Load(sInputFileName))
+
+    nwxFileUtil::EndWithSeparator(&sLocation);
+    if(m_auto.IsAnalysisFileName())
     {
-      sAutoError = "Cannot export file.  Input file, ";
-      sAutoError.Append(sInputFileName);
-      sAutoError.Append(", is not valid");
+      sLocation.Append(fn.GetName());
     }
-    else if(m_auto.IsAnalysisLocation())
+    else
     {
-      sLocation = fn.GetPath();
+      sLocation.Append(m_auto.GetFileName());
     }
-    else
+    if(m_auto.GetAppendDateToFileName())
+    {
+      wxDateTime dt;
+      dt.SetToCurrent();
+      sLocation.Append(dt.Format("-%Y%m%d-%H%M%S"));
+    }
+    bool bDone = false;
+    wxString sOutFileName;
+    int i = 0;
+    while(!bDone)
     {
-      sLocation = m_auto.GetLocation();
+      sOutFileName = sLocation;
+      if(i)
+      {
+        sOutFileName.Append(wxString::Format("_%d",i));
+      }
+      sOutFileName.Append(sExt);
+      bDone = !wxFileName::FileExists(sOutFileName) &&
+        (psetUsed->find(sOutFileName) == psetUsed->end());
+      i++;
     }
-    if(sLocation.IsEmpty()) 
+    psetUsed->insert(sOutFileName);
+    *psOutFileName = sOutFileName;
+    bRtn = true;
+  }
+  return bRtn;
+}
+
+//*********************************************** automatic export
+
+class CXSLAutoJobs
+{
+  // the transforms of one input file, shared
+  // by the threads in CXSLExportFileType::AutoTransform
+public:
+  class CJob
+  {
+  public:
+    CJob() : m_pXSL(NULL), m_bOK(false) {}
+    CXSLExportFileType *m_pXSL;
+    wxString m_sOutFileName;
+    vector<wxString> m_asErrors;
+    bool m_bOK;
+  };
+  CXSLAutoJobs(wxXml2Document *pDoc, size_t nCount) :
+    m_pDoc(pDoc),
+    m_nNext(0)
+  {
+    // pointers returned by Add() stay valid for up to nCount jobs
+    m_vJobs.reserve(nCount);
+  }
+  CJob *Add(CXSLExportFileType *pXSL, const wxString &sOutFileName)
+  {
+    m_vJobs.push_back(CJob());
+    CJob *pRtn = &m_vJobs.back();
+    pRtn->m_pXSL = pXSL;
+    pRtn->m_sOutFileName = sOutFileName;
+    return pRtn;
+  }
+  size_t GetCount() const
+  {
+    return m_vJobs.size();
+  }
+  void Run()
+  {
+    // called from each thread until no jobs are left
+    CJob *pJob;
+    while((pJob = _Next()) != NULL)
+    {
+      pJob->m_bOK = pJob->m_pXSL->TransformToFileShared(
+        m_pDoc, pJob->m_sOutFileName, &pJob->m_asErrors);
+    }
+  }
+private:
+  CJob *_Next()
+  {
+    wxMutexLocker lock(m_mutex);
+    CJob *pRtn = NULL;
+    if(m_nNext < m_vJobs.size())
+    {
+      pRtn = &m_vJobs.at(m_nNext);
+      m_nNext++;
+    }
+    return pRtn;
+  }
+  wxMutex m_mutex;
+  vector<CJob> m_vJobs;
+  wxXml2Document *m_pDoc;
+  size_t m_nNext;
+};
+
+class CXSLAutoThread : public wxThread
+{
+public:
+  CXSLAutoThread(CXSLAutoJobs *pJobs) :
+    wxThread(wxTHREAD_JOINABLE),
+    m_pJobs(pJobs)
+  {}
+  virtual ~CXSLAutoThread() {}
+protected:
+  virtual ExitCode Entry()
+  {
+    m_pJobs->Run();
+    return (ExitCode) 0;
+  }
+private:
+  CXSLAutoJobs *m_pJobs;
+};
+
+bool CXSLExportFileType::AutoTransform(const wxString &sInputFileName)
+{
+  vector<CXSLExportFileType *> vXSL;
+  vXSL.push_back(this);
+  return AutoTransform(vXSL,sInputFileName);
+}
+
+bool CXSLExportFileType::AutoTransform(
+  const vector<CXSLExportFileType *> &vXSL,
+  const wxString &sInputFileName)
+{
+  // The input file is parsed once and shared, read only, by every
+  // export, each transform working on its own copy.  Output file
+  // names are chosen here, in order, and the transforms run
+  // concurrently.  Errors are sent to the receivers afterward, in
+  // the order of vXSL, so that each export's messages stay
+  // together.  Returns false if any export failed.
+
+  size_t nCount = vXSL.size();
+  vector<wxString> asAutoError(nCount);
+  vector<CXSLAutoJobs::CJob *> vpJob(nCount,(CXSLAutoJobs::CJob *)NULL);
+  set<wxString> setUsed;
+  wxFileName fn(sInputFileName);
+  wxXml2Document doc;
+  CXSLAutoJobs jobs(&doc,nCount);
+  CXSLExportFileType *pXSL;
+  wxString sOutFileName;
+  int nLoaded = -1; // not attempted yet
+  bool bRtn = true;
+  size_t i;
+
+  for(i = 0; i < nCount; i++)
+  {
+    wxString &sAutoError(asAutoError.at(i));
+    pXSL = vXSL.at(i);
+    if(!pXSL->HasAutoTransform())
     {
-      sAutoError = "Location for automatic export is not specified.";
+      sAutoError = "Automatic export is not specified";
     }
-    else if(!wxFileName::IsDirWritable(sLocation))
+    else if(!pXSL->XSLfileOK())
     {
-      sAutoError = "Cannot export file to location, ";
-      sAutoError.Append(sLocation);
-      sAutoError.Append(", permission denied");
+      sAutoError = "Cannot export ";
+      sAutoError.Append(pXSL->m_sName);
+      sAutoError.Append(
+        ".  Stylesheet is either invalid or not found");
     }
     else
     {
-      // figure out file extension
-      const wxString &sExtTmp(m_auto.GetFileExt());
-      wxString sExt;
-      if(!sExtTmp.IsEmpty())
+      if(nLoaded < 0)
       {
-        sExt = ".";
-        sExt.Append(sExtTmp);
+        nLoaded = 0;
+        if(fn.IsFileReadable() && doc.Load(sInputFileName))
+        {
+          nLoaded = 1;
+        }
       }
-
-      nwxFileUtil::EndWithSeparator(&sLocation);
-      if(m_auto.IsAnalysisFileName())
+      if(nLoaded)
       {
-        sLocation.Append(fn.GetName());
+        if(pXSL->_AutoOutputFile(fn,&setUsed,&sOutFileName,&sAutoError))
+        {
+          vpJob.at(i) = jobs.Add(pXSL,sOutFileName);
+        }
+      }
+      else if(!fn.IsFileReadable()) 
+      {
+        sAutoError = "Cannot read input file, ";
+        sAutoError.Append(sInputFileName);
       }
       else
       {
-        sLocation.Append(m_auto.GetFileName());
+        sAutoError = "Cannot export file.  Input file, ";
+        sAutoError.Append(sInputFileName);
+        sAutoError.Append(", is not valid");
       }
-      if(m_auto.GetAppendDateToFileName())
+    }
+  }
+
+  // run the transforms, this thread runs them too,
+  // and runs all of them if no other thread can be started
+
+  size_t nJobs = jobs.GetCount();
+  if(nJobs)
+  {
+    int nCPU = wxThread::GetCPUCount();
+    size_t nThreads = (nCPU > 1) ? (size_t) nCPU : 1;
+    vector<CXSLAutoThread *> vpThread;
+    vector<CXSLAutoThread *>::iterator itrThread;
+    if(nThreads > nJobs)
+    {
+      nThreads = nJobs;
+    }
+    vpThread.reserve(nThreads);
+    for(i = 1; i < nThreads; i++)
+    {
+      CXSLAutoThread *pThread = new CXSLAutoThread(&jobs);
+      if( (pThread->Create() == wxTHREAD_NO_ERROR) &&
+        (pThread->Run() == wxTHREAD_NO_ERROR) )
       {
-        wxDateTime dt;
-        dt.SetToCurrent();
-        sLocation.Append(dt.Format("-%Y%m%d-%H%M%S"));
+        vpThread.push_back(pThread);
       }
-      bool bDone = false;
-      wxString sOutFileName;
-      int i = 0;
-      while(!bDone)
+      else
       {
-        sOutFileName = sLocation;
-        if(i)
-        {
-          sOutFileName.Append(wxString::Format("_%d",i));
-        }
-        sOutFileName.Append(sExt);
-        bDone = !wxFileName::FileExists(sOutFileName);
-        i++;
+        delete pThread;
       }
-      bRtn = TransformToFile(&doc,sOutFileName);
-      if(!bRtn)
+    }
+    jobs.Run();
+    for(itrThread = vpThread.begin();
+      itrThread != vpThread.end();
+      ++itrThread)
+    {
+      (*itrThread)->Wait();
+      delete (*itrThread);
+    }
+  }
+
+  // report
+
+  for(i = 0; i < nCount; i++)
+  {
+    wxString &sAutoError(asAutoError.at(i));
+    CXSLAutoJobs::CJob *pJob = vpJob.at(i);
+    bool bOK = false;
+    if(pJob != NULL)
+    {
+      vector<wxString>::iterator itr;
+      pJob->m_pXSL->m_Sheet.ClearParms();
+      for(itr = pJob->m_asErrors.begin();
+        itr != pJob->m_asErrors.end();
+        ++itr)
+      {
+        wxXml2Object::SendError(*itr);
+      }
+      if(!pJob->m_bOK)
       {
         sAutoError = 
           "An error occurred when attempting to export ";
-        sAutoError.Append(m_sName);
+        sAutoError.Append(pJob->m_pXSL->m_sName);
       }
       else
       {
-        sAutoError = CheckOutputFile(sOutFileName);
-        bRtn = sAutoError.IsEmpty();
+        sAutoError = CheckOutputFile(pJob->m_sOutFileName);
+        bOK = sAutoError.IsEmpty();
       }
     }
-  }
-  if(!sAutoError.IsEmpty())
-  {
-    wxXml2Object::SendError(sAutoError);
+    if(!sAutoError.IsEmpty())
+    {
+      wxXml2Object::SendError(sAutoError);
+    }
+    if(!bOK)
+    {
+      bRtn = false;
+    }
   }
   return bRtn;
 }
@@ -750,6 +750,9 @@ public:
     return m_auto.IsActive();
   }
   bool AutoTransform(const wxString &sFileName);
+  static bool AutoTransform(
+    const vector<CXSLExportFileType *> &vXSL,
+    const wxString &sFileName);
 
   bool TransformToFile(
     wxXml2Document *pDoc,
@@ -774,6 +777,15 @@ public:
     const wxString &sInFile,
     const wxString &sOutFile,
     const map<wxString,wxString> *pMapParams);
+  bool TransformToFileShared(
+    wxXml2Document *pDoc,
+    const wxString &sFileName,
+    vector<wxString> *pasErrors)
+  {
+    // may run on a worker thread, XSLfileOK() must be
+    // checked and parameters set beforehand
+    return m_Sheet.TransformToFileShared(sFileName,pDoc,pasErrors);
+  }
 
   virtual const wxString &RootNode(void) const
   {
@@ -1004,6 +1016,11 @@ private:
   static const wxChar * const INFILE;
   static const wxChar * const OUTFILE;
   void _SetupSheet();
+  bool _AutoOutputFile(
+    const wxFileName &fnInput,
+    set<wxString> *psetUsed,
+    wxString *psOutFileName,
+    wxString *psError);
   void _SetupSheetParams(const map<wxString,wxString> *pMapParam);
   void _SetupSheetParams(const map<wxString,wxString> *pMapParam,
     const wxString &sInputFileName,
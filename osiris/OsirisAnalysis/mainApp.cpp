@@ -75,6 +75,7 @@
 #include "CArtifactLabels.h"
 #include "Version/OsirisVersion.h"
 #include "CPrintOutPlot.h"
+#include "CPlotData.h"
 
 #ifdef __WXMSW__
 #include <process.h>
@@ -171,6 +172,7 @@ void mainApp::_Cleanup()
       m_pTimer = NULL;
     }
     CPrintOutPlot::StaticCleanup();
+    CPlotDataCache::StaticCleanup();
     _cleanupPinger();
   }
 }
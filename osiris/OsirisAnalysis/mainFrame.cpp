@@ -477,10 +477,9 @@ CFramePlot *mainFrame::OpenGraphicFile(
   const wxString &sLocus,
   COARfile *pFile)
 {
-  auto_ptr<CPlotData> pData(new CPlotData());
-  pData->LoadFile(sFileName);
+  CPlotData *pData = CPlotDataCache::Acquire(sFileName);
   CFramePlot *pPlot(NULL);
-  if(pData->GetChannelCount())
+  if((pData != NULL) && pData->GetChannelCount())
   {
     wxSize sz = GetChildSize();
     bool bShiftKeyDown = nwxKeyState::Shift();
@@ -491,7 +490,7 @@ CFramePlot *mainFrame::OpenGraphicFile(
       // from the plot file so the .oar/.oer is searched
       nChannel = pFile->GetChannelNrFromLocus(sLocus);
     }
-    pPlot = new CFramePlot(this,sz,pData.release(),pFile,mainApp::GetKitColors(),bShiftKeyDown,nChannel);
+    pPlot = new CFramePlot(this,sz,pData,pFile,mainApp::GetKitColors(),bShiftKeyDown,nChannel);
     // call ZoomOut or ZoomToLocus AFTER Show as a workaround for a bug in wxPlotCtrl
     // otherwise we would put it in the CFramePlot constructor
     if((nChannel > 0) && !sLocus.IsEmpty())
@@ -513,6 +512,7 @@ CFramePlot *mainFrame::OpenGraphicFile(
   }
   else
   {
+    CPlotDataCache::Release(pData);
     wxString sMsg(sFileName);
     sMsg.Append(" is not a valid graphic file.");
     ErrorMessage(sMsg);
@@ -0,0 +1,621 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: CompareAnalysisOutput.cpp
+*
+*/
+//
+//  CompareAnalysisOutput compares two analysis output files (.oar or .plt) semantically, for regression testing against
+//  stored goldens.  Both files are read as streams of XML elements and text, in step, so memory use does not depend on file
+//  size.  Layout whitespace is ignored, text is compared token by token, and tokens that are numbers on both sides are equal
+//  when they agree within an absolute or relative tolerance.  Elements named in the ignore list (by default CreationTime)
+//  are skipped with their contents.  A difference in structure ends the comparison; differences in values are listed.
+//
+//  Usage:  CompareAnalysisOutput [-rtol x] [-atol x] [-ignore name,name,...] [-max n] <golden file> <new file>
+//  Exit status:  0 if equivalent, 1 if different, 2 if a file could not be read
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+using namespace std;
+
+
+class XMLEventReader {
+
+public:
+	enum EventType { StartElement, EndElement, Text, EndOfFile };
+
+	XMLEventReader (const char* fileName);
+	~XMLEventReader ();
+
+	bool IsValid () const { return mFile != NULL; }
+	int Next ();
+
+	const string& GetName () const { return mName; }
+	const string& GetValue () const { return mValue; }
+	int GetLine () const { return mEventLine; }
+
+protected:
+	FILE* mFile;
+	int mLine;
+	int mEventLine;
+	int mPending;
+	bool mPendingEnd;
+	string mName;
+	string mValue;
+
+	int Get ();
+	void SkipPast (const char* terminator);
+	void ReadUntil (const char* terminator, string& text);
+	static void Normalize (string& text);
+};
+
+
+XMLEventReader :: XMLEventReader (const char* fileName) : mLine (1), mEventLine (1), mPending (EOF), mPendingEnd (false) {
+
+	mFile = fopen (fileName, "rb");
+}
+
+
+XMLEventReader :: ~XMLEventReader () {
+
+	if (mFile != NULL)
+		fclose (mFile);
+}
+
+
+int XMLEventReader :: Get () {
+
+	int c;
+
+	if (mPending != EOF) {
+
+		c = mPending;
+		mPending = EOF;
+		return c;
+	}
+
+	c = getc (mFile);
+
+	if (c == '\n')
+		mLine++;
+
+	return c;
+}
+
+
+void XMLEventReader :: SkipPast (const char* terminator) {
+
+	string ignored;
+	ReadUntil (terminator, ignored);
+}
+
+
+void XMLEventReader :: ReadUntil (const char* terminator, string& text) {
+
+	// Reads up to and including terminator; text receives everything before it
+
+	size_t n = strlen (terminator);
+	int c;
+	text.clear ();
+
+	while ((c = Get ()) != EOF) {
+
+		text += (char)c;
+
+		if ((text.length () >= n) && (text.compare (text.length () - n, n, terminator) == 0)) {
+
+			text.erase (text.length () - n);
+			return;
+		}
+	}
+}
+
+
+void XMLEventReader :: Normalize (string& text) {
+
+	// Collapse runs of whitespace to single blanks and trim both ends
+
+	string result;
+	size_t i;
+	bool space = false;
+
+	for (i=0; i<text.length (); i++) {
+
+		if (isspace ((unsigned char)text [i]))
+			space = true;
+
+		else {
+
+			if (space && !result.empty ())
+				result += ' ';
+
+			space = false;
+			result += text [i];
+		}
+	}
+
+	text = result;
+}
+
+
+int XMLEventReader :: Next () {
+
+	int c;
+	string tag;
+
+	if (mPendingEnd) {
+
+		mPendingEnd = false;
+		mValue.clear ();
+		return EndElement;
+	}
+
+	while (true) {
+
+		mEventLine = mLine;
+		mValue.clear ();
+
+		while (((c = Get ()) != EOF) && (c != '<'))
+			mValue += (char)c;
+
+		Normalize (mValue);
+
+		if (!mValue.empty ()) {
+
+			if (c == '<')
+				mPending = c;
+
+			return Text;
+		}
+
+		if (c == EOF)
+			return EndOfFile;
+
+		mEventLine = mLine;
+		c = Get ();
+
+		if (c == '?') {
+
+			SkipPast ("?>");
+			continue;
+		}
+
+		if (c == '!') {
+
+			// Comments and declarations are skipped; CDATA sections are text
+
+			tag.clear ();
+
+			while ((tag.length () < 7) && ((c = Get ()) != EOF) && (c != '>')) {
+
+				tag += (char)c;
+
+				if ((tag == "--") || (tag == "[CDATA["))
+					break;
+			}
+
+			if (tag == "--")
+				SkipPast ("-->");
+
+			else if (tag == "[CDATA[") {
+
+				ReadUntil ("]]>", mValue);
+				Normalize (mValue);
+
+				if (!mValue.empty ())
+					return Text;
+			}
+
+			else if (c != '>')
+				SkipPast (">");
+
+			continue;
+		}
+
+		if (c == '/') {
+
+			ReadUntil (">", mName);
+			Normalize (mName);
+			return EndElement;
+		}
+
+		tag = (char)c;
+		bool inQuote = false;
+		char quote = 0;
+
+		while ((c = Get ()) != EOF) {
+
+			if (inQuote) {
+
+				if (c == quote)
+					inQuote = false;
+			}
+
+			else if ((c == '"') || (c == '\'')) {
+
+				inQuote = true;
+				quote = (char)c;
+			}
+
+			else if (c == '>')
+				break;
+
+			tag += (char)c;
+		}
+
+		Normalize (tag);
+
+		if (!tag.empty () && (tag [tag.length () - 1] == '/')) {
+
+			tag.erase (tag.length () - 1);
+			mPendingEnd = true;
+		}
+
+		// The element name is followed by its attributes, which are compared as text
+
+		size_t split = tag.find (' ');
+
+		if (split == string::npos) {
+
+			mName = tag;
+			mValue.clear ();
+		}
+
+		else {
+
+			mName = tag.substr (0, split);
+			mValue = tag.substr (split + 1);
+			Normalize (mValue);
+		}
+
+		return StartElement;
+	}
+}
+
+
+class OutputComparison {
+
+public:
+	OutputComparison (double relativeTolerance, double absoluteTolerance, int maxReported) : mRelativeTolerance (relativeTolerance),
+		mAbsoluteTolerance (absoluteTolerance), mMaxReported (maxReported), mDifferences (0), mNumbersCompared (0),
+		mMaxRelativeDifference (0.0), mMaxAbsoluteDifference (0.0) {}
+
+	void Ignore (const string& name) { mIgnored.insert (name); }
+	int Compare (const char* goldenFile, const char* newFile);
+
+	int GetDifferences () const { return mDifferences; }
+	long GetNumbersCompared () const { return mNumbersCompared; }
+	double GetMaxRelativeDifference () const { return mMaxRelativeDifference; }
+	double GetMaxAbsoluteDifference () const { return mMaxAbsoluteDifference; }
+
+protected:
+	double mRelativeTolerance;
+	double mAbsoluteTolerance;
+	int mMaxReported;
+	int mDifferences;
+	long mNumbersCompared;
+	double mMaxRelativeDifference;
+	double mMaxAbsoluteDifference;
+	set<string> mIgnored;
+	vector<string> mPath;
+
+	bool ValuesMatch (const string& golden, const string& current);
+	static bool IsNumber (const string& token, double& value);
+	static void Split (const string& text, vector<string>& tokens);
+	void Report (const XMLEventReader& golden, const XMLEventReader& current, const char* what, const string& goldenValue, const string& currentValue);
+	static bool SkipElement (XMLEventReader& reader);
+	string GetPath () const;
+};
+
+
+bool OutputComparison :: IsNumber (const string& token, double& value) {
+
+	const char* p = token.c_str ();
+	char* end;
+
+	if (token.empty ())
+		return false;
+
+	value = strtod (p, &end);
+	return (*end == '\0') && (end != p);
+}
+
+
+void OutputComparison :: Split (const string& text, vector<string>& tokens) {
+
+	size_t start = 0;
+	size_t blank;
+	tokens.clear ();
+
+	while (start < text.length ()) {
+
+		blank = text.find (' ', start);
+
+		if (blank == string::npos)
+			blank = text.length ();
+
+		tokens.push_back (text.substr (start, blank - start));
+		start = blank + 1;
+	}
+}
+
+
+bool OutputComparison :: ValuesMatch (const string& golden, const string& current) {
+
+	if (golden == current)
+		return true;
+
+	vector<string> goldenTokens;
+	vector<string> currentTokens;
+	Split (golden, goldenTokens);
+	Split (current, currentTokens);
+
+	if (goldenTokens.size () != currentTokens.size ())
+		return false;
+
+	size_t i;
+	double a;
+	double b;
+	double difference;
+	double scale;
+	bool match = true;
+
+	for (i=0; i<goldenTokens.size (); i++) {
+
+		if (goldenTokens [i] == currentTokens [i])
+			continue;
+
+		if (!IsNumber (goldenTokens [i], a) || !IsNumber (currentTokens [i], b)) {
+
+			match = false;
+			continue;
+		}
+
+		mNumbersCompared++;
+		difference = fabs (a - b);
+		scale = (fabs (a) > fabs (b)) ? fabs (a) : fabs (b);
+
+		if (difference > mMaxAbsoluteDifference)
+			mMaxAbsoluteDifference = difference;
+
+		if ((scale > 0.0) && (difference / scale > mMaxRelativeDifference))
+			mMaxRelativeDifference = difference / scale;
+
+		if (difference > mAbsoluteTolerance + mRelativeTolerance * scale)
+			match = false;
+	}
+
+	return match;
+}
+
+
+string OutputComparison :: GetPath () const {
+
+	string path;
+	size_t i;
+
+	for (i=0; i<mPath.size (); i++)
+		path += "/" + mPath [i];
+
+	return path;
+}
+
+
+void OutputComparison :: Report (const XMLEventReader& golden, const XMLEventReader& current, const char* what, const string& goldenValue, const string& currentValue) {
+
+	mDifferences++;
+
+	if (mDifferences > mMaxReported)
+		return;
+
+	cout << "  line " << golden.GetLine () << " / " << current.GetLine () << "  " << GetPath () << ":  " << what << endl;
+	cout << "    golden:  " << goldenValue.substr (0, 200) << endl;
+	cout << "    new:     " << currentValue.substr (0, 200) << endl;
+}
+
+
+bool OutputComparison :: SkipElement (XMLEventReader& reader) {
+
+	// Called just after a start element; consumes through the matching end element
+
+	int depth = 1;
+	int event;
+
+	while (depth > 0) {
+
+		event = reader.Next ();
+
+		if (event == XMLEventReader::EndOfFile)
+			return false;
+
+		if (event == XMLEventReader::StartElement)
+			depth++;
+
+		else if (event == XMLEventReader::EndElement)
+			depth--;
+	}
+
+	return true;
+}
+
+
+int OutputComparison :: Compare (const char* goldenFile, const char* newFile) {
+
+	XMLEventReader golden (goldenFile);
+	XMLEventReader current (newFile);
+	int goldenEvent;
+	int currentEvent;
+	static const char* eventNames [] = { "element", "end of element", "text", "end of file" };
+
+	if (!golden.IsValid ()) {
+
+		cout << "Could not open " << goldenFile << endl;
+		return 2;
+	}
+
+	if (!current.IsValid ()) {
+
+		cout << "Could not open " << newFile << endl;
+		return 2;
+	}
+
+	while (true) {
+
+		goldenEvent = golden.Next ();
+		currentEvent = current.Next ();
+
+		if (goldenEvent != currentEvent) {
+
+			Report (golden, current, "structure differs", string (eventNames [goldenEvent]) + " " + golden.GetName () + golden.GetValue (),
+				string (eventNames [currentEvent]) + " " + current.GetName () + current.GetValue ());
+			return 1;
+		}
+
+		if (goldenEvent == XMLEventReader::EndOfFile)
+			break;
+
+		if (goldenEvent == XMLEventReader::Text) {
+
+			if (!ValuesMatch (golden.GetValue (), current.GetValue ()))
+				Report (golden, current, "value differs", golden.GetValue (), current.GetValue ());
+
+			continue;
+		}
+
+		if (golden.GetName () != current.GetName ()) {
+
+			Report (golden, current, "element differs", golden.GetName (), current.GetName ());
+			return 1;
+		}
+
+		if (goldenEvent == XMLEventReader::EndElement) {
+
+			if (!mPath.empty ())
+				mPath.pop_back ();
+
+			continue;
+		}
+
+		if (mIgnored.count (golden.GetName ()) > 0) {
+
+			if (!SkipElement (golden) || !SkipElement (current)) {
+
+				Report (golden, current, "unterminated element", golden.GetName (), current.GetName ());
+				return 1;
+			}
+
+			continue;
+		}
+
+		mPath.push_back (golden.GetName ());
+
+		if (!ValuesMatch (golden.GetValue (), current.GetValue ()))
+			Report (golden, current, "attributes differ", golden.GetValue (), current.GetValue ());
+	}
+
+	return (mDifferences > 0) ? 1 : 0;
+}
+
+
+static void Usage (const char* program) {
+
+	cout << "Usage:  " << program << " [-rtol x] [-atol x] [-ignore name,name,...] [-max n] <golden file> <new file>" << endl;
+}
+
+
+int main (int argc, char* argv[]) {
+
+	double relativeTolerance = 1.0e-6;
+	double absoluteTolerance = 1.0e-6;
+	int maxReported = 20;
+	string ignored ("CreationTime");
+	int i;
+
+	for (i=1; (i+1<argc) && (argv [i][0] == '-'); i+=2) {
+
+		if (strcmp (argv [i], "-rtol") == 0)
+			relativeTolerance = atof (argv [i + 1]);
+
+		else if (strcmp (argv [i], "-atol") == 0)
+			absoluteTolerance = atof (argv [i + 1]);
+
+		else if (strcmp (argv [i], "-ignore") == 0)
+			ignored = argv [i + 1];
+
+		else if (strcmp (argv [i], "-max") == 0)
+			maxReported = atoi (argv [i + 1]);
+
+		else {
+
+			Usage (argv [0]);
+			return 2;
+		}
+	}
+
+	if (i + 2 != argc) {
+
+		Usage (argv [0]);
+		return 2;
+	}
+
+	OutputComparison comparison (relativeTolerance, absoluteTolerance, maxReported);
+	size_t start = 0;
+	size_t comma;
+
+	while (start < ignored.length ()) {
+
+		comma = ignored.find (',', start);
+
+		if (comma == string::npos)
+			comma = ignored.length ();
+
+		if (comma > start)
+			comparison.Ignore (ignored.substr (start, comma - start));
+
+		start = comma + 1;
+	}
+
+	int status = comparison.Compare (argv [i], argv [i + 1]);
+
+	if (status == 2)
+		return 2;
+
+	if (comparison.GetDifferences () > maxReported)
+		cout << "  ..." << endl;
+
+	cout << ((status == 0) ? "equivalent" : "DIFFERENT") << ":  " << comparison.GetDifferences () << " differences, ";
+	cout << comparison.GetNumbersCompared () << " inexact numbers, max relative difference " << comparison.GetMaxRelativeDifference ();
+	cout << ", max absolute difference " << comparison.GetMaxAbsoluteDifference () << endl;
+	return status;
+}
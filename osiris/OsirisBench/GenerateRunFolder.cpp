@@ -0,0 +1,1084 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: GenerateRunFolder.cpp
+*
+*/
+//
+//  GenerateRunFolder writes a folder of synthetic ABIF (.fsa) files for a kit, for end to end throughput testing without
+//  casework data.  Loci, ladder alleles, dye names and channel assignments come from the kit's _LadderInfo.xml and the lane
+//  standard sizes from ILSAndLadderInfo.xml, both in <LadderDirectory>/LadderSpecifications.  Each file contains raw data
+//  (DATA 1-4, 105...) with pull-up, baseline drift, noise and spikes, and analyzed data (DATA 9-12, 205...) with noise and
+//  spikes only.  Ladders carry every ladder allele; samples and positive controls carry a random genotype with stutter;
+//  negative controls carry only the lane standard.  File names use the default ladder and control synonyms ("ladder",
+//  "pos", "neg").  Output is deterministic for a given seed.
+//
+//  Usage:  GenerateRunFolder -ladderdir <OsirisXML dir> -kit <kit name> -ils <lane standard name> -out <directory>
+//              [-samples n] [-ladders n] [-pos n] [-neg n] [-scans n] [-seed n]
+//
+
+#include "rgstring.h"
+#include "rgfile.h"
+#include "rgdirectory.h"
+#include "rgtokenizer.h"
+#include <iostream>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace std;
+
+
+//
+//  Deterministic pseudo-random numbers, so that folders are identical on every platform
+//
+
+class RunFolderRandom {
+
+public:
+	RunFolderRandom (unsigned long seed) : mState (seed & 0x7fffffffUL), mHaveSpare (false), mSpare (0.0) {}
+
+	double Uniform () {
+
+		mState = (1103515245UL * mState + 12345UL) & 0x7fffffffUL;
+		return ((double)mState + 0.5) / 2147483648.0;
+	}
+
+	double Uniform (double low, double high) { return low + (high - low) * Uniform (); }
+	int Integer (int n) { return (int)(n * Uniform ()) % n; }
+
+	double Normal () {
+
+		if (mHaveSpare) {
+
+			mHaveSpare = false;
+			return mSpare;
+		}
+
+		double r = sqrt (-2.0 * log (Uniform ()));
+		double theta = 2.0 * acos (-1.0) * Uniform ();
+		mSpare = r * sin (theta);
+		mHaveSpare = true;
+		return r * cos (theta);
+	}
+
+protected:
+	unsigned long mState;
+	bool mHaveSpare;
+	double mSpare;
+};
+
+
+struct KitAllele {
+
+	RGString mName;
+	double mBP;
+	double mRelativeHeight;
+};
+
+
+struct KitLocus {
+
+	RGString mName;
+	int mChannel;
+	double mRepeat;
+	double mShift;
+	vector<KitAllele> mAlleles;
+};
+
+
+struct KitDescription {
+
+	int mNumberOfChannels;
+	int mILSChannel;
+	vector<RGString> mDyeNames;
+	vector<KitLocus> mLoci;
+	vector<double> mILSSizes;
+};
+
+
+//
+//  Kit input
+//
+
+static RGString GetTagValue (const RGString& tag, RGString& search) {
+
+	RGXMLTagSearch tagSearch (tag, search);
+	size_t endOffset;
+	RGString value;
+
+	if (!tagSearch.FindNextTag (0, endOffset, value))
+		return "";
+
+	return value;
+}
+
+
+static double GetRelativeHeight (const RGString& code) {
+
+	if (code == "H")
+		return 1.0;
+
+	if (code == "MH")
+		return 0.8;
+
+	if (code == "ML")
+		return 0.6;
+
+	if (code == "L")
+		return 0.45;
+
+	return 0.8;
+}
+
+
+static bool ReadTextFile (const RGString& fileName, RGString& contents) {
+
+	RGFile file (fileName, "rt");
+
+	if (!file.isValid ()) {
+
+		cout << "Could not open file:  " << fileName.GetData () << endl;
+		return false;
+	}
+
+	contents.ReadTextFile (file);
+	return true;
+}
+
+
+static bool ReadILSSizes (const RGString& specDirectory, const RGString& ilsName, const RGString& kitName, RGString& kitFileName, vector<double>& sizes) {
+
+	RGString ilsData;
+
+	if (!ReadTextFile (specDirectory + "ILSAndLadderInfo.xml", ilsData))
+		return false;
+
+	RGString laneStandardString;
+	RGString setString;
+	size_t startIndex = 0;
+	size_t endIndex;
+	RGXMLTagSearch laneStandardSearch ("LaneStandard", ilsData);
+	RGXMLTagSearch setSearch ("Set", ilsData);
+
+	while (laneStandardSearch.FindNextTag (startIndex, endIndex, laneStandardString)) {
+
+		startIndex = endIndex;
+
+		if (GetTagValue ("Name", laneStandardString) != ilsName)
+			continue;
+
+		RGString characteristics = GetTagValue ("Characteristics", laneStandardString);
+		const char* p = characteristics.GetData ();
+		char* next;
+		double size;
+
+		while (true) {
+
+			size = strtod (p, &next);
+
+			if (next == p)
+				break;
+
+			sizes.push_back (size);
+			p = next;
+		}
+
+		break;
+	}
+
+	if (sizes.size () < 4) {
+
+		cout << "Could not find lane standard " << ilsName.GetData () << " in ILSAndLadderInfo.xml" << endl;
+		return false;
+	}
+
+	startIndex = 0;
+
+	while (setSearch.FindNextTag (startIndex, endIndex, setString)) {
+
+		startIndex = endIndex;
+
+		if (GetTagValue ("KitName", setString) == kitName) {
+
+			kitFileName = GetTagValue ("FileName", setString);
+			return true;
+		}
+	}
+
+	cout << "Could not find kit " << kitName.GetData () << " in ILSAndLadderInfo.xml" << endl;
+	return false;
+}
+
+
+static bool ReadKit (const RGString& ladderDirectory, const RGString& kitName, const RGString& ilsName, KitDescription& kit) {
+
+	RGString specDirectory = ladderDirectory + "/LadderSpecifications/";
+	RGString kitFileName;
+
+	if (!ReadILSSizes (specDirectory, ilsName, kitName, kitFileName, kit.mILSSizes))
+		return false;
+
+	RGString kitData;
+
+	if (!ReadTextFile (specDirectory + kitFileName, kitData))
+		return false;
+
+	RGString setString;
+	size_t startIndex = 0;
+	size_t endIndex;
+	RGXMLTagSearch setSearch ("Set", kitData);
+	bool foundSet = false;
+
+	while (setSearch.FindNextTag (startIndex, endIndex, setString)) {
+
+		startIndex = endIndex;
+
+		if (GetTagValue ("Name", setString) == kitName) {
+
+			foundSet = true;
+			break;
+		}
+	}
+
+	if (!foundSet) {
+
+		cout << "Could not find kit " << kitName.GetData () << " in " << kitFileName.GetData () << endl;
+		return false;
+	}
+
+	kit.mNumberOfChannels = GetTagValue ("NChannels", setString).ConvertToInteger ();
+	RGString lsString = GetTagValue ("LS", setString);
+	kit.mILSChannel = GetTagValue ("ChannelNo", lsString).ConvertToInteger ();
+
+	if ((kit.mNumberOfChannels < 2) || (kit.mILSChannel < 1) || (kit.mILSChannel > kit.mNumberOfChannels)) {
+
+		cout << "Kit " << kitName.GetData () << " has an invalid channel description" << endl;
+		return false;
+	}
+
+	// Kit channels are mapped to fsa channels; everything below is in terms of fsa channels
+
+	vector<int> fsaChannelMap (kit.mNumberOfChannels + 1);
+	int i;
+
+	for (i=0; i<=kit.mNumberOfChannels; i++) {
+
+		fsaChannelMap [i] = i;
+		kit.mDyeNames.push_back ("");
+	}
+
+	RGString mapString = GetTagValue ("FsaChannelMap", setString);
+	RGString channelString;
+	RGXMLTagSearch channelSearch ("Channel", mapString);
+	int kitChannel;
+	int fsaChannel;
+	startIndex = 0;
+
+	while (channelSearch.FindNextTag (startIndex, endIndex, channelString)) {
+
+		startIndex = endIndex;
+		kitChannel = GetTagValue ("KitChannelNumber", channelString).ConvertToInteger ();
+		fsaChannel = GetTagValue ("fsaChannelNumber", channelString).ConvertToInteger ();
+
+		if ((kitChannel < 1) || (kitChannel > kit.mNumberOfChannels) || (fsaChannel < 1) || (fsaChannel > kit.mNumberOfChannels))
+			continue;
+
+		fsaChannelMap [kitChannel] = fsaChannel;
+		kit.mDyeNames [fsaChannel] = GetTagValue ("DyeName", channelString);
+	}
+
+	kit.mILSChannel = fsaChannelMap [kit.mILSChannel];
+
+	for (i=1; i<=kit.mNumberOfChannels; i++) {
+
+		if (kit.mDyeNames [i].Length () == 0)
+			kit.mDyeNames [i] << "Dye" << i;
+	}
+
+	RGString locusString;
+	RGString allelesString;
+	RGString alleleString;
+	RGXMLTagSearch locusSearch ("Locus", setString);
+	size_t alleleStart;
+	size_t alleleEnd;
+	size_t j;
+	double difference;
+	startIndex = 0;
+
+	while (locusSearch.FindNextTag (startIndex, endIndex, locusString)) {
+
+		startIndex = endIndex;
+		KitLocus locus;
+		locus.mName = GetTagValue ("Name", locusString);
+		kitChannel = GetTagValue ("Channel", locusString).ConvertToInteger ();
+
+		if ((kitChannel < 1) || (kitChannel > kit.mNumberOfChannels))
+			continue;
+
+		locus.mChannel = fsaChannelMap [kitChannel];
+		allelesString = GetTagValue ("LadderAlleles", locusString);
+		RGXMLTagSearch alleleSearch ("Allele", allelesString);
+		alleleStart = 0;
+
+		while (alleleSearch.FindNextTag (alleleStart, alleleEnd, alleleString)) {
+
+			alleleStart = alleleEnd;
+			KitAllele allele;
+			allele.mName = GetTagValue ("Name", alleleString);
+			allele.mBP = GetTagValue ("BP", alleleString).ConvertToDouble ();
+			allele.mRelativeHeight = GetRelativeHeight (GetTagValue ("RelativeHeight", alleleString));
+
+			if (allele.mBP > 0.0)
+				locus.mAlleles.push_back (allele);
+		}
+
+		if (locus.mAlleles.empty ())
+			continue;
+
+		// The repeat length, for stutter, is the smallest spacing of at least 2 bp between consecutive ladder alleles
+
+		locus.mRepeat = 4.0;
+		double smallest = 1000.0;
+
+		for (j=1; j<locus.mAlleles.size (); j++) {
+
+			difference = locus.mAlleles [j].mBP - locus.mAlleles [j - 1].mBP;
+
+			if ((difference >= 2.0) && (difference < smallest))
+				smallest = difference;
+		}
+
+		if (smallest < 1000.0)
+			locus.mRepeat = floor (smallest + 0.5);
+
+		//
+		//  Dyes migrate differently from the lane standard, so ladder alleles do not sit at their nominal sizes in ILS base
+		//  pairs.  Center the alleles in the locus grid (MinGridLSBasePair to MaxGridLSBasePair, or the first search region's
+		//  MinGrid to MaxGrid), which is where the analysis looks for them
+		//
+
+		RGString minGrid = GetTagValue ("MinGridLSBasePair", locusString);
+		RGString maxGrid = GetTagValue ("MaxGridLSBasePair", locusString);
+
+		if ((minGrid.Length () == 0) || (maxGrid.Length () == 0)) {
+
+			minGrid = GetTagValue ("MinGrid", locusString);
+			maxGrid = GetTagValue ("MaxGrid", locusString);
+		}
+
+		locus.mShift = 0.0;
+
+		if ((minGrid.Length () > 0) && (maxGrid.Length () > 0))
+			locus.mShift = 0.5 * (minGrid.ConvertToDouble () + maxGrid.ConvertToDouble () - locus.mAlleles.front ().mBP - locus.mAlleles.back ().mBP);
+
+		kit.mLoci.push_back (locus);
+	}
+
+	if (kit.mLoci.empty ()) {
+
+		cout << "Kit " << kitName.GetData () << " has no loci with ladder alleles" << endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+//
+//  Signal synthesis.  Sizes, in ILS base pairs, map to scan numbers through a mildly nonlinear mobility curve that varies
+//  a little from file to file, as it does from capillary to capillary, so that the lane standard fit is exercised
+//
+
+class SyntheticRun {
+
+public:
+	SyntheticRun (const KitDescription& kit, int numberOfScans, RunFolderRandom& random);
+	~SyntheticRun ();
+
+	void AddLaneStandard ();
+	void AddLadder ();
+	void AddGenotype ();
+	void AddArtifacts ();
+
+	const vector<short>& GetRawData (int channel) const { return mRawData [channel]; }
+	const vector<short>& GetAnalyzedData (int channel) const { return mAnalyzedData [channel]; }
+	const vector<long>& GetOffScale () const { return mOffScale; }
+
+protected:
+	const KitDescription& mKit;
+	int mNumberOfScans;
+	RunFolderRandom& mRandom;
+	double mOffset;
+	double mSlope;
+	double mCurvature;
+	double** mSignal;
+	vector<vector<short> > mRawData;
+	vector<vector<short> > mAnalyzedData;
+	vector<long> mOffScale;
+
+	double GetTime (double bp) const;
+	void AddPeak (int channel, double bp, double height);
+	void AddSpike (int scan, double height);
+	static short Clip (double value);
+};
+
+
+SyntheticRun :: SyntheticRun (const KitDescription& kit, int numberOfScans, RunFolderRandom& random) : mKit (kit),
+mNumberOfScans (numberOfScans), mRandom (random), mRawData (kit.mNumberOfChannels + 1), mAnalyzedData (kit.mNumberOfChannels + 1) {
+
+	int i;
+	int j;
+	double maxBP = kit.mILSSizes.back ();
+
+	for (i=0; i<(int)kit.mLoci.size (); i++) {
+
+		if (kit.mLoci [i].mAlleles.back ().mBP + kit.mLoci [i].mShift > maxBP)
+			maxBP = kit.mLoci [i].mAlleles.back ().mBP + kit.mLoci [i].mShift;
+	}
+
+	// Place 0 bp near 10% of the run and the largest fragment near 88%, with 5% curvature, then jitter by capillary
+
+	double span = 0.78 * numberOfScans;
+	mOffset = (0.10 + 0.01 * mRandom.Normal ()) * numberOfScans;
+	mCurvature = 0.05 * span / (maxBP * maxBP);
+	mSlope = (0.95 * span / maxBP) * (1.0 + 0.01 * mRandom.Normal ());
+	mSignal = new double* [kit.mNumberOfChannels + 1];
+
+	for (i=1; i<=kit.mNumberOfChannels; i++) {
+
+		mSignal [i] = new double [numberOfScans];
+
+		for (j=0; j<numberOfScans; j++)
+			mSignal [i][j] = 0.0;
+	}
+}
+
+
+SyntheticRun :: ~SyntheticRun () {
+
+	int i;
+
+	for (i=1; i<=mKit.mNumberOfChannels; i++)
+		delete[] mSignal [i];
+
+	delete[] mSignal;
+}
+
+
+double SyntheticRun :: GetTime (double bp) const {
+
+	return mOffset + mSlope * bp + mCurvature * bp * bp;
+}
+
+
+void SyntheticRun :: AddPeak (int channel, double bp, double height) {
+
+	double mean = GetTime (bp);
+	double sigma = 1.8 + 1.5 * mean / mNumberOfScans;
+	int first = (int)floor (mean - 6.0 * sigma);
+	int last = (int)ceil (mean + 6.0 * sigma);
+	double* signal = mSignal [channel];
+	double x;
+	int i;
+
+	if (first < 0)
+		first = 0;
+
+	if (last >= mNumberOfScans)
+		last = mNumberOfScans - 1;
+
+	for (i=first; i<=last; i++) {
+
+		x = (i - mean) / sigma;
+		signal [i] += height * exp (-0.5 * x * x);
+	}
+}
+
+
+void SyntheticRun :: AddSpike (int scan, double height) {
+
+	// A spike is a single scan (occasionally two) wide and appears in every channel
+
+	int i;
+	bool wide = (mRandom.Uniform () < 0.5);
+
+	for (i=1; i<=mKit.mNumberOfChannels; i++) {
+
+		mSignal [i][scan] += height * mRandom.Uniform (0.8, 1.0);
+
+		if (wide && (scan + 1 < mNumberOfScans))
+			mSignal [i][scan + 1] += 0.5 * height;
+	}
+}
+
+
+short SyntheticRun :: Clip (double value) {
+
+	// The detector saturates well below the range of a short
+
+	if (value > 32000.0)
+		return 32000;
+
+	if (value < -32000.0)
+		return -32000;
+
+	return (short)floor (value + 0.5);
+}
+
+
+void SyntheticRun :: AddLaneStandard () {
+
+	size_t i;
+	double height = mRandom.Uniform (600.0, 1800.0);
+
+	for (i=0; i<mKit.mILSSizes.size (); i++)
+		AddPeak (mKit.mILSChannel, mKit.mILSSizes [i], height * mRandom.Uniform (0.85, 1.15));
+}
+
+
+void SyntheticRun :: AddLadder () {
+
+	size_t i;
+	size_t j;
+	double height = mRandom.Uniform (1200.0, 2500.0);
+
+	for (i=0; i<mKit.mLoci.size (); i++) {
+
+		const KitLocus& locus = mKit.mLoci [i];
+
+		for (j=0; j<locus.mAlleles.size (); j++)
+			AddPeak (locus.mChannel, locus.mAlleles [j].mBP + locus.mShift, height * locus.mAlleles [j].mRelativeHeight * mRandom.Uniform (0.9, 1.1));
+	}
+}
+
+
+void SyntheticRun :: AddGenotype () {
+
+	// Two alleles per locus drawn from the ladder, with heterozygote imbalance, degradation with size and -1 repeat stutter
+
+	size_t i;
+	int k;
+	double height = mRandom.Uniform (400.0, 3000.0);
+	double alleleHeight;
+	double bp;
+
+	for (i=0; i<mKit.mLoci.size (); i++) {
+
+		const KitLocus& locus = mKit.mLoci [i];
+		int n = (int)locus.mAlleles.size ();
+
+		for (k=0; k<2; k++) {
+
+			bp = locus.mAlleles [mRandom.Integer (n)].mBP + locus.mShift;
+			alleleHeight = height * mRandom.Uniform (0.8, 1.2) * exp (-0.0015 * bp);
+			AddPeak (locus.mChannel, bp, alleleHeight);
+			AddPeak (locus.mChannel, bp - locus.mRepeat, alleleHeight * mRandom.Uniform (0.04, 0.10));
+		}
+	}
+}
+
+
+void SyntheticRun :: AddArtifacts () {
+
+	//
+	//  Raw data:  signal plus pull-up into the neighboring channels, baseline offset and drift, noise and spikes.
+	//  Analyzed data:  signal plus noise and spikes, as if color corrected and baseline subtracted
+	//
+
+	int i;
+	int j;
+	int nSpikes = (mRandom.Uniform () < 0.3) ? 1 + mRandom.Integer (2) : 0;
+	int nChannels = mKit.mNumberOfChannels;
+	bool* saturated = new bool [mNumberOfScans];
+
+	for (i=0; i<nSpikes; i++)
+		AddSpike ((int)mRandom.Uniform (0.15 * mNumberOfScans, 0.95 * mNumberOfScans), mRandom.Uniform (500.0, 3000.0));
+
+	double* pullupBelow = new double [nChannels + 2];
+	double* pullupAbove = new double [nChannels + 2];
+	double* baseline = new double [nChannels + 1];
+	double* drift = new double [nChannels + 1];
+	double* phase = new double [nChannels + 1];
+	double period = 0.7 * mNumberOfScans;
+	double pi2 = 2.0 * acos (-1.0);
+	double raw;
+
+	for (j=0; j<mNumberOfScans; j++)
+		saturated [j] = false;
+
+	for (i=1; i<=nChannels; i++) {
+
+		pullupBelow [i] = mRandom.Uniform (0.005, 0.03);
+		pullupAbove [i] = mRandom.Uniform (0.005, 0.02);
+		baseline [i] = mRandom.Uniform (20.0, 80.0);
+		drift [i] = mRandom.Uniform (10.0, 50.0);
+		phase [i] = mRandom.Uniform (0.0, pi2);
+		mRawData [i].resize (mNumberOfScans);
+		mAnalyzedData [i].resize (mNumberOfScans);
+	}
+
+	for (i=1; i<=nChannels; i++) {
+
+		for (j=0; j<mNumberOfScans; j++) {
+
+			raw = mSignal [i][j] + baseline [i] + drift [i] * sin (pi2 * j / period + phase [i]) + 3.0 * mRandom.Normal ();
+
+			if (i > 1)
+				raw += pullupAbove [i - 1] * mSignal [i - 1][j];
+
+			if (i < nChannels)
+				raw += pullupBelow [i + 1] * mSignal [i + 1][j];
+
+			if (raw > 32000.0)
+				saturated [j] = true;
+
+			mRawData [i][j] = Clip (raw);
+			mAnalyzedData [i][j] = Clip (mSignal [i][j] + 2.0 * mRandom.Normal ());
+		}
+	}
+
+	delete[] pullupBelow;
+	delete[] pullupAbove;
+	delete[] baseline;
+	delete[] drift;
+	delete[] phase;
+
+	// Off scale scans are recorded once, whichever channel saturated
+
+	for (j=0; j<mNumberOfScans; j++) {
+
+		if (saturated [j])
+			mOffScale.push_back (j);
+	}
+
+	delete[] saturated;
+}
+
+
+//
+//  ABIF output.  Entries are accumulated with their data, then written as header, data blocks and directory, all big endian.
+//  Data of 4 bytes or less is stored in the directory entry's offset field, as ABIF requires
+//
+
+class ABIFWriter {
+
+public:
+	ABIFWriter () {}
+
+	void AddShort (const char* name, int number, short value);
+	void AddShortArray (const char* name, int number, const vector<short>& values);
+	void AddLongArray (const char* name, int number, const vector<long>& values);
+	void AddPString (const char* name, int number, const RGString& value);
+	void AddChars (const char* name, int number, const char* value);
+	void AddDate (const char* name, int number, int year, int month, int day);
+	void AddTime (const char* name, int number, int hour, int minute, int second);
+
+	bool Write (const RGString& fileName) const;
+
+protected:
+	struct Entry {
+
+		char mName [4];
+		int mNumber;
+		int mType;
+		int mElementSize;
+		int mNumberOfElements;
+		vector<unsigned char> mData;
+	};
+
+	vector<Entry> mEntries;
+
+	Entry& NewEntry (const char* name, int number, int type, int elementSize, int numberOfElements);
+	static void Put16 (vector<unsigned char>& buffer, int value);
+	static void Put32 (vector<unsigned char>& buffer, long value);
+};
+
+
+ABIFWriter::Entry& ABIFWriter :: NewEntry (const char* name, int number, int type, int elementSize, int numberOfElements) {
+
+	mEntries.push_back (Entry ());
+	Entry& entry = mEntries.back ();
+	memcpy (entry.mName, name, 4);
+	entry.mNumber = number;
+	entry.mType = type;
+	entry.mElementSize = elementSize;
+	entry.mNumberOfElements = numberOfElements;
+	return entry;
+}
+
+
+void ABIFWriter :: Put16 (vector<unsigned char>& buffer, int value) {
+
+	buffer.push_back ((unsigned char)((value >> 8) & 0xff));
+	buffer.push_back ((unsigned char)(value & 0xff));
+}
+
+
+void ABIFWriter :: Put32 (vector<unsigned char>& buffer, long value) {
+
+	buffer.push_back ((unsigned char)((value >> 24) & 0xff));
+	buffer.push_back ((unsigned char)((value >> 16) & 0xff));
+	buffer.push_back ((unsigned char)((value >> 8) & 0xff));
+	buffer.push_back ((unsigned char)(value & 0xff));
+}
+
+
+void ABIFWriter :: AddShort (const char* name, int number, short value) {
+
+	Put16 (NewEntry (name, number, 4, 2, 1).mData, value);
+}
+
+
+void ABIFWriter :: AddShortArray (const char* name, int number, const vector<short>& values) {
+
+	Entry& entry = NewEntry (name, number, 4, 2, (int)values.size ());
+	size_t i;
+	entry.mData.reserve (2 * values.size ());
+
+	for (i=0; i<values.size (); i++)
+		Put16 (entry.mData, values [i]);
+}
+
+
+void ABIFWriter :: AddLongArray (const char* name, int number, const vector<long>& values) {
+
+	Entry& entry = NewEntry (name, number, 5, 4, (int)values.size ());
+	size_t i;
+	entry.mData.reserve (4 * values.size ());
+
+	for (i=0; i<values.size (); i++)
+		Put32 (entry.mData, values [i]);
+}
+
+
+void ABIFWriter :: AddPString (const char* name, int number, const RGString& value) {
+
+	size_t length = value.Length ();
+
+	if (length > 255)
+		length = 255;
+
+	Entry& entry = NewEntry (name, number, 18, 1, (int)length + 1);
+	entry.mData.push_back ((unsigned char)length);
+	entry.mData.insert (entry.mData.end (), value.GetData (), value.GetData () + length);
+}
+
+
+void ABIFWriter :: AddChars (const char* name, int number, const char* value) {
+
+	size_t length = strlen (value);
+	Entry& entry = NewEntry (name, number, 2, 1, (int)length);
+	entry.mData.insert (entry.mData.end (), value, value + length);
+}
+
+
+void ABIFWriter :: AddDate (const char* name, int number, int year, int month, int day) {
+
+	Entry& entry = NewEntry (name, number, 10, 4, 1);
+	Put16 (entry.mData, year);
+	entry.mData.push_back ((unsigned char)month);
+	entry.mData.push_back ((unsigned char)day);
+}
+
+
+void ABIFWriter :: AddTime (const char* name, int number, int hour, int minute, int second) {
+
+	Entry& entry = NewEntry (name, number, 11, 4, 1);
+	entry.mData.push_back ((unsigned char)hour);
+	entry.mData.push_back ((unsigned char)minute);
+	entry.mData.push_back ((unsigned char)second);
+	entry.mData.push_back (0);
+}
+
+
+bool ABIFWriter :: Write (const RGString& fileName) const {
+
+	const size_t headerSize = 128;
+	vector<unsigned char> data;
+	vector<unsigned char> directory;
+	vector<unsigned char> header;
+	size_t i;
+	size_t dataSize;
+	unsigned char inlineData [4];
+
+	for (i=0; i<mEntries.size (); i++) {
+
+		const Entry& entry = mEntries [i];
+		dataSize = entry.mData.size ();
+		directory.insert (directory.end (), entry.mName, entry.mName + 4);
+		Put32 (directory, entry.mNumber);
+		Put16 (directory, entry.mType);
+		Put16 (directory, entry.mElementSize);
+		Put32 (directory, entry.mNumberOfElements);
+		Put32 (directory, (long)dataSize);
+
+		if (dataSize <= 4) {
+
+			memset (inlineData, 0, 4);
+
+			if (dataSize > 0)
+				memcpy (inlineData, &entry.mData [0], dataSize);
+
+			directory.insert (directory.end (), inlineData, inlineData + 4);
+		}
+
+		else {
+
+			Put32 (directory, (long)(headerSize + data.size ()));
+			data.insert (data.end (), entry.mData.begin (), entry.mData.end ());
+		}
+
+		Put32 (directory, 0);
+	}
+
+	header.insert (header.end (), "ABIF", "ABIF" + 4);
+	Put16 (header, 101);
+	header.insert (header.end (), "tdir", "tdir" + 4);
+	Put32 (header, 1);
+	Put16 (header, 1023);
+	Put16 (header, 28);
+	Put32 (header, (long)mEntries.size ());
+	Put32 (header, (long)directory.size ());
+	Put32 (header, (long)(headerSize + data.size ()));
+	Put32 (header, 0);
+	header.resize (headerSize, 0);
+
+	RGFile file (fileName, "wb");
+
+	if (!file.isValid ()) {
+
+		cout << "Could not open output file:  " << fileName.GetData () << endl;
+		return false;
+	}
+
+	FILE* pf = file.GetFile ();
+	bool ok = (fwrite (&header [0], 1, header.size (), pf) == header.size ());
+	ok = ok && (data.empty () || (fwrite (&data [0], 1, data.size (), pf) == data.size ()));
+	ok = ok && (fwrite (&directory [0], 1, directory.size (), pf) == directory.size ());
+
+	if (!ok)
+		cout << "Could not write output file:  " << fileName.GetData () << endl;
+
+	return ok;
+}
+
+
+static bool WriteFsaFile (const RGString& fileName, const RGString& sampleName, int lane, const KitDescription& kit, const SyntheticRun& run) {
+
+	ABIFWriter abif;
+	int i;
+
+	abif.AddChars ("MODL", 1, "3130");
+	abif.AddPString ("MCHN", 1, "SYNTHETIC");
+	abif.AddPString ("DySN", 1, "SYNTH");
+	abif.AddShort ("Dye#", 1, (short)kit.mNumberOfChannels);
+
+	for (i=1; i<=kit.mNumberOfChannels; i++)
+		abif.AddPString ("DyeN", i, kit.mDyeNames [i]);
+
+	for (i=1; i<=kit.mNumberOfChannels; i++)
+		abif.AddShortArray ("DATA", (i <= 4) ? i : 100 + i, run.GetRawData (i));
+
+	for (i=1; i<=kit.mNumberOfChannels; i++)
+		abif.AddShortArray ("DATA", (i <= 4) ? 8 + i : 200 + i, run.GetAnalyzedData (i));
+
+	for (i=1; i<=4; i++) {
+
+		abif.AddDate ("RUND", i, 2020, 1, 1);
+		abif.AddTime ("RUNT", i, 12, i, 0);
+	}
+
+	if (!run.GetOffScale ().empty ())
+		abif.AddLongArray ("OfSc", 1, run.GetOffScale ());
+
+	abif.AddShort ("LANE", 1, (short)lane);
+	abif.AddPString ("SMPL", 1, sampleName);
+	abif.AddPString ("SpNm", 1, sampleName);
+	abif.AddPString ("CMNT", 1, "Synthetic data from GenerateRunFolder");
+	return abif.Write (fileName);
+}
+
+
+static RGString WellName (int index) {
+
+	// Wells in 96 well plate column order:  A01, B01, ..., H01, A02, ...
+
+	RGString name;
+	int well = index % 96;
+	char buffer [8];
+	sprintf (buffer, "%c%02d", 'A' + well % 8, 1 + well / 8);
+	name = buffer;
+	return name;
+}
+
+
+static void Usage (const char* program) {
+
+	cout << "Usage:  " << program << " -ladderdir <OsirisXML dir> -kit <kit name> -ils <lane standard name> -out <directory>" << endl;
+	cout << "            [-samples n] [-ladders n] [-pos n] [-neg n] [-scans n] [-seed n]" << endl;
+}
+
+
+int main (int argc, char* argv[]) {
+
+	RGString ladderDirectory;
+	RGString kitName;
+	RGString ilsName;
+	RGString outputDirectory;
+	int numberOfSamples = 96;
+	int numberOfLadders = 1;
+	int numberOfPositives = 1;
+	int numberOfNegatives = 1;
+	int numberOfScans = 10000;
+	unsigned long seed = 1;
+	int i;
+
+	for (i=1; i+1<argc; i+=2) {
+
+		if (strcmp (argv [i], "-ladderdir") == 0)
+			ladderDirectory = argv [i + 1];
+
+		else if (strcmp (argv [i], "-kit") == 0)
+			kitName = argv [i + 1];
+
+		else if (strcmp (argv [i], "-ils") == 0)
+			ilsName = argv [i + 1];
+
+		else if (strcmp (argv [i], "-out") == 0)
+			outputDirectory = argv [i + 1];
+
+		else if (strcmp (argv [i], "-samples") == 0)
+			numberOfSamples = atoi (argv [i + 1]);
+
+		else if (strcmp (argv [i], "-ladders") == 0)
+			numberOfLadders = atoi (argv [i + 1]);
+
+		else if (strcmp (argv [i], "-pos") == 0)
+			numberOfPositives = atoi (argv [i + 1]);
+
+		else if (strcmp (argv [i], "-neg") == 0)
+			numberOfNegatives = atoi (argv [i + 1]);
+
+		else if (strcmp (argv [i], "-scans") == 0)
+			numberOfScans = atoi (argv [i + 1]);
+
+		else if (strcmp (argv [i], "-seed") == 0)
+			seed = (unsigned long)atol (argv [i + 1]);
+
+		else {
+
+			Usage (argv [0]);
+			return 1;
+		}
+	}
+
+	if ((i != argc) || (ladderDirectory.Length () == 0) || (kitName.Length () == 0) || (ilsName.Length () == 0) || (outputDirectory.Length () == 0)) {
+
+		Usage (argv [0]);
+		return 1;
+	}
+
+	if ((numberOfLadders < 1) || (numberOfSamples < 0) || (numberOfPositives < 0) || (numberOfNegatives < 0) || (numberOfScans < 2000)) {
+
+		cout << "There must be at least one ladder and at least 2000 scans" << endl;
+		return 1;
+	}
+
+	KitDescription kit;
+
+	if (!ReadKit (ladderDirectory, kitName, ilsName, kit))
+		return 2;
+
+	if (!RGDirectory::FileOrDirectoryExists (outputDirectory) && !RGDirectory::MakeDirectory (outputDirectory)) {
+
+		cout << "Could not create output directory:  " << outputDirectory.GetData () << endl;
+		return 3;
+	}
+
+	RunFolderRandom random (seed);
+	int total = numberOfLadders + numberOfPositives + numberOfNegatives + numberOfSamples;
+	int nLadders = 0;
+	int nPositives = 0;
+	int nNegatives = 0;
+	int nSamples = 0;
+	RGString name;
+	char number [16];
+
+	//
+	//  Ladders are spread evenly through the run, one at the start of each block, with the controls following the first ladder
+	//
+
+	int ladderSpacing = (total + numberOfLadders - 1) / numberOfLadders;
+
+	for (i=0; i<total; i++) {
+
+		SyntheticRun run (kit, numberOfScans, random);
+		run.AddLaneStandard ();
+
+		if ((nLadders < numberOfLadders) && ((i % ladderSpacing == 0) || (total - i <= numberOfLadders - nLadders))) {
+
+			nLadders++;
+			sprintf (number, "%02d", nLadders);
+			name = RGString ("Ladder_") + number;
+			run.AddLadder ();
+		}
+
+		else if (nPositives < numberOfPositives) {
+
+			nPositives++;
+			sprintf (number, "%02d", nPositives);
+			name = RGString ("PosCtrl_") + number;
+			run.AddGenotype ();
+		}
+
+		else if (nNegatives < numberOfNegatives) {
+
+			nNegatives++;
+			sprintf (number, "%02d", nNegatives);
+			name = RGString ("NegCtrl_") + number;
+		}
+
+		else {
+
+			nSamples++;
+			sprintf (number, "%04d", nSamples);
+			name = RGString ("S") + number;
+			run.AddGenotype ();
+		}
+
+		run.AddArtifacts ();
+		name << "_" << WellName (i);
+
+		if (!WriteFsaFile (outputDirectory + "/" + name + ".fsa", name, 1 + i % 96, kit, run))
+			return 4;
+	}
+
+	cout << "Wrote " << total << " files (" << nLadders << " ladders, " << nPositives << " positive controls, " << nNegatives;
+	cout << " negative controls, " << nSamples << " samples) for " << kitName.GetData () << " to " << outputDirectory.GetData () << endl;
+	return 0;
+}
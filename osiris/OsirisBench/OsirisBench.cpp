@@ -0,0 +1,781 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: OsirisBench.cpp
+*
+*/
+//
+//  OsirisBench runs reproducible microbenchmarks of the numerical kernels in OsirisLib2.01 and OsirisMath on synthetic
+//  data of realistic size.  Each benchmark is calibrated so that one timing trial takes at least MinTrialTime seconds; the
+//  best of NumberOfTrials trials is reported as ns/op together with a throughput in the natural units of the kernel.
+//
+//  Usage:  OsirisBench [-quick] [name filter]
+//
+
+#include "rgstring.h"
+#include "rgdlist.h"
+#include "RGTextOutput.h"
+#include "DataSignal.h"
+#include "TracePrequalification.h"
+#include "LeastMedianOfSquares.h"
+#include "RecursiveInnerProduct.h"
+#include "CoreBioComponent.h"
+#include "AnalysisProfiler.h"
+#include "SynonymList.h"
+#include "PeakTimeIndex.h"
+#include "coordtrans.h"
+#include <iostream>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace std;
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+
+static double MinTrialTime = 0.2;
+static int NumberOfTrials = 5;
+static RGTextOutput* NullText = NULL;
+
+// Benchmarks whose results are otherwise unused store them here, so the work can't be optimized away
+
+static volatile double ResultSink = 0.0;
+
+
+//
+//  Deterministic pseudo-random numbers, so that inputs are identical on every platform
+//
+
+class BenchRandom {
+
+public:
+	BenchRandom (unsigned long seed) : mState (seed) {}
+
+	double Uniform () {
+
+		mState = (1103515245UL * mState + 12345UL) & 0x7fffffffUL;
+		return (double)mState / 2147483648.0;
+	}
+
+	double Noise (double amplitude) { return amplitude * (2.0 * Uniform () - 1.0); }
+
+protected:
+	unsigned long mState;
+};
+
+
+//
+//  Synthetic inputs:  a channel of NumberOfScans samples with NumberOfPeaks double Gaussian shaped peaks on a noisy
+//  baseline and a 16 peak lane standard (sizes of LIZ500) with a mildly nonlinear size to time relationship
+//
+
+static const int NumberOfScans = 8000;
+static const int NumberOfPeaks = 40;
+static const int NumberOfChannels = 5;
+static const int ILSSize = 16;
+static const double ILSSizes [ILSSize] = { 35.0, 50.0, 75.0, 100.0, 139.0, 150.0, 160.0, 200.0, 250.0, 300.0, 340.0, 350.0, 400.0, 450.0, 490.0, 500.0 };
+
+static double PeakMeans [NumberOfPeaks];
+static double PeakHeights [NumberOfPeaks];
+
+
+static double ILSTime (double bp) {
+
+	return 1500.0 + 11.5 * bp + 0.002 * bp * bp;
+}
+
+
+static double* CreateSyntheticTrace (unsigned long seed) {
+
+	BenchRandom random (seed);
+	double* trace = new double [NumberOfScans];
+	int i;
+	int j;
+	double sigma = 2.5;
+	double x;
+
+	for (j=0; j<NumberOfPeaks; j++) {
+
+		PeakMeans [j] = 1200.0 + j * 160.0 + random.Noise (30.0);
+		PeakHeights [j] = 150.0 + 2850.0 * random.Uniform ();
+	}
+
+	for (i=0; i<NumberOfScans; i++) {
+
+		trace [i] = 20.0 + random.Noise (5.0);
+
+		for (j=0; j<NumberOfPeaks; j++) {
+
+			x = (i - PeakMeans [j]) / sigma;
+
+			if (fabs (x) < 12.0)
+				trace [i] += PeakHeights [j] * (0.8 * exp (-0.5 * x * x) + 0.2 * exp (-0.125 * x * x));
+		}
+	}
+
+	return trace;
+}
+
+
+static SampledData* CreateSyntheticSignal (unsigned long seed) {
+
+	double* trace = CreateSyntheticTrace (seed);
+	return new SampledData (NumberOfScans, 0.0, (double)(NumberOfScans - 1), trace);
+}
+
+
+//
+//  Benchmark driver:  run (n) performs n operations and returns the number of items processed (for throughput)
+//
+
+typedef double (*BenchFunction) (int n);
+
+
+static double RunTrial (BenchFunction run, int n, double& items) {
+
+	double start = AnalysisProfiler::GetWallTime ();
+	items = run (n);
+	return AnalysisProfiler::GetWallTime () - start;
+}
+
+
+static void RunBenchmark (const char* name, const char* itemName, BenchFunction run, const char* filter) {
+
+	if ((filter != NULL) && (strstr (name, filter) == NULL))
+		return;
+
+	int n = 1;
+	double items;
+	double elapsed = RunTrial (run, n, items);   // warm up
+
+	while (elapsed < MinTrialTime) {
+
+		if (elapsed <= 0.0)
+			n *= 10;
+
+		else {
+
+			int next = (int)(1.2 * n * MinTrialTime / elapsed) + 1;
+
+			if (next > 10 * n)
+				next = 10 * n;
+
+			n = next;
+		}
+
+		elapsed = RunTrial (run, n, items);
+	}
+
+	double best = elapsed;
+	int i;
+
+	for (i=1; i<NumberOfTrials; i++) {
+
+		elapsed = RunTrial (run, n, items);
+
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	double nsPerOp = 1.0e9 * best / (double)n;
+	double throughput = items / best;
+	char line [256];
+	sprintf (line, "%-44s %10d %14.1f %14.4g %s/s", name, n, nsPerOp, throughput, itemName);
+	cout << line << endl;
+}
+
+
+//
+//  Benchmarks
+//
+
+static SampledData* TraceSignal = NULL;
+
+
+static double BenchResetSearch (int n) {
+
+	int i;
+	STRTracePrequalification trace;
+
+	for (i=0; i<n; i++)
+		trace.ResetSearch (TraceSignal, NumberOfScans, 5.0);
+
+	return (double)n * NumberOfScans;
+}
+
+
+static double BenchFitChannel (int n) {
+
+	//  SampledData prequalification followed by a DoubleGaussian::FindCharacteristic fit for each candidate peak
+
+	int i;
+	int fitted = 0;
+	double fit;
+	DataSignal* nextSignal;
+	RGDList curveList;
+	DoubleGaussian signature (0.0, ParametricCurve::GetSigmaForSignature ());
+
+	for (i=0; i<n; i++) {
+
+		STRTracePrequalification trace;
+		TraceSignal->ResetCharacteristicsFromRight (trace, *NullText, 50.0, FALSE);
+
+		while ((nextSignal = TraceSignal->FindNextCharacteristicFromRight (signature, fit, curveList)) != NULL) {
+
+			fitted++;
+			delete nextSignal;
+		}
+
+		curveList.ClearAndDelete ();
+	}
+
+	return (double)fitted;
+}
+
+
+static double BenchMoments (int n) {
+
+	int i;
+	int j;
+	double left;
+	double right;
+	double sum = 0.0;
+
+	for (i=0; i<n; i++) {
+
+		for (j=0; j<NumberOfPeaks; j++) {
+
+			left = PeakMeans [j] - 10.0;
+			right = PeakMeans [j] + 10.0;
+			sum += TraceSignal->Centroid (left, right);
+			sum += TraceSignal->SecondMoment (left, right);
+			sum += TraceSignal->ThirdMoment (left, right);
+		}
+	}
+
+	ResultSink = sum;
+
+	return (double)n * NumberOfPeaks;
+}
+
+
+static CSplineTransform* SizeTransform = NULL;
+static double* SplineResults = NULL;
+static double* SplineAbscissas = NULL;
+static double SplineSequenceStart = 0.0;
+static int SplineSequenceSize = 0;
+
+
+static double BenchSplineEvaluate (int n) {
+
+	int i;
+	int k;
+	double sum = 0.0;
+
+	for (i=0; i<n; i++) {
+
+		for (k=0; k<NumberOfScans; k++)
+			sum += SizeTransform->EvaluateWithExtrapolation ((double)k);
+	}
+
+	ResultSink = sum;
+
+	return (double)n * NumberOfScans;
+}
+
+
+static double BenchSplineSequence (int n) {
+
+	//  Equally spaced sequences are only evaluated within the knots
+
+	int i;
+
+	for (i=0; i<n; i++) {
+
+		if (SizeTransform->EvaluateFullSequence (SplineResults, SplineSequenceStart, 1.0, SplineSequenceSize) < 0)
+			return 0.0;
+	}
+
+	return (double)n * SplineSequenceSize;
+}
+
+
+static double BenchSplineSorted (int n) {
+
+	//  The same points as BenchSplineEvaluate, in one batch
+
+	int i;
+
+	for (i=0; i<n; i++)
+		SizeTransform->EvaluateSorted (SplineAbscissas, SplineResults, NumberOfScans);
+
+	return (double)n * NumberOfScans;
+}
+
+
+//  Sample to ladder matching:  one sample's ILS times against several ladders' ILS times, as in
+//  CoreBioComponent::GetBestGridBasedOnMax2DerivForAnalysis
+
+static const int NumberOfLadders = 12;
+static double SampleILSTimes [ILSSize];
+static double LadderILSTimes [NumberOfLadders][ILSSize];
+
+
+static double BenchLadderMatching (int n) {
+
+	int i;
+	int j;
+	CSplineCoefficientFactory* factory;
+	CSplineTransform* transform;
+	double sum = 0.0;
+
+	for (i=0; i<n; i++) {
+
+		factory = new CSplineCoefficientFactory (SampleILSTimes, ILSSize);
+
+		for (j=0; j<NumberOfLadders; j++) {
+
+			transform = new CSplineTransform (*factory, LadderILSTimes [j]);
+			sum += transform->MaxSecondDerivative ();
+			delete transform;
+		}
+
+		delete factory;
+	}
+
+	ResultSink = sum;
+
+	return (double)n * NumberOfLadders;
+}
+
+
+static const int LMSSize = 40;
+static double LMSx [LMSSize];
+static double LMSy [LMSSize];
+
+
+static void CreateLMSData () {
+
+	BenchRandom random (17);
+	int i;
+
+	for (i=0; i<LMSSize; i++) {
+
+		LMSx [i] = 200.0 + 6000.0 * random.Uniform ();
+		LMSy [i] = 0.04 * LMSx [i] + 2.0e-6 * LMSx [i] * LMSx [i] + random.Noise (4.0);
+
+		if (i % 7 == 3)
+			LMSy [i] += 80.0;   // outliers
+	}
+}
+
+
+static double BenchLMS1D (int n) {
+
+	int i;
+
+	for (i=0; i<n; i++) {
+
+		LeastMedianOfSquares1D lms (LMSSize, LMSx, LMSy);
+		lms.CalculateLMS ();
+	}
+
+	return (double)n * LMSSize;
+}
+
+
+static double BenchLMS2DExhaustive (int n) {
+
+	int i;
+
+	for (i=0; i<n; i++) {
+
+		LeastMedianOfSquares2DExhaustive lms (LMSSize / 2, LMSx, LMSy);
+		lms.CalculateLMS ();
+	}
+
+	return (double)n * (LMSSize / 2);
+}
+
+
+static double BenchQuadraticLMS (int n) {
+
+	int i;
+
+	for (i=0; i<n; i++) {
+
+		QuadraticLMSExact lms (LMSSize / 2, LMSx, LMSy);
+		lms.CalculateLMS ();
+	}
+
+	return (double)n * (LMSSize / 2);
+}
+
+
+static RGDList ILSCandidates;
+static double ILSPts [ILSSize];
+static double ILSDiffs [ILSSize];
+static double ILSLeftNorm2s [ILSSize];
+
+
+static void CreateILSData () {
+
+	int i;
+	double cumulative = 0.0;
+	DoubleGaussian* peak;
+	BenchRandom random (29);
+
+	for (i=0; i<ILSSize; i++)
+		ILSPts [i] = ILSSizes [i];
+
+	for (i=0; i<ILSSize-1; i++) {
+
+		ILSDiffs [i] = ILSPts [i+1] - ILSPts [i];
+		cumulative += ILSDiffs [i] * ILSDiffs [i];
+		ILSLeftNorm2s [i] = cumulative;
+	}
+
+	//  The true lane standard peaks, with five extra (artifact) peaks interspersed
+
+	for (i=0; i<ILSSize; i++) {
+
+		if (i % 3 == 1) {
+
+			peak = new DoubleGaussian (0.5 * (ILSTime (ILSSizes [i-1]) + ILSTime (ILSSizes [i])) + random.Noise (20.0), 2.5);
+			peak->SetPeak (300.0 + 200.0 * random.Uniform ());
+			ILSCandidates.Append (peak);
+		}
+
+		peak = new DoubleGaussian (ILSTime (ILSSizes [i]) + random.Noise (1.0), 2.5);
+		peak->SetPeak (800.0 + 400.0 * random.Uniform ());
+		ILSCandidates.Append (peak);
+	}
+}
+
+
+static double BenchILSSearch (int n) {
+
+	int i;
+	int extra = ILSCandidates.Entries () - ILSSize;
+	long before = AnalysisProfiler::GetCounter (AnalysisProfiler::ILSNodesVisited);
+
+	for (i=0; i<n; i++) {
+
+		RecursiveInnerProduct recursion (ILSCandidates, ILSPts, ILSDiffs, NULL, ILSLeftNorm2s, ILSSize, 1500.0, 2);
+		recursion.BuildFromLeft (6, extra, 0.98);
+	}
+
+	return (double)(AnalysisProfiler::GetCounter (AnalysisProfiler::ILSNodesVisited) - before);
+}
+
+
+static CompositeCurve* FitCurve = NULL;
+
+
+static double BenchDigitize (int n) {
+
+	int i;
+	DataSignal* digitized;
+
+	for (i=0; i<n; i++) {
+
+		digitized = FitCurve->Digitize (NumberOfScans, 0.0, 1.0);
+		delete digitized;
+	}
+
+	return (double)n * NumberOfScans;
+}
+
+
+static double* ColorMatrix = NULL;
+static double** RawChannels = NULL;
+static double** CorrectedChannels = NULL;
+
+
+static double BenchColorCorrection (int n) {
+
+	int i;
+
+	for (i=0; i<n; i++)
+		CoreBioComponent::ApplyColorCorrectionMatrix (ColorMatrix, RawChannels, CorrectedChannels, NumberOfChannels, NumberOfScans);
+
+	return (double)n * NumberOfScans * NumberOfChannels;
+}
+
+
+static int* TraceValues = NULL;
+
+
+static double BenchWriteTraceTokens (int n) {
+
+	int i;
+	int j;
+	RGString delim (" ");
+
+	for (i=0; i<n; i++) {
+
+		for (j=0; j<NumberOfScans; j++)
+			*NullText << TraceValues [j] << delim;
+	}
+
+	return (double)n * NumberOfScans;
+}
+
+
+static double BenchWriteTraceArray (int n) {
+
+	int i;
+	RGString delim (" ");
+
+	for (i=0; i<n; i++)
+		NullText->WriteIntArray (TraceValues, NumberOfScans, delim);
+
+	return (double)n * NumberOfScans;
+}
+
+
+static SynonymList* Synonyms = NULL;
+static const int NumberOfSynonyms = 60;
+static const int NumberOfFileNames = 96;
+static RGString FileNames [NumberOfFileNames];
+
+
+static double BenchSynonymSearch (int n) {
+
+	int i;
+	int j;
+	double found = 0.0;
+
+	for (i=0; i<n; i++) {
+
+		for (j=0; j<NumberOfFileNames; j++) {
+
+			if (Synonyms->DoesTargetStringContainASynonymCaseIndep (FileNames [j]))
+				found++;
+		}
+	}
+
+	return (double)n * NumberOfFileNames;
+}
+
+
+static PeakTimeIndex* PeakIndex = NULL;
+static RGDList MergedPeaks;
+static const int PeaksPerChannel = 300;
+static vector<DataSignal*> FollowingPeaks;
+static vector<DataSignal*> PrecedingPeaks;
+
+
+static double BenchPeakNeighbors (int n) {
+
+	int i;
+	int j;
+	double mean;
+	int nPeaks = PeakIndex->GetNumberOfPeaks ();
+	double found = 0.0;
+
+	for (i=0; i<n; i++) {
+
+		for (j=0; j<nPeaks; j++) {
+
+			mean = PeakIndex->GetPeak (j)->GetMean ();
+			PeakIndex->FindCrossChannelNeighbors (j, mean - 10.0, mean + 10.0, FollowingPeaks, PrecedingPeaks);
+			found += FollowingPeaks.size () + PrecedingPeaks.size ();
+		}
+	}
+
+	return (double)n * nPeaks;
+}
+
+
+static void CreateInputs () {
+
+	int i;
+	int j;
+	RGDList curves;
+	DoubleGaussian* peak;
+
+	TraceSignal = CreateSyntheticSignal (11);
+
+	double knotsTime [ILSSize];
+	double knotsBP [ILSSize];
+
+	for (i=0; i<ILSSize; i++) {
+
+		knotsTime [i] = ILSTime (ILSSizes [i]);
+		knotsBP [i] = ILSSizes [i];
+	}
+
+	SizeTransform = new CSplineTransform (knotsTime, knotsBP, ILSSize, true);
+	BenchRandom ladderRandom (23);
+
+	for (i=0; i<ILSSize; i++)
+		SampleILSTimes [i] = knotsTime [i] + ladderRandom.Noise (2.0);
+
+	for (j=0; j<NumberOfLadders; j++) {
+
+		for (i=0; i<ILSSize; i++)
+			LadderILSTimes [j][i] = knotsTime [i] * (1.0 + 0.002 * j) + ladderRandom.Noise (2.0);
+	}
+
+	SplineResults = new double [NumberOfScans];
+	SplineAbscissas = new double [NumberOfScans];
+
+	for (i=0; i<NumberOfScans; i++)
+		SplineAbscissas [i] = (double)i;
+
+	SplineSequenceStart = ceil (knotsTime [0]);
+	SplineSequenceSize = (int) floor (knotsTime [ILSSize - 1] - SplineSequenceStart);
+
+	CreateLMSData ();
+	CreateILSData ();
+
+	for (j=0; j<NumberOfPeaks; j++) {
+
+		peak = new DoubleGaussian (PeakMeans [j], 2.5);
+		peak->SetPeak (PeakHeights [j]);
+		curves.Append (peak);
+	}
+
+	FitCurve = new CompositeCurve (0.0, (double)(NumberOfScans - 1), curves);
+	FitCurve->ProjectNeighboringSignals (1.0, 1.0);
+	curves.Clear ();
+
+	ColorMatrix = new double [NumberOfChannels * NumberOfChannels];
+	RawChannels = new double* [NumberOfChannels + 1];
+	CorrectedChannels = new double* [NumberOfChannels + 1];
+
+	for (i=0; i<NumberOfChannels; i++) {
+
+		for (j=0; j<NumberOfChannels; j++)
+			ColorMatrix [NumberOfChannels * i + j] = (i == j) ? 1.0 : -0.03 * (j + 1);
+	}
+
+	for (i=1; i<=NumberOfChannels; i++) {
+
+		RawChannels [i] = CreateSyntheticTrace (100 + i);
+		CorrectedChannels [i] = new double [NumberOfScans];
+	}
+
+	TraceValues = new int [NumberOfScans];
+
+	for (j=0; j<NumberOfScans; j++)
+		TraceValues [j] = (int) floor (RawChannels [1][j] + 0.5);
+
+	// a lab's control synonyms and a plate of sample file names, a few of which contain one
+
+	char name [64];
+	Synonyms = new SynonymList;
+
+	for (i=0; i<NumberOfSynonyms; i++) {
+
+		sprintf (name, "PosCtrl%02d_Lab", i);
+		Synonyms->AddSynonym (name);
+	}
+
+	for (i=0; i<NumberOfFileNames; i++) {
+
+		if (i % 16 == 0)
+			sprintf (name, "Plate7_%c%02d_poSCTRL%02d_lab_2019-06-11", 'A' + i / 12, i % 12 + 1, i % NumberOfSynonyms);
+
+		else
+			sprintf (name, "Plate7_%c%02d_Sample%04d_2019-06-11", 'A' + i / 12, i % 12 + 1, 1000 + i);
+
+		FileNames [i] = name;
+	}
+
+	// an overloaded sample:  every channel crowded with peaks, merged by mean as for pull-up analysis
+
+	DataSignal* signal;
+
+	for (j=0; j<NumberOfChannels * PeaksPerChannel; j++) {
+
+		signal = new DoubleGaussian (1000.0 + 6000.0 * (double)j / (double)(NumberOfChannels * PeaksPerChannel), 2.5);
+		signal->SetChannel (1 + (j * 7) % NumberOfChannels);
+		MergedPeaks.Append (signal);
+	}
+
+	PeakIndex = new PeakTimeIndex;
+	PeakIndex->Build (MergedPeaks, NumberOfChannels);
+}
+
+
+int main (int argc, char* argv[]) {
+
+	const char* filter = NULL;
+	int i;
+
+	for (i=1; i<argc; i++) {
+
+		if (strcmp (argv [i], "-quick") == 0) {
+
+			MinTrialTime = 0.02;
+			NumberOfTrials = 2;
+		}
+
+		else
+			filter = argv [i];
+	}
+
+	NullText = new RGTextOutput (NULL_DEVICE, FALSE);
+	CreateInputs ();
+
+	char line [256];
+	sprintf (line, "%-44s %10s %14s %14s", "Benchmark", "Ops", "ns/op", "Throughput");
+	cout << line << endl;
+
+	RunBenchmark ("STRTracePrequalification::ResetSearch", "samples", BenchResetSearch, filter);
+	RunBenchmark ("DoubleGaussian::FindCharacteristic (channel)", "peaks", BenchFitChannel, filter);
+	RunBenchmark ("SampledData moments", "windows", BenchMoments, filter);
+	RunBenchmark ("CSplineTransform::EvaluateWithExtrapolation", "points", BenchSplineEvaluate, filter);
+	RunBenchmark ("CSplineTransform::EvaluateFullSequence", "points", BenchSplineSequence, filter);
+	RunBenchmark ("CSplineTransform::EvaluateSorted", "points", BenchSplineSorted, filter);
+	RunBenchmark ("CSplineTransform (factory) ladder matching", "ladders", BenchLadderMatching, filter);
+	RunBenchmark ("LeastMedianOfSquares1D::CalculateLMS", "points", BenchLMS1D, filter);
+	RunBenchmark ("LeastMedianOfSquares2DExhaustive::CalculateLMS", "points", BenchLMS2DExhaustive, filter);
+	RunBenchmark ("QuadraticLMSExact::CalculateLMS", "points", BenchQuadraticLMS, filter);
+	RunBenchmark ("RecursiveInnerProduct::BuildFromLeft (ILS)", "nodes", BenchILSSearch, filter);
+	RunBenchmark ("CompositeCurve::Digitize", "samples", BenchDigitize, filter);
+	RunBenchmark ("CoreBioComponent::ApplyColorCorrectionMatrix", "samples", BenchColorCorrection, filter);
+	RunBenchmark ("RGTextOutput operator<< (trace)", "values", BenchWriteTraceTokens, filter);
+	RunBenchmark ("RGTextOutput::WriteIntArray (trace)", "values", BenchWriteTraceArray, filter);
+	RunBenchmark ("SynonymList::DoesTargetStringContain...", "names", BenchSynonymSearch, filter);
+	RunBenchmark ("PeakTimeIndex::FindCrossChannelNeighbors", "peaks", BenchPeakNeighbors, filter);
+
+	delete PeakIndex;
+	MergedPeaks.ClearAndDelete ();
+	delete Synonyms;
+	delete FitCurve;
+	delete SizeTransform;
+	delete TraceSignal;
+	delete NullText;
+	return 0;
+}
+
@@ -0,0 +1,260 @@
+#!/bin/bash
+#
+# Golden output regression test with performance deltas.  Each run folder in the corpus is analyzed with
+# TestAnalysisDirectoryLC; its .oar and .plt files are compared with the goldens by CompareAnalysisOutput (numbers
+# within tolerance, volatile and machine dependent elements ignored), and its analysis time, CPU time and peak memory,
+# from the run's Profile.tab, are reported against the baseline recorded with the goldens.  A run without a Profile.tab,
+# as from a binary built before profiling, is still compared or recorded; its performance columns are left blank.
+#
+# usage:  RegressionBench.sh [-record] [-corpus file] [-golden dir] [-work dir] [-rtol x] [-atol x] [-ignore names] [name ...]
+#
+#   -record  analyze the corpus and store the outputs and performance as the new goldens and baseline
+#   -corpus  corpus file (default RegressionCorpus.txt next to this script; its header describes the format)
+#   -golden  golden directory (default golden next to this script, so the goldens outlive the work directory)
+#   -work    scratch directory for inputs, reports and comparisons (default /tmp/OsirisRegressionBench)
+#   -rtol, -atol, -ignore  passed to CompareAnalysisOutput
+#   name     restrict the run to the named corpus entries
+#
+# COMPARE, GENERATOR and ANALYSIS override the locations of CompareAnalysisOutput, GenerateRunFolder and
+# TestAnalysisDirectoryLC.  The exit status is nonzero if any folder fails or differs from its golden, and 2, before
+# anything is analyzed, if there are no goldens at all.
+#
+
+BENCHDIR=$(cd "$(dirname "$0")" && pwd)
+OSIRISDIR=$(dirname "$BENCHDIR")
+COMPARE=${COMPARE:-$BENCHDIR/bin/CompareAnalysisOutput}
+GENERATOR=${GENERATOR:-$BENCHDIR/bin/GenerateRunFolder}
+ANALYSIS=${ANALYSIS:-$OSIRISDIR/TestAnalysisDirectoryLCv2.11/bin/TestAnalysisDirectoryLC}
+
+RECORD=0
+CORPUS=$BENCHDIR/RegressionCorpus.txt
+WORK=/tmp/OsirisRegressionBench
+GOLDEN=
+RTOL=1e-6
+ATOL=1e-6
+
+# Paths and creation times depend on where and when the goldens were made
+
+IGNORE=CreationTime,FileName,argv,inputDirectory,outputDirectory,associatedLadder
+ONLY=
+
+while [ $# -gt 0 ]; do
+  case "$1" in
+    -record) RECORD=1; shift ;;
+    -corpus) CORPUS="$2"; shift 2 ;;
+    -golden) GOLDEN="$2"; shift 2 ;;
+    -work) WORK="$2"; shift 2 ;;
+    -rtol) RTOL="$2"; shift 2 ;;
+    -atol) ATOL="$2"; shift 2 ;;
+    -ignore) IGNORE="$2"; shift 2 ;;
+    *) ONLY="$ONLY $1"; shift ;;
+  esac
+done
+
+GOLDEN=${GOLDEN:-$BENCHDIR/golden}
+
+for x in "$COMPARE" "$ANALYSIS"; do
+  if [ ! -x "$x" ]; then
+    echo "Cannot find $x; build it first" >&2
+    exit 1
+  fi
+done
+
+if [ ! -f "$CORPUS" ]; then
+  echo "Cannot find corpus $CORPUS" >&2
+  exit 1
+fi
+
+# The goldens hold absolute paths of the machine they were made on, so they are recorded locally, not kept in git
+
+if [ $RECORD -eq 0 ] && [ -z "$(ls -A "$GOLDEN" 2>/dev/null)" ]; then
+  echo "No goldens in $GOLDEN; run with -record (make regress REGRESSFLAGS=-record) against the baseline build first" >&2
+  exit 2
+fi
+
+trim () {
+  local s="$1"
+  s="${s#"${s%%[![:space:]]*}"}"
+  echo "${s%"${s##*[![:space:]]}"}"
+}
+
+# delta <new> <baseline>:  percent change, or blank without a baseline
+
+delta () {
+  awk -v a="$1" -v b="$2" 'BEGIN { if (a == "" || b == "" || b + 0 == 0) printf "%8s", ""; else printf "%+7.1f%%", 100.0 * (a - b) / b }'
+}
+
+# cell <value> <format>:  the value in the format, or blank if there is none
+
+cell () {
+  awk -v v="$1" -v f="$2" 'BEGIN { if (v == "") printf "%" (substr(f, 2) + 0) "s", ""; else printf f, v }'
+}
+
+# make_input <template> <overrides> <output>:  copies the input file template, replacing or adding the "Key = value"
+# lines given (tab separated) in the overrides file, before the terminating ";" line
+
+make_input () {
+  awk -v overrides="$2" '
+    BEGIN {
+      while ((getline line < overrides) > 0) {
+        split(line, kv, "\t")
+        if (!(kv[1] in value)) order[++n] = kv[1]
+        value[kv[1]] = kv[2]
+      }
+    }
+    function flush(  i) {
+      for (i = 1; i <= n; i++)
+        if (!(order[i] in used)) print order[i] " = " value[order[i]] ";"
+      done = 1
+    }
+    { sub(/\r$/, "") }
+    /^[ \t]*;[ \t]*$/ { flush(); print; exit }
+    {
+      eq = index($0, "=")
+      key = (eq > 0) ? substr($0, 1, eq - 1) : ""
+      gsub(/^[ \t]+|[ \t]+$/, "", key)
+      if (key in value) { print key " = " value[key] ";"; used[key] = 1 }
+      else print
+    }
+    END { if (!done) { flush(); print ";" } }' "$1" > "$3"
+}
+
+mkdir -p "$WORK/inputs" "$WORK/reports" "$WORK/data" "$WORK/compare"
+printf "%-20s %-12s %10s %8s %10s %8s %12s %8s\n" Folder Result "Time(s)" "" "CPU(s)" "" "PeakMem(MB)" ""
+failures=0
+
+while IFS='|' read -r name template settings; do
+  name=$(trim "$name")
+  template=$(trim "$template")
+
+  case "$name" in
+    ''|'#'*) continue ;;
+  esac
+
+  if [ -n "$ONLY" ] && [[ " $ONLY " != *" $name "* ]]; then
+    continue
+  fi
+
+  case "$template" in
+    /*) ;;
+    *) template="$OSIRISDIR/$template" ;;
+  esac
+
+  overrides="$WORK/inputs/$name.overrides"
+  report="$WORK/reports/$name"
+  rm -rf "$report"
+  {
+    printf "LadderDirectory\t%s\n" "$OSIRISDIR/OsirisXML"
+    printf "MessageBook\t%s\n" "$OSIRISDIR/MessageBook/OsirisMessageBookV4.0.xml"
+  } > "$overrides"
+  status=0
+  IFS=';' read -ra pairs <<< "$settings"
+
+  for pair in "${pairs[@]}"; do
+    key=$(trim "${pair%%=*}")
+    value=$(trim "${pair#*=}")
+    value=${value//\$OSIRIS/$OSIRISDIR}
+
+    case "$key" in
+      '') ;;
+      Config)
+        printf "StandardSettings\t%s\n" "$OSIRISDIR/OsirisXML/NamedxmlConfigurations/$value/${value}_StdSettings.xml" >> "$overrides"
+        printf "LabSettings\t%s\n" "$OSIRISDIR/OsirisXML/NamedxmlConfigurations/$value/${value}_LabSettings.xml" >> "$overrides" ;;
+      Generate)
+        rm -rf "$WORK/data/$name"
+        eval "set -- $value"
+        "$GENERATOR" -ladderdir "$OSIRISDIR/OsirisXML" -out "$WORK/data/$name" "$@" < /dev/null > "$WORK/data/$name.log" 2>&1 || status=$?
+        printf "InputDirectory\t%s\n" "$WORK/data/$name" >> "$overrides" ;;
+      *)
+        printf "%s\t%s\n" "$key" "$value" >> "$overrides" ;;
+    esac
+  done
+
+  # later lines override earlier ones:  the corpus overrides the defaults above, and reports always go to the work directory
+
+  printf "ReportDirectory\t%s\n" "$report" >> "$overrides"
+  make_input "$template" "$overrides" "$WORK/inputs/$name.txt"
+
+  if [ $status -eq 0 ]; then
+    "$ANALYSIS" < "$WORK/inputs/$name.txt" > "$WORK/reports/$name.log" 2>&1 || status=$?
+  fi
+
+  # the outputs are found by the .oar, so a run without a Profile.tab is still compared
+
+  oar=$(find "$report" -name '*.oar' 2>/dev/null | head -1)
+
+  if [ $status -ne 0 ] || [ -z "$oar" ]; then
+    printf "%-20s %-12s see %s\n" "$name" "FAILED($status)" "$WORK/reports/$name.log"
+    failures=$((failures + 1))
+    continue
+  fi
+
+  outdir=$(dirname "$oar")
+  profile=$(find "$outdir" -name '*Profile.tab' 2>/dev/null | head -1)
+  elapsed= ; cpu= ; peak=
+
+  if [ -n "$profile" ]; then
+    read -r elapsed cpu peak < <(awk -F'\t' '$1 == "Run Total" { print $3, $4, $NF }' "$profile")
+  fi
+
+  if [ $RECORD -eq 1 ]; then
+    rm -rf "$GOLDEN/$name"
+    mkdir -p "$GOLDEN/$name"
+    (cd "$outdir" && find . -name '*.oar' -o -name '*.plt') | while read -r f; do
+      mkdir -p "$GOLDEN/$name/$(dirname "$f")"
+      cp "$outdir/$f" "$GOLDEN/$name/$f"
+    done
+
+    if [ -n "$elapsed" ]; then
+      echo "$elapsed $cpu $peak" > "$GOLDEN/$name/baseline.txt"
+    fi
+
+    result=recorded
+    baseElapsed= ; baseCPU= ; basePeak=
+  else
+    result=ok
+    differing=0
+    : > "$WORK/compare/$name.txt"
+
+    if [ ! -d "$GOLDEN/$name" ]; then
+      result=NO-GOLDEN
+      failures=$((failures + 1))
+    else
+      while read -r f; do
+        if [ ! -f "$outdir/$f" ]; then
+          echo "$f:  missing" >> "$WORK/compare/$name.txt"
+          differing=$((differing + 1))
+        elif ! { echo "$f:"; "$COMPARE" -rtol "$RTOL" -atol "$ATOL" -ignore "$IGNORE" "$GOLDEN/$name/$f" "$outdir/$f"; } >> "$WORK/compare/$name.txt" 2>&1; then
+          differing=$((differing + 1))
+        fi
+      done < <(cd "$GOLDEN/$name" && find . -name '*.oar' -o -name '*.plt')
+
+      while read -r f; do
+        if [ ! -f "$GOLDEN/$name/$f" ]; then
+          echo "$f:  not in golden" >> "$WORK/compare/$name.txt"
+          differing=$((differing + 1))
+        fi
+      done < <(cd "$outdir" && find . -name '*.oar' -o -name '*.plt')
+
+      if [ $differing -gt 0 ]; then
+        result="DIFF($differing)"
+        failures=$((failures + 1))
+      fi
+    fi
+
+    baseElapsed= ; baseCPU= ; basePeak=
+
+    if [ -f "$GOLDEN/$name/baseline.txt" ]; then
+      read -r baseElapsed baseCPU basePeak < "$GOLDEN/$name/baseline.txt"
+    fi
+  fi
+
+  peakMB=$( [ -n "$peak" ] && awk -v k="$peak" 'BEGIN { print k / 1024.0 }')
+  printf "%-20s %-12s %s %8s %s %8s %s %8s\n" "$name" "$result" "$(cell "$elapsed" %10.2f)" "$(delta "$elapsed" "$baseElapsed")" \
+    "$(cell "$cpu" %10.2f)" "$(delta "$cpu" "$baseCPU")" "$(cell "$peakMB" %12.1f)" "$(delta "$peak" "$basePeak")"
+done < "$CORPUS"
+
+if [ $failures -gt 0 ]; then
+  echo "$failures folder(s) failed or differ from the goldens; details in $WORK/compare and $WORK/reports"
+  exit 1
+fi
@@ -0,0 +1,98 @@
+#!/bin/bash
+#
+# End to end throughput benchmark.  For each folder size (default 96, 384 and 1536 files) a synthetic run folder
+# is generated with GenerateRunFolder -- one ladder, one positive and one negative control per 96 well plate, the
+# rest samples -- and analyzed with TestAnalysisDirectoryLC.  Reported per folder:  process wall time, analysis
+# time and CPU time from the run's Profile.tab, files per second and peak resident memory.
+#
+# usage:  RunFolderBench.sh [-kit name] [-ils name] [-config dir] [-work dir] [-seed n] [size ...]
+#
+#   -config  directory under OsirisXML/NamedxmlConfigurations with the kit's _StdSettings.xml and _LabSettings.xml
+#   -work    scratch directory for run folders and reports (default /tmp/OsirisRunFolderBench)
+#
+# GENERATOR and ANALYSIS override the locations of GenerateRunFolder and TestAnalysisDirectoryLC.
+#
+
+set -o errexit
+
+BENCHDIR=$(cd "$(dirname "$0")" && pwd)
+OSIRISDIR=$(dirname "$BENCHDIR")
+GENERATOR=${GENERATOR:-$BENCHDIR/bin/GenerateRunFolder}
+ANALYSIS=${ANALYSIS:-$OSIRISDIR/TestAnalysisDirectoryLCv2.11/bin/TestAnalysisDirectoryLC}
+
+KIT=Identifiler
+ILS=ABI-LIZ450
+CONFIG=ID
+WORK=/tmp/OsirisRunFolderBench
+SEED=1
+SIZES=
+
+while [ $# -gt 0 ]; do
+  case "$1" in
+    -kit) KIT="$2"; shift 2 ;;
+    -ils) ILS="$2"; shift 2 ;;
+    -config) CONFIG="$2"; shift 2 ;;
+    -work) WORK="$2"; shift 2 ;;
+    -seed) SEED="$2"; shift 2 ;;
+    *) SIZES="$SIZES $1"; shift ;;
+  esac
+done
+
+SIZES=${SIZES:-96 384 1536}
+XMLDIR=$OSIRISDIR/OsirisXML
+CONFIGDIR=$XMLDIR/NamedxmlConfigurations/$CONFIG
+
+for x in "$GENERATOR" "$ANALYSIS"; do
+  if [ ! -x "$x" ]; then
+    echo "Cannot find $x; build it first" >&2
+    exit 1
+  fi
+done
+
+mkdir -p "$WORK/reports"
+printf "%-8s %8s %10s %12s %10s %10s %14s\n" Files Plates "Wall(s)" "Analysis(s)" "CPU(s)" "Files/s" "PeakMemory(MB)"
+
+for n in $SIZES; do
+  plates=$(( (n + 95) / 96 ))
+  folder="$WORK/Synthetic$n"
+  rm -rf "$folder" "$WORK/reports/Synthetic$n"
+  "$GENERATOR" -ladderdir "$XMLDIR" -kit "$KIT" -ils "$ILS" -out "$folder" -seed "$SEED" \
+    -ladders $plates -pos $plates -neg $plates -samples $(( n - 3 * plates )) > /dev/null
+
+  cat > "$WORK/input$n.txt" <<EOF
+InputDirectory = $folder;
+LadderDirectory = $XMLDIR;
+ReportDirectory = $WORK/reports;
+MarkerSetName = $KIT;
+LaneStandardName = $ILS;
+CriticalOutputLevel = 15;
+StandardSettings = $CONFIGDIR/${CONFIG}_StdSettings.xml;
+LabSettings = $CONFIGDIR/${CONFIG}_LabSettings.xml;
+MessageBook = $OSIRISDIR/MessageBook/OsirisMessageBookV4.0.xml;
+MinSampleRFU = 150.;
+MinLaneStandardRFU = 150.;
+MinLadderRFU = 150.;
+MinInterlocusRFU = 150.;
+MinLadderInterlocusRFU = 150.;
+SampleDetectionThreshold = 150.;
+RawDataString = R;
+;
+EOF
+
+  start=$(date +%s.%N)
+  status=0
+  "$ANALYSIS" < "$WORK/input$n.txt" > "$WORK/log$n.txt" 2>&1 || status=$?
+  end=$(date +%s.%N)
+  profile="$WORK/reports/Synthetic$n/Synthetic${n}Profile.tab"
+
+  if [ $status -ne 0 ] || [ ! -f "$profile" ]; then
+    echo "Analysis of $n files failed with status $status; see $WORK/log$n.txt" >&2
+    exit 1
+  fi
+
+  # the Run Total row holds elapsed and CPU time in columns 3 and 4 and peak memory (KB) in the last column
+
+  awk -F'\t' -v n=$n -v plates=$plates -v start=$start -v end=$end '$1 == "Run Total" {
+    printf "%-8d %8d %10.2f %12.2f %10.2f %10.2f %14.1f\n", n, plates, end - start, $3, $4, n / $3, $NF / 1024.0
+  }' "$profile"
+done
@@ -0,0 +1,354 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: AnalysisProfiler.cpp
+*
+*/
+//
+//  class AnalysisProfiler accumulates wall clock time by analysis stage and a small set of work counters, per sample and per run,
+//  and writes them as a tab delimited table next to the .oar file.  Stage times are exclusive:  when a ProfileTimer is nested
+//  inside another, the outer stage is suspended until the inner one ends, so the stage times for a sample add up to its elapsed time.
+//  Each row ends with the process's peak resident memory so far.
+//  class ProfileTimer is the scoped timer used at stage boundaries
+//
+
+#include "AnalysisProfiler.h"
+#include "AnalysisTrace.h"
+#include "RGTextOutput.h"
+#include <time.h>
+
+#ifdef _WIN32
+#include <sys/timeb.h>
+#include <windows.h>
+#include <psapi.h>
+#pragma comment (lib, "psapi.lib")
+#else
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+
+RGTextOutput* AnalysisProfiler::ProfileFile = NULL;
+int AnalysisProfiler::CurrentStage = AnalysisProfiler::Setup;
+double AnalysisProfiler::StageStartTime = 0.0;
+bool AnalysisProfiler::SampleIsOpen = false;
+RGString AnalysisProfiler::SampleName;
+RGString AnalysisProfiler::SampleType;
+double AnalysisProfiler::SampleStartTime = 0.0;
+double AnalysisProfiler::SampleStartCPU = 0.0;
+double AnalysisProfiler::RunStartTime = 0.0;
+double AnalysisProfiler::RunStartCPU = 0.0;
+int AnalysisProfiler::NumberOfSamples = 0;
+
+double AnalysisProfiler::SampleTimes [AnalysisProfiler::NumberOfStages];
+double AnalysisProfiler::RunTimes [AnalysisProfiler::NumberOfStages];
+long AnalysisProfiler::SampleCounters [AnalysisProfiler::NumberOfCounters];
+long AnalysisProfiler::RunCounters [AnalysisProfiler::NumberOfCounters];
+
+
+bool AnalysisProfiler :: StartRun (const RGString& reportDirectory, const RGString& baseName) {
+
+	int i;
+	delete ProfileFile;
+	ProfileFile = new RGTextOutput (reportDirectory + "/" + baseName + "Profile.tab", FALSE);
+
+	if (!ProfileFile->FileIsValid ()) {
+
+		delete ProfileFile;
+		ProfileFile = NULL;
+	}
+
+	for (i=0; i<NumberOfStages; i++) {
+
+		SampleTimes [i] = 0.0;
+		RunTimes [i] = 0.0;
+	}
+
+	for (i=0; i<NumberOfCounters; i++) {
+
+		SampleCounters [i] = 0;
+		RunCounters [i] = 0;
+	}
+
+	SampleIsOpen = false;
+	NumberOfSamples = 0;
+	CurrentStage = Setup;
+	RunStartTime = StageStartTime = GetWallTime ();
+	RunStartCPU = GetCPUTime ();
+	AnalysisTrace::Open (reportDirectory + "/" + baseName + "Trace.json");
+
+	if (ProfileFile == NULL)
+		return false;
+
+	WriteHeader ();
+	return true;
+}
+
+
+void AnalysisProfiler :: EndRun () {
+
+	int i;
+	EndSample ();
+	ChargeCurrentStage ();
+
+	// Counts made outside of any sample (e.g., while setting up) still belong to the run
+
+	for (i=0; i<NumberOfCounters; i++) {
+
+		RunCounters [i] += SampleCounters [i];
+		SampleCounters [i] = 0;
+	}
+
+	AnalysisTrace::Close ();
+
+	if (ProfileFile == NULL)
+		return;
+
+	RGString name ("Run Total");
+	RGString type;
+	type << "Run (" << NumberOfSamples << " files)";
+	WriteRow (name, type, GetWallTime () - RunStartTime, GetCPUTime () - RunStartCPU, RunTimes, RunCounters);
+	delete ProfileFile;
+	ProfileFile = NULL;
+}
+
+
+void AnalysisProfiler :: StartSample (const RGString& sampleName, const char* sampleType) {
+
+	int i;
+	EndSample ();
+	ChargeCurrentStage ();
+
+	for (i=0; i<NumberOfCounters; i++) {
+
+		RunCounters [i] += SampleCounters [i];
+		SampleCounters [i] = 0;
+	}
+
+	for (i=0; i<NumberOfStages; i++)
+		SampleTimes [i] = 0.0;
+
+	SampleName = sampleName;
+	SampleType = sampleType;
+	SampleIsOpen = true;
+	SampleStartTime = StageStartTime;
+	SampleStartCPU = GetCPUTime ();
+	AnalysisTrace::Begin (sampleName, "sample", "type", SampleType);
+}
+
+
+void AnalysisProfiler :: EndSample () {
+
+	int i;
+
+	if (!SampleIsOpen)
+		return;
+
+	ChargeCurrentStage ();
+	AnalysisTrace::End ();
+	SampleIsOpen = false;
+	NumberOfSamples++;
+
+	if (ProfileFile != NULL)
+		WriteRow (SampleName, SampleType, StageStartTime - SampleStartTime, GetCPUTime () - SampleStartCPU, SampleTimes, SampleCounters);
+
+	for (i=0; i<NumberOfCounters; i++) {
+
+		RunCounters [i] += SampleCounters [i];
+		SampleCounters [i] = 0;
+	}
+}
+
+
+int AnalysisProfiler :: EnterStage (int stage) {
+
+	int previous = CurrentStage;
+	ChargeCurrentStage ();
+	CurrentStage = stage;
+	AnalysisTrace::Begin (GetStageName (stage), "stage");
+	return previous;
+}
+
+
+void AnalysisProfiler :: ExitStage (int previousStage) {
+
+	ChargeCurrentStage ();
+	AnalysisTrace::End ();
+	CurrentStage = previousStage;
+}
+
+
+double AnalysisProfiler :: GetWallTime () {
+
+#ifdef _WIN32
+	struct _timeb tb;
+	_ftime_s (&tb);
+	return (double)tb.time + 0.001 * (double)tb.millitm;
+#else
+	struct timeval tv;
+	gettimeofday (&tv, NULL);
+	return (double)tv.tv_sec + 1.0e-6 * (double)tv.tv_usec;
+#endif
+}
+
+
+double AnalysisProfiler :: GetCPUTime () {
+
+	// On Windows, clock () measures elapsed time rather than processor time
+
+	return (double)clock () / (double)CLOCKS_PER_SEC;
+}
+
+
+long AnalysisProfiler :: GetPeakMemory () {
+
+	// Peak resident set size (peak working set on Windows) in kilobytes
+
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (!GetProcessMemoryInfo (GetCurrentProcess (), &counters, sizeof (counters)))
+		return 0;
+
+	return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+	struct rusage usage;
+
+	if (getrusage (RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+#ifdef __APPLE__
+	return (long)(usage.ru_maxrss / 1024);
+#else
+	return (long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+
+const char* AnalysisProfiler :: GetStageName (int stage) {
+
+	switch (stage) {
+
+	case Setup:
+		return "Setup";
+
+	case ReadInput:
+		return "ReadInput";
+
+	case PeakFitting:
+		return "PeakFitting";
+
+	case ILSAnalysis:
+		return "ILSAnalysis";
+
+	case Normalization:
+		return "Normalization";
+
+	case PullupAnalysis:
+		return "PullupAnalysis";
+
+	case LadderMatching:
+		return "LadderMatching";
+
+	case LocusAnalysis:
+		return "LocusAnalysis";
+
+	case CallsAndQuality:
+		return "CallsAndQuality";
+
+	case MessageEvaluation:
+		return "MessageEvaluation";
+
+	case OutputWriting:
+		return "OutputWriting";
+	}
+
+	return "Unknown";
+}
+
+
+const char* AnalysisProfiler :: GetCounterName (int counter) {
+
+	switch (counter) {
+
+	case PeaksFitted:
+		return "PeaksFitted";
+
+	case FindCharacteristicCalls:
+		return "FindCharacteristicCalls";
+
+	case LMSFits:
+		return "LMSFits";
+
+	case ILSNodesVisited:
+		return "ILSNodesVisited";
+	}
+
+	return "Unknown";
+}
+
+
+void AnalysisProfiler :: ChargeCurrentStage () {
+
+	double now = GetWallTime ();
+	double elapsed = now - StageStartTime;
+	StageStartTime = now;
+	RunTimes [CurrentStage] += elapsed;
+
+	if (SampleIsOpen)
+		SampleTimes [CurrentStage] += elapsed;
+}
+
+
+void AnalysisProfiler :: WriteHeader () {
+
+	int i;
+	*ProfileFile << "Name\tType\tElapsed\tCPU";
+
+	for (i=0; i<NumberOfStages; i++)
+		*ProfileFile << "\t" << GetStageName (i);
+
+	for (i=0; i<NumberOfCounters; i++)
+		*ProfileFile << "\t" << GetCounterName (i);
+
+	*ProfileFile << "\tPeakMemoryKB\n";
+}
+
+
+void AnalysisProfiler :: WriteRow (const RGString& name, const RGString& type, double elapsed, double cpu, const double* times, const long* counters) {
+
+	int i;
+	*ProfileFile << name << "\t" << type << "\t" << elapsed << "\t" << cpu;
+
+	for (i=0; i<NumberOfStages; i++)
+		*ProfileFile << "\t" << times [i];
+
+	for (i=0; i<NumberOfCounters; i++)
+		*ProfileFile << "\t" << counters [i];
+
+	*ProfileFile << "\t" << GetPeakMemory () << "\n";
+}
+
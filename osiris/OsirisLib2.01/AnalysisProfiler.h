@@ -0,0 +1,110 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: AnalysisProfiler.h
+*
+*/
+//
+//  class AnalysisProfiler accumulates wall clock time by analysis stage and a small set of work counters, per sample and per run,
+//  and writes them as a tab delimited table, <output>Profile.tab, next to the .oar file.  Stage times are exclusive:  when a ProfileTimer is nested
+//  inside another, the outer stage is suspended until the inner one ends, so the stage times for a sample add up to its elapsed time.
+//  Each row ends with the process's peak resident memory so far.
+//  class ProfileTimer is the scoped timer used at stage boundaries
+//
+
+#ifndef _ANALYSISPROFILER_H_
+#define _ANALYSISPROFILER_H_
+
+#include "rgstring.h"
+
+class RGTextOutput;
+
+
+class AnalysisProfiler {
+
+public:
+	enum ProfileStage { Setup, ReadInput, PeakFitting, ILSAnalysis, Normalization, PullupAnalysis, LadderMatching, LocusAnalysis,
+		CallsAndQuality, MessageEvaluation, OutputWriting, NumberOfStages };
+
+	enum ProfileCounter { PeaksFitted, FindCharacteristicCalls, LMSFits, ILSNodesVisited, NumberOfCounters };
+
+	static bool StartRun (const RGString& reportDirectory, const RGString& baseName);
+	static void EndRun ();
+
+	static void StartSample (const RGString& sampleName, const char* sampleType);
+	static void EndSample ();
+
+	static int EnterStage (int stage);
+	static void ExitStage (int previousStage);
+	static int GetCurrentStage () { return CurrentStage; }
+
+	static void Count (int counter) { SampleCounters [counter]++; }
+	static void Count (int counter, long n) { SampleCounters [counter] += n; }
+	static long GetCounter (int counter) { return SampleCounters [counter] + RunCounters [counter]; }
+
+	static double GetWallTime ();
+	static double GetCPUTime ();
+	static long GetPeakMemory ();
+
+	static const char* GetStageName (int stage);
+	static const char* GetCounterName (int counter);
+
+protected:
+	static RGTextOutput* ProfileFile;
+	static int CurrentStage;
+	static double StageStartTime;
+	static bool SampleIsOpen;
+	static RGString SampleName;
+	static RGString SampleType;
+	static double SampleStartTime;
+	static double SampleStartCPU;
+	static double RunStartTime;
+	static double RunStartCPU;
+	static int NumberOfSamples;
+
+	static double SampleTimes [NumberOfStages];
+	static double RunTimes [NumberOfStages];
+	static long SampleCounters [NumberOfCounters];
+	static long RunCounters [NumberOfCounters];
+
+	static void ChargeCurrentStage ();
+	static void WriteHeader ();
+	static void WriteRow (const RGString& name, const RGString& type, double elapsed, double cpu, const double* times, const long* counters);
+};
+
+
+class ProfileTimer {
+
+public:
+	ProfileTimer (int stage) { mPreviousStage = AnalysisProfiler::EnterStage (stage); }
+	~ProfileTimer () { AnalysisProfiler::ExitStage (mPreviousStage); }
+
+protected:
+	int mPreviousStage;
+};
+
+
+#endif  /*  _ANALYSISPROFILER_H_  */
+
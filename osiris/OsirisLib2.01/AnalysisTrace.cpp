@@ -0,0 +1,174 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: AnalysisTrace.cpp
+*
+*/
+//
+//  class AnalysisTrace is an opt-in timeline recorder for analysis runs.  Events are written as they occur, as "B" and "E"
+//  (begin/end) records, so nesting in the timeline follows the nesting of the timers in the code.  Timestamps are in
+//  microseconds from the time the trace file was opened.  The thread id is fixed at 1 for now; a worker would call SetThreadID
+//  to place its spans on a separate track
+//
+
+#include "AnalysisTrace.h"
+#include "AnalysisProfiler.h"
+#include "RGTextOutput.h"
+#include <stdio.h>
+#include <iostream>
+
+using namespace std;
+
+
+bool AnalysisTrace::Enabled = false;
+RGTextOutput* AnalysisTrace::TraceFile = NULL;
+double AnalysisTrace::StartTime = 0.0;
+int AnalysisTrace::NumberOfEvents = 0;
+int AnalysisTrace::ThreadID = 1;
+
+
+bool AnalysisTrace :: Open (const RGString& fullPathTraceName) {
+
+	Close ();
+
+	if (!Enabled)
+		return false;
+
+	TraceFile = new RGTextOutput (fullPathTraceName, FALSE);
+
+	if (!TraceFile->FileIsValid ()) {
+
+		cout << "Could not open timeline trace file:  " << fullPathTraceName << endl;
+		delete TraceFile;
+		TraceFile = NULL;
+		return false;
+	}
+
+	StartTime = AnalysisProfiler::GetWallTime ();
+	NumberOfEvents = 0;
+	*TraceFile << "{\"traceEvents\":[\n";
+	*TraceFile << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ThreadID << ",\"args\":{\"name\":\"OSIRIS analysis\"}}";
+	NumberOfEvents++;
+	return true;
+}
+
+
+void AnalysisTrace :: Close () {
+
+	if (TraceFile == NULL)
+		return;
+
+	*TraceFile << "\n],\n\"displayTimeUnit\":\"ms\"}\n";
+	delete TraceFile;
+	TraceFile = NULL;
+}
+
+
+void AnalysisTrace :: Begin (const char* name, const char* category) {
+
+	if (TraceFile == NULL)
+		return;
+
+	WriteEventStart ("B");
+	*TraceFile << ",\"name\":\"";
+	WriteEscaped (name);
+	*TraceFile << "\",\"cat\":\"" << category << "\"}";
+}
+
+
+void AnalysisTrace :: Begin (const char* name, const char* category, const char* argName, int argValue) {
+
+	if (TraceFile == NULL)
+		return;
+
+	WriteEventStart ("B");
+	*TraceFile << ",\"name\":\"";
+	WriteEscaped (name);
+	*TraceFile << "\",\"cat\":\"" << category << "\",\"args\":{\"" << argName << "\":" << argValue << "}}";
+}
+
+
+void AnalysisTrace :: Begin (const RGString& name, const char* category, const char* argName, const RGString& argValue) {
+
+	if (TraceFile == NULL)
+		return;
+
+	WriteEventStart ("B");
+	*TraceFile << ",\"name\":\"";
+	WriteEscaped (name.GetData ());
+	*TraceFile << "\",\"cat\":\"" << category << "\",\"args\":{\"" << argName << "\":\"";
+	WriteEscaped (argValue.GetData ());
+	*TraceFile << "\"}}";
+}
+
+
+void AnalysisTrace :: End () {
+
+	if (TraceFile == NULL)
+		return;
+
+	WriteEventStart ("E");
+	*TraceFile << "}";
+}
+
+
+void AnalysisTrace :: WriteEventStart (const char* phase) {
+
+	double ts = 1.0e6 * (AnalysisProfiler::GetWallTime () - StartTime);
+
+	if (NumberOfEvents > 0)
+		*TraceFile << ",\n";
+
+	*TraceFile << "{\"ph\":\"" << phase << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << ThreadID;
+	NumberOfEvents++;
+}
+
+
+void AnalysisTrace :: WriteEscaped (const char* text) {
+
+	//  File names may contain characters that are not legal in a JSON string
+
+	RGString escaped;
+	char buffer [8];
+	const char* p;
+
+	for (p = text; *p != '\0'; p++) {
+
+		if ((*p == '"') || (*p == '\\'))
+			escaped << "\\" << *p;
+
+		else if ((unsigned char)*p < 0x20) {
+
+			sprintf (buffer, "\\u%04x", (unsigned int)(unsigned char)*p);
+			escaped << buffer;
+		}
+
+		else
+			escaped << *p;
+	}
+
+	*TraceFile << escaped;
+}
+
@@ -0,0 +1,95 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: AnalysisTrace.h
+*
+*/
+//
+//  class AnalysisTrace is an opt-in timeline recorder for analysis runs.  When enabled (input line "TraceTimeline = true"),
+//  each sample, each analysis stage timed by a ProfileTimer and each per-channel step marked with a TraceSpan is written as a
+//  begin/end event pair in Chrome Trace Event JSON format, to <output>Trace.json next to the .oar.  The file can be opened
+//  offline with Perfetto (ui.perfetto.dev) or chrome://tracing.  When not enabled, all calls return immediately.
+//
+
+#ifndef _ANALYSISTRACE_H_
+#define _ANALYSISTRACE_H_
+
+#include "rgstring.h"
+
+class RGTextOutput;
+
+
+class AnalysisTrace {
+
+public:
+	static void SetEnabled (bool enable) { Enabled = enable; }
+	static bool IsEnabled () { return Enabled; }
+	static bool IsRecording () { return (TraceFile != NULL); }
+
+	static bool Open (const RGString& fullPathTraceName);
+	static void Close ();
+
+	static void SetThreadID (int id) { ThreadID = id; }
+	static int GetThreadID () { return ThreadID; }
+
+	static void Begin (const char* name, const char* category);
+	static void Begin (const char* name, const char* category, const char* argName, int argValue);
+	static void Begin (const RGString& name, const char* category, const char* argName, const RGString& argValue);
+	static void End ();
+
+protected:
+	static bool Enabled;
+	static RGTextOutput* TraceFile;
+	static double StartTime;
+	static int NumberOfEvents;
+	static int ThreadID;
+
+	static void WriteEventStart (const char* phase);
+	static void WriteEscaped (const char* text);
+};
+
+
+class TraceSpan {
+
+public:
+	TraceSpan (const char* name, const char* category, const char* argName, int argValue) : mIsOpen (AnalysisTrace::IsRecording ()) {
+
+		if (mIsOpen)
+			AnalysisTrace::Begin (name, category, argName, argValue);
+	}
+
+	~TraceSpan () {
+
+		if (mIsOpen)
+			AnalysisTrace::End ();
+	}
+
+protected:
+	bool mIsOpen;
+};
+
+
+#endif  /*  _ANALYSISTRACE_H_  */
+
@@ -1695,16 +1695,24 @@ int ChannelData :: SetAllApproximateIDs (ChannelData* laneStd) {
 
 	RGDListIterator it (CompleteCurveList);
 	DataSignal* nextSignal;
-	double bp;
 //	int ibp;
 	double first = laneStd->GetFirstAnalyzedMean ();
 	double last = laneStd->GetLastAnalyzedMean ();
-	double mean;
-	double yPrime;
+	int i;
+	int n = CompleteCurveList.Entries ();
+	int nNeg = mNegativeCurveList.Entries ();
 
-	while (nextSignal = (DataSignal*) it ()) {
+	if (nNeg > n)
+		n = nNeg;
 
-		mean = nextSignal->GetMean ();
+	// The peaks are in time order, so they are mapped to bp in one pass through the ILS intervals
+
+	double* means = new double [n + 1];
+	double* bps = new double [n + 1];
+	double* yPrimes = new double [n + 1];
+	i = 0;
+
+	while (nextSignal = (DataSignal*) it ()) {
 
 		//if (!CoreBioComponent::SignalIsWithinAnalysisRegion (nextSignal, first))	// Modified 03/13/2015
 		//	continue;
@@ -1712,12 +1720,22 @@ int ChannelData :: SetAllApproximateIDs (ChannelData* laneStd) {
 		//if (mean > last)	// no longer "eliminate" peaks to right of ILS
 		//	break;
 
-		bp = globalSouthern->EvaluateWithExtrapolation (mean, yPrime);
-//		ibp = (int) floor (bp + 0.5);
+		means [i] = nextSignal->GetMean ();
+		i++;
+	}
+
+	globalSouthern->EvaluateSorted (means, bps, yPrimes, i);
+	it.Reset ();
+	i = 0;
+
+	while (nextSignal = (DataSignal*) it ()) {
+
+//		ibp = (int) floor (bps [i] + 0.5);
 //		nextSignal->SetApproximateBioID ((double) ibp);
-		nextSignal->SetApproximateBioID (bp);
-		nextSignal->SetApproxBioIDPrime (yPrime);
+		nextSignal->SetApproximateBioID (bps [i]);
+		nextSignal->SetApproxBioIDPrime (yPrimes [i]);
 		nextSignal->CalculateTheoreticalArea ();
+		i++;
 	}
 
 	while (nextSignal = (DataSignal*)mIgnorePeaks.GetFirst ()) {
@@ -1732,26 +1750,39 @@ int ChannelData :: SetAllApproximateIDs (ChannelData* laneStd) {
 
 	RGDListIterator itneg (mNegativeCurveList);
 	//cout << "Setting neg ILS-bps" << endl;
+	i = 0;
 
 	while (nextSignal = (DataSignal*) itneg ()) {
 
-		mean = nextSignal->GetMean ();
+		means [i] = nextSignal->GetMean ();
+		i++;
+	}
 
-		if (mean < first)
-			continue;
+	globalSouthern->EvaluateSorted (means, bps, yPrimes, i);
+	itneg.Reset ();
+	i = 0;
 
-		//if (mean > last)	// no longer "eliminate" peaks to right of ILS
-		//	break;
+	while (nextSignal = (DataSignal*) itneg ()) {
+
+		if (means [i] >= first) {
+
+			//if (mean > last)	// no longer "eliminate" peaks to right of ILS
+			//	break;
 
-		bp = globalSouthern->EvaluateWithExtrapolation (mean, yPrime);
-		//ibp = (int) floor (bp + 0.5);
-		//nextSignal->SetApproximateBioID ((double) ibp);
-		nextSignal->SetApproximateBioID (bp);
-		nextSignal->SetApproxBioIDPrime (yPrime);
+			//ibp = (int) floor (bps [i] + 0.5);
+			//nextSignal->SetApproximateBioID ((double) ibp);
+			nextSignal->SetApproximateBioID (bps [i]);
+			nextSignal->SetApproxBioIDPrime (yPrimes [i]);
+		}
+
+		i++;
 	}
 
 	//cout << "Done setting neg ILS-bps" << endl;
 
+	delete[] means;
+	delete[] bps;
+	delete[] yPrimes;
 	return 0;
 }
 
@@ -2786,6 +2817,12 @@ CoordinateTransform* ChannelData :: GetIDMap () {
 }
 
 
+CSplineCoefficientFactory* ChannelData :: CreateTimeTransformFactory () const {
+
+	return new CSplineCoefficientFactory (Means, NumberOfAcceptedCurves);
+}
+
+
 int ChannelData :: FindAndRemoveFixedOffset () {
 
 	int status = mData->FindAndRemoveFixedOffset ();
@@ -3536,70 +3573,109 @@ int ChannelData :: WriteLine (RGTextOutput& text, const RGString& delim, const D
 
 int ChannelData :: WriteRawData (RGTextOutput& text, const RGString& delim) {
 
-	if (mData == NULL)
+	int numberOfValues;
+	int* values = CreateRawDataArray (numberOfValues);
+
+	if (values == NULL)
 		return 0;
 
-	int saveSamples = mData->GetNumberOfSamples () - 1;
-	
-	for (int j=0; j<saveSamples; j++) {
+	text.WriteIntArray (values, numberOfValues, delim);
+	delete[] values;
+	return 0;
+}
 
-		text << (int)floor (mData->Value (j)) << delim;
-	}
 
-	text << (int)floor (mData->Value (saveSamples));
+
+int ChannelData :: WriteFitData (RGTextOutput& text, const RGString& delim, bool useMaxValueMethod) {
+
+	int numberOfValues;
+	int* values = CreateFitDataArray (numberOfValues, useMaxValueMethod);
+
+	if (values == NULL)
+		return 0;
+
+	text.WriteIntArray (values, numberOfValues, delim);
+	delete[] values;
 	return 0;
 }
 
 
+int ChannelData :: WriteFitData (RGTextOutput& text, const RGString& delim, int numSamples, double left, double right, bool useMaxValueMethod) {
 
-int ChannelData :: WriteFitData (RGTextOutput& text, const RGString& delim, bool useMaxValueMethod) {
+	int* values = CreateFitDataArray (numSamples, left, right, useMaxValueMethod);
 
-	if (mData == NULL)
+	if (values == NULL)
 		return 0;
 
-	int NSamples = mData->GetNumberOfSamples ();
+	text.WriteIntArray (values, numSamples, delim);
+	delete[] values;
+	return 0;
+}
 
-	DataSignal* FitCurve = new CompositeCurve (mData->LeftEndPoint (), mData->RightEndPoint (), CompleteCurveList);
-	DataSignal* FitData;
 
-	if (useMaxValueMethod) {
+int ChannelData :: WriteBaselineData (RGTextOutput& text, const RGString& delim, const RGString& indent) {
 
-		FitData = FitCurve->BuildSample (NSamples, mData->LeftEndPoint (), 1.0);
-	}
+	int numberOfValues;
+	int start;
+	int* values = CreateBaselineDataArray (start, numberOfValues);
 
-	else {
+	if (values == NULL)
+		return 0;
 
-		FitCurve->ProjectNeighboringSignals (1.0, 1.0);
-		FitData = FitCurve->Digitize (NSamples, mData->LeftEndPoint (), 1.0);
-	}
+	Endl endLine;
+	text << indent << "<baselineStart>" << start << "</baselineStart>" << endLine;
+	text << indent << "<baselinePoints>";
+	text.WriteIntArray (values, numberOfValues, delim);
+	text << "</baselinePoints>" << endLine;
+	delete[] values;
+	return 1;
+}
 
-	//cout << "Prepared curve sets for output..." << endl;
-	int saveSamples = mData->GetNumberOfSamples () - 1;
-	int dataValue;
-	
-	for (int j=0; j<saveSamples; j++) {
 
-		dataValue = (int)floor (FitData->Value (j));
+int* ChannelData :: CreateRawDataArray (int& numberOfValues) {
 
-		if (dataValue < 0)
-			dataValue = 0;
+	numberOfValues = 0;
+
+	if (mData == NULL)
+		return NULL;
+
+	numberOfValues = mData->GetNumberOfSamples ();
+
+	if (numberOfValues <= 0) {
 
-		text << dataValue << delim;
+		numberOfValues = 0;
+		return NULL;
 	}
 
-	dataValue = (int)floor (FitData->Value (saveSamples));
+	int* values = new int [numberOfValues];
 
-	if (dataValue < 0)
-		dataValue = 0;
+	for (int j=0; j<numberOfValues; j++)
+		values [j] = (int)floor (mData->Value (j));
 
-	text << dataValue;
-	delete FitCurve;
-	delete FitData;
-	return 0;
+	return values;
 }
 
 
-int ChannelData :: WriteFitData (RGTextOutput& text, const RGString& delim, int numSamples, double left, double right, bool useMaxValueMethod) {
+int* ChannelData :: CreateFitDataArray (int& numberOfValues, bool useMaxValueMethod) {
+
+	numberOfValues = 0;
+
+	if (mData == NULL)
+		return NULL;
+
+	int* values = CreateFitDataArray (mData->GetNumberOfSamples (), mData->LeftEndPoint (), mData->RightEndPoint (), useMaxValueMethod);
+
+	if (values != NULL)
+		numberOfValues = mData->GetNumberOfSamples ();
+
+	return values;
+}
+
+
+int* ChannelData :: CreateFitDataArray (int numSamples, double left, double right, bool useMaxValueMethod) {
+
+	if (numSamples <= 0)
+		return NULL;
 
 	DataSignal* FitCurve = new CompositeCurve (left, right, CompleteCurveList);
 	DataSignal* FitData;
@@ -3616,53 +3692,52 @@ int ChannelData :: WriteFitData (RGTextOutput& text, const RGString& delim, int
 	}
 
 	//cout << "Prepared curve sets for output..." << endl;
-	int saveSamples = numSamples - 1;
+	int* values = new int [numSamples];
 	int dataValue;
-	
-	for (int j=0; j<saveSamples; j++) {
+
+	for (int j=0; j<numSamples; j++) {
 
 		dataValue = (int)floor (FitData->Value (j));
 
 		if (dataValue < 0)
 			dataValue = 0;
 
-		text << dataValue << delim;
+		values [j] = dataValue;
 	}
 
-	dataValue = (int)floor (FitData->Value (saveSamples));
-
-	if (dataValue < 0)
-		dataValue = 0;
-
-	text << dataValue;
 	delete FitCurve;
 	delete FitData;
-	return 0;
+	return values;
 }
 
 
-int ChannelData :: WriteBaselineData (RGTextOutput& text, const RGString& delim, const RGString& indent) {
+int* ChannelData :: CreateBaselineDataArray (int& start, int& numberOfValues) {
+
+	// The points from mBaselineStart to the end, evaluated from time 0
+
+	start = mBaselineStart;
+	numberOfValues = 0;
 
 	if (mBaseLine == NULL)
-		return 0;
+		return NULL;
 
-	Endl endLine;
-	text << indent << "<baselineStart>" << mBaselineStart << "</baselineStart>" << endLine;
 	int NSamples = mData->GetNumberOfSamples ();
-	int saveSamples = NSamples - 1;
-	int j;
-	text << indent << "<baselinePoints>";
+	numberOfValues = NSamples - mBaselineStart;
+
+	if (numberOfValues < 1)
+		numberOfValues = 1;
+
+	int* values = new int [numberOfValues];
 	double dynamicBaseline = mBaseLine->EvaluateSequenceStart (0.0, 1.0);
-	
-	for (j=mBaselineStart; j<saveSamples; j++) {
+	values [0] = (int)floor (dynamicBaseline);
+
+	for (int j=1; j<numberOfValues; j++) {
 
-		text << (int)floor (dynamicBaseline) << delim;
 		dynamicBaseline = mBaseLine->EvaluateSequenceNext ();
+		values [j] = (int)floor (dynamicBaseline);
 	}
 
-	text << (int)floor (dynamicBaseline);
-	text << "</baselinePoints>" << endLine;
-	return 1;
+	return values;
 }
 
 
@@ -3817,3 +3892,10 @@ CSplineTransform* TimeTransform (const ChannelData& cd1, const ChannelData& cd2,
 }
 
 
+CSplineTransform* TimeTransform (const CSplineCoefficientFactory& factory1, const ChannelData& cd2) {
+
+	CSplineTransform* spline = new CSplineTransform (factory1, cd2.Means);
+	return spline;
+}
+
+
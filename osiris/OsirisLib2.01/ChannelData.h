@@ -292,6 +292,13 @@ public:
 	virtual int WriteFitData (RGTextOutput& text, const RGString& delim, int numSamples, double left, double right, bool useMaxValueMethod = false);
 
 	virtual int WriteBaselineData (RGTextOutput& text, const RGString& delim, const RGString& indent);
+
+	// The values written by the functions above, as new arrays for the caller to delete; NULL if there are none
+
+	int* CreateRawDataArray (int& numberOfValues);
+	int* CreateFitDataArray (int& numberOfValues, bool useMaxValueMethod = false);
+	int* CreateFitDataArray (int numSamples, double left, double right, bool useMaxValueMethod = false);
+	virtual int* CreateBaselineDataArray (int& start, int& numberOfValues);
 	
 	virtual int WriteLocusInfoToXML (RGTextOutput& text, const RGString& indent);
 
@@ -508,6 +515,7 @@ public:
 	virtual int AnalyzeDynamicBaselineAndNormalizeRawDataSM (int startTime, double reportMinTime);
 
 	virtual void GetCharacteristicArray (const double*& array) const { if (mLaneStandard != NULL) mLaneStandard->GetCharacteristicArray (array); }
+	CSplineCoefficientFactory* CreateTimeTransformFactory () const;	// for TimeTransform (factory, cd2) from these ILS means to many others
 
 
 	//*******************************************************************************************************
@@ -516,6 +524,7 @@ public:
 	friend CSplineTransform* TimeTransform (const ChannelData& cd1, const ChannelData& cd2);
 	friend CSplineTransform* TimeTransform (const ChannelData& cd1, const ChannelData& cd2, double* firstDerivs, int size);
 	friend CSplineTransform* TimeTransform (const ChannelData& cd1, const ChannelData& cd2, bool isHermite);
+	friend CSplineTransform* TimeTransform (const CSplineCoefficientFactory& factory1, const ChannelData& cd2);
 
 	static double GetMinimumDistanceBetweenPeaks () { return MinDistanceBetweenPeaks; }
 	static void SetMinimumDistanceBetweenPeaks (double distance) { MinDistanceBetweenPeaks = distance; }
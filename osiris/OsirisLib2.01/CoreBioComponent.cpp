@@ -76,6 +76,7 @@ bool CoreBioComponent::CrashMode = false;
 int CoreBioComponent::CrashCount = 0;
 list<int> CoreBioComponent::NoDataChannels;
 int CoreBioComponent::CrashCode = 0;
+bool CoreBioComponent::WritePlotSidecar = false;
 
 
 
@@ -2244,6 +2245,7 @@ CoreBioComponent* CoreBioComponent :: GetBestGridBasedOnMax2DerivForAnalysis (RG
 	CoreBioComponent* nextGrid;
 	CoreBioComponent* minGrid;
 	CSplineTransform* nextTrans;
+	CSplineCoefficientFactory* sampleFactory;
 	double min2Deriv;
 	double current2Deriv;
 	smLadderFitThreshold ladderFitThreshold;
@@ -2274,9 +2276,21 @@ CoreBioComponent* CoreBioComponent :: GetBestGridBasedOnMax2DerivForAnalysis (RG
 	timeMap = NULL;
 	min2Deriv = DOUBLEMAX;
 
+	// The sample's ILS is the same for every ladder, so the knot dependent part of each natural spline is computed once
+
+	if (useHermite)
+		sampleFactory = NULL;
+
+	else
+		sampleFactory = CreateTimeTransformFactory ();
+
 	while (nextGrid = (CoreBioComponent*) it()) {
 
-		nextTrans = TimeTransform (*this, *nextGrid, useHermite, useChords);	// Could augment calling sequence to use Hermite Cubic Spline transform 04/10/2014
+		if (sampleFactory != NULL)
+			nextTrans = TimeTransform (*sampleFactory, *nextGrid->mLSData);
+
+		else
+			nextTrans = TimeTransform (*this, *nextGrid, useHermite, useChords);	// Could augment calling sequence to use Hermite Cubic Spline transform 04/10/2014
 
 		if (nextTrans == NULL)
 			continue;
@@ -2295,6 +2309,7 @@ CoreBioComponent* CoreBioComponent :: GetBestGridBasedOnMax2DerivForAnalysis (RG
 			delete nextTrans;
 	}
 
+	delete sampleFactory;
 	cout << "Best grid for sample file " << (char*)mName.GetData () << " is ladder " << (char*)minGrid->GetSampleName ().GetData () << " with min 2nd deriv " << (int) ceil (min2Deriv * 1.0e6) << "\n";
 	int scaledMin2Deriv = (int)ceil (min2Deriv * 1.0e6);
 	int threshold = GetThreshold (ladderFitThreshold);
@@ -2315,6 +2330,7 @@ CoreBioComponent* CoreBioComponent :: GetBestGridBasedOnLeastTransformError (RGD
 	CoreBioComponent* nextGrid;
 	CoreBioComponent* minGrid;
 	CSplineTransform* nextTrans;
+	CSplineCoefficientFactory* sampleFactory;
 	double maxError;
 	double errorBound;
 	smLadderFitThresholdUsingMinError ladderFitThreshold;
@@ -2346,9 +2362,19 @@ CoreBioComponent* CoreBioComponent :: GetBestGridBasedOnLeastTransformError (RGD
 	//else
 	//	cout << "Using natural cubic spline for sample-to-ladder time transform..." << endl;
 
+	if (useHermite)
+		sampleFactory = NULL;
+
+	else
+		sampleFactory = CreateTimeTransformFactory ();
+
 	while (nextGrid = (CoreBioComponent*) it()) {
 
-		nextTrans = TimeTransform (*this, *nextGrid, useHermite, useChords);	// Could augment calling sequence to use Hermite Cubic Spline transform 04/10/2014
+		if (sampleFactory != NULL)
+			nextTrans = TimeTransform (*sampleFactory, *nextGrid->mLSData);
+
+		else
+			nextTrans = TimeTransform (*this, *nextGrid, useHermite, useChords);	// Could augment calling sequence to use Hermite Cubic Spline transform 04/10/2014
 
 		if (nextTrans == NULL)
 			continue;
@@ -2367,6 +2393,7 @@ CoreBioComponent* CoreBioComponent :: GetBestGridBasedOnLeastTransformError (RGD
 			delete nextTrans;
 	}
 
+	delete sampleFactory;
 	cout << "Best grid based on transform error for sample file " << (char*)mName.GetData () << " is ladder " << (char*)minGrid->GetSampleName ().GetData () << " with max error " << maxError << " bps\n";
 	int percentBPError = (int)floor (errorBound * 100.0 + 0.5);
 	int threshold = GetThreshold (ladderFitThreshold);
@@ -2392,16 +2419,18 @@ CoreBioComponent* CoreBioComponent :: GetBestGridBasedOnMaxDelta3DerivForAnalysi
 	CoreBioComponent* nextGrid;
 	CoreBioComponent* minGrid;
 	CSplineTransform* nextTrans;
+	CSplineCoefficientFactory* sampleFactory;
 	double min3Deriv;
 	double current3Deriv;
 
 	minGrid = NULL;
 	timeMap = NULL;
 	min3Deriv = DOUBLEMAX;
+	sampleFactory = CreateTimeTransformFactory ();
 
 	while (nextGrid = (CoreBioComponent*) it()) {
 
-		nextTrans = TimeTransform (*this, *nextGrid);	// Could augment calling sequence to use Hermite Cubic Spline transform 04/10/2014
+		nextTrans = TimeTransform (*sampleFactory, *nextGrid->mLSData);	// Could augment calling sequence to use Hermite Cubic Spline transform 04/10/2014
 
 		if (nextTrans == NULL)
 			continue;
@@ -2420,6 +2449,7 @@ CoreBioComponent* CoreBioComponent :: GetBestGridBasedOnMaxDelta3DerivForAnalysi
 			delete nextTrans;
 	}
 
+	delete sampleFactory;
 	return minGrid;
 }
 
@@ -3276,6 +3306,14 @@ int CoreBioComponent :: WriteFitDataForChannel (int channelNum, RGTextOutput& te
 }
 
 
+int* CoreBioComponent :: CreateFitDataArrayForChannel (int channelNum, ChannelData* cd) {
+
+	// cd->GetNumberOfSamples () values, fit to this component's channel over cd's range
+
+	return mDataChannels [channelNum]->CreateFitDataArray (cd->GetNumberOfSamples (), cd->GetLeftEndpoint (), cd->GetRightEndpoint (), false);
+}
+
+
 int CoreBioComponent :: WritePeakInfoToXMLForChannel (int channel, RGTextOutput& text, const RGString& indent, const RGString& tagName) {
 
 	mDataChannels [channel]->WritePeakInfoToXML (text, indent, tagName);
@@ -51,6 +51,7 @@
 #include "SmartMessagingObject.h"
 
 #include <list>
+#include <set>
 
 class RGFile;
 class RGVInStream;
@@ -62,6 +63,7 @@ class GenotypeSpecs;
 class GenotypesForAMarkerSet;
 class SmartMessage;
 class SmartNotice;
+class PlotSidecar;
 class SampleModList;
 
 #define _USENOISEINPULLUPANALYSIS_
@@ -245,12 +247,14 @@ public:
 
 	virtual void WriteRawDataAndFitData (RGTextOutput& text, SampleData* data);
 	virtual int WriteFitDataForChannel (int channelNum, RGTextOutput& text, const RGString& delim, ChannelData* cd);
+	virtual int* CreateFitDataArrayForChannel (int channelNum, ChannelData* cd);
 	virtual int WriteLocusInfoToXML (RGTextOutput& text, const RGString& indent);
 
 	virtual CoreBioComponent* GetBestGridBasedOnTimeForAnalysis (RGDList& gridList);
 	virtual CoreBioComponent* GetBestGridBasedOnMax2DerivForAnalysis (RGDList& gridList, CSplineTransform*& timeMap);
 	virtual CoreBioComponent* GetBestGridBasedOnLeastTransformError (RGDList& gridList, CSplineTransform*& timeMap, const double* characteristicArray);
 	virtual CoreBioComponent* GetBestGridBasedOnMaxDelta3DerivForAnalysis (RGDList& gridList, CSplineTransform*& timeMap);
+	CSplineCoefficientFactory* CreateTimeTransformFactory () const { return mLSData->CreateTimeTransformFactory (); }	// natural spline factorization for ILS, shared among ladders
 
 	virtual int FindAndRemoveFixedOffsets ();
 	virtual int LocatePositiveControlName (GenotypesForAMarkerSet* genotypes);
@@ -445,6 +449,9 @@ public:
 	virtual bool ScavengePullupFromOtherChannelListLaserInScale ();
 	virtual bool ScavengePullupFromOtherChannelListLaserOffScale ();
 
+	void InsertPullupFromAnotherChannel (DataSignal* primarySignal);
+	bool IsPullupFromAnotherChannel (DataSignal* primarySignal) const { return mPullupFromAnotherChannelMembers.count (primarySignal) > 0; }
+
 	virtual int OrganizeNoticeObjectsSM ();
 	virtual int TestSignalsForLaserOffScaleSM ();
 	virtual int PreTestSignalsForLaserOffScaleSM ();
@@ -494,6 +501,11 @@ public:
 	virtual int WriteSmartPeakInfoToXMLForChannel (int channel, RGTextOutput& text, const RGString& indent, const RGString& tagName);
 	virtual int WriteSmartArtifactInfoToXMLForChannel (int channel, RGTextOutput& text, const RGString& indent);
 
+	// .plt trace arrays:  written as text and, with a sidecar, recorded in it along with their place in the file
+
+	static void WritePlotArray (RGFile& file, RGTextOutput& text, const RGString& indent, int channel, int type, const int* values, int numberOfValues, PlotSidecar* sidecar);
+	static int WritePlotSidecarFile (const RGString& pltFullPath, RGFile& pltFile, const PlotSidecar* sidecar);
+
 	virtual void InitializeMessageData ();
 
 
@@ -531,6 +543,7 @@ public:
 	static void ClearInitializationMatrix () { delete[] InitialMatrix; InitialMatrix = NULL; }
 	static int GetScope () { return 4; }
 	static bool TestForOffScale (double time);
+	static void ApplyColorCorrectionMatrix (const double* matrix, double** rawChannelData, double** correctedChannelData, int numberOfChannels, int numDataPoints);
 
 	static void SetILSDyeName (const RGString& name) { ILSDyeName = name; }
 	static RGString GetILSDyeName () { return ILSDyeName; }
@@ -554,6 +567,9 @@ public:
 	static void AddChannel (int c) { NoDataChannels.push_back (c); }
 	static int GetNextNoDataChannel ();
 
+	static void SetWritePlotSidecar (bool write) { WritePlotSidecar = write; }
+	static bool GetWritePlotSidecar () { return WritePlotSidecar; }
+
 	static void ResetCrashCode () { CrashCode = 0; }
 	static int GetCrashCode () {
 		return CrashCode;
@@ -635,6 +651,7 @@ protected:
 
 	RGDList mChannelList;
 	RGDList mPullupFromAnotherChannel;
+	set<DataSignal*> mPullupFromAnotherChannelMembers;   // same signals as mPullupFromAnotherChannel, for membership tests in each channel pair
 
 	//************************************************************************************************************************************
 	//************************************************************************************************************************************
@@ -661,6 +678,7 @@ protected:
 	static int CrashCount;
 	static list<int> NoDataChannels;
 	static int CrashCode;
+	static bool WritePlotSidecar;
 
 	static int InitializeOffScaleData (SampleData& sd);
 	static void ReleaseOffScaleData ();
@@ -53,6 +53,10 @@
 #include "LeastMedianOfSquares.h"
 #include "STRLCAnalysis.h"
 #include "ModPairs.h"
+#include "AnalysisProfiler.h"
+#include "AnalysisTrace.h"
+#include "plotsidecar.h"
+#include <cstdio>
 
 
 // Smart Message Functions**************************************************************************************************************
@@ -170,6 +174,9 @@ bool CoreBioComponent :: EvaluateSmartMessagesForStage (SmartMessagingComm& comm
 
 bool CoreBioComponent :: EvaluateSmartMessagesAndTriggersForStage (SmartMessagingComm& comm, int numHigherObjects, int stage, bool allMessages, bool signalsOnly) {
 
+	ProfileTimer timer (AnalysisProfiler::MessageEvaluation);
+	TraceSpan span ("MessageStage", "message", "stage", stage);
+
 	int i;
 	comm.SMOStack [numHigherObjects] = (SmartMessagingObject*) this;
 	int topNum = numHigherObjects + 1;
@@ -716,6 +723,8 @@ void CoreBioComponent :: SetPositiveControlFalseSM () {
 
 int CoreBioComponent :: TestFractionalFiltersSM () {
 
+	ProfileTimer timer (AnalysisProfiler::CallsAndQuality);
+
 	//
 	//  This is sample stage 2
 	//
@@ -734,6 +743,8 @@ int CoreBioComponent :: TestFractionalFiltersSM () {
 
 int CoreBioComponent :: MakePreliminaryCallsSM (GenotypesForAMarkerSet* pGenotypes) {
 
+	ProfileTimer timer (AnalysisProfiler::CallsAndQuality);
+
 	//
 	//  This is sample stage 3
 	//
@@ -1379,7 +1390,6 @@ int CoreBioComponent :: SetAllRawDataWithMatrixSM (SampleData& fileData, TestCha
 	double* matrix = fileData.GetMatrix (numElements);
 	int i;
 	int j;
-	int k;
 	smColorCorrectionMatrixWrongSize matrixWrongSize;
 	smColorCorrectionMatrixExpectedButNotFound matrixNotFound;
 
@@ -1397,10 +1407,8 @@ int CoreBioComponent :: SetAllRawDataWithMatrixSM (SampleData& fileData, TestCha
 		return SetAllRawDataSM (fileData, testControlPeak, testSamplePeak);
 	}
 
-	double* matrixBase = matrix;
 	double** rawChannelData = new double* [mNumberOfChannels + 1];
 	int numDataPoints;
-	double sum;
 
 	for (i=1; i<=mNumberOfChannels; i++) {
 
@@ -1430,20 +1438,7 @@ int CoreBioComponent :: SetAllRawDataWithMatrixSM (SampleData& fileData, TestCha
 	for (i=1; i<=mNumberOfChannels; i++)
 		correctedChannelData [i] = new double [numDataPoints];
 
-	for (i=1; i<=mNumberOfChannels; i++) {
-
-		for (k=0; k<numDataPoints; k++){
-
-			sum = 0.0;
-
-			for (j=1; j<=mNumberOfChannels; j++)
-				sum += (*(matrixBase + j - 1)) * rawChannelData [j][k];
-
-			correctedChannelData [i][k] = sum;
-		}
-
-		matrixBase += mNumberOfChannels;
-	}
+	ApplyColorCorrectionMatrix (matrix, rawChannelData, correctedChannelData, mNumberOfChannels, numDataPoints);
 
 	for (i=1; i<=mNumberOfChannels; i++)
 		delete[] rawChannelData [i];
@@ -1478,6 +1473,35 @@ int CoreBioComponent :: SetAllRawDataWithMatrixSM (SampleData& fileData, TestCha
 }
 
 
+void CoreBioComponent :: ApplyColorCorrectionMatrix (const double* matrix, double** rawChannelData, double** correctedChannelData, int numberOfChannels, int numDataPoints) {
+
+	//
+	//  matrix is numberOfChannels x numberOfChannels, by rows; channel arrays are indexed from 1
+	//
+
+	const double* matrixBase = matrix;
+	double sum;
+	int i;
+	int j;
+	int k;
+
+	for (i=1; i<=numberOfChannels; i++) {
+
+		for (k=0; k<numDataPoints; k++){
+
+			sum = 0.0;
+
+			for (j=1; j<=numberOfChannels; j++)
+				sum += (*(matrixBase + j - 1)) * rawChannelData [j][k];
+
+			correctedChannelData [i][k] = sum;
+		}
+
+		matrixBase += numberOfChannels;
+	}
+}
+
+
 int CoreBioComponent :: FitAllCharacteristicsSM (RGTextOutput& text, RGTextOutput& ExcelText, OsirisMsg& msg, Boolean print) {
 
 	//
@@ -1501,6 +1525,8 @@ int CoreBioComponent :: FitAllCharacteristicsSM (RGTextOutput& text, RGTextOutpu
 
 int CoreBioComponent :: FitNonLaneStandardCharacteristicsSM (RGTextOutput& text, RGTextOutput& ExcelText, OsirisMsg& msg, Boolean print) {
 
+	ProfileTimer timer (AnalysisProfiler::PeakFitting);
+
 	//
 	//  This is ladder and sample stage 1
 	//
@@ -1511,6 +1537,8 @@ int CoreBioComponent :: FitNonLaneStandardCharacteristicsSM (RGTextOutput& text,
 
 		if (i != mLaneStandardChannel) {
 
+			TraceSpan span ("FitChannel", "channel", "channel", i);
+
 			if (mDataChannels [i]->FitAllCharacteristicsSM (text, ExcelText, msg, print) < 0) {
 
 				ErrorString << mDataChannels [i]->GetError ();
@@ -1527,6 +1555,8 @@ int CoreBioComponent :: FitNonLaneStandardCharacteristicsSM (RGTextOutput& text,
 
 int CoreBioComponent :: FitNonLaneStandardNegativeCharacteristicsSM (RGTextOutput& text, RGTextOutput& ExcelText, OsirisMsg& msg, Boolean print) {
 
+	ProfileTimer timer (AnalysisProfiler::PeakFitting);
+
 	//
 	//  This is sample stage 1
 	//
@@ -1547,6 +1577,8 @@ int CoreBioComponent :: FitNonLaneStandardNegativeCharacteristicsSM (RGTextOutpu
 
 int CoreBioComponent :: AssignSampleCharacteristicsToLociSM (CoreBioComponent* grid, CoordinateTransform* timeMap) {
 
+	ProfileTimer timer (AnalysisProfiler::LocusAnalysis);
+
 	//
 	//  This is sample stage 1
 	//
@@ -1597,6 +1629,8 @@ int CoreBioComponent :: TestForNearlyDuplicateAllelesSMLF () {
 
 int CoreBioComponent :: AnalyzeLaneStandardChannelSM (RGTextOutput& text, RGTextOutput& ExcelText, OsirisMsg& msg, Boolean print) {
 
+	ProfileTimer timer (AnalysisProfiler::ILSAnalysis);
+
 	//
 	//  This is ladder and sample stage 1
 	//
@@ -1721,7 +1755,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 	double minPUHeightThreshold = mDataChannels [pullupChannel]->GetMinimumHeight ();
 	double noiseLevelForSecondaryChannel = mDataChannels [pullupChannel]->GetNoiseRange ();
 	double percentNoiseLevel = 100.0;
-	RGDList ignore;
+	set<DataSignal*> ignore;   // tested for each peak in the primary channel lists below
 	double maxLaserInScalePeak = 0.0;
 	bool testNonLaserOffScale = !testLaserOffScale;
 
@@ -1794,43 +1828,43 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 
 		if (primarySignal->GetMessageValue (sidePeak)) {
 
-			mPullupFromAnotherChannel.InsertWithNoReferenceDuplication (primarySignal);
+			InsertPullupFromAnotherChannel (primarySignal);
 			continue;
 		}
 
 		if (primarySignal->GetMessageValue (sigmoidalSidePeak)) {
 
-			mPullupFromAnotherChannel.InsertWithNoReferenceDuplication (primarySignal);
+			InsertPullupFromAnotherChannel (primarySignal);
 			continue;
 		}
 
 		if (primarySignal->GetMessageValue (purePullup)) {
 
-			mPullupFromAnotherChannel.InsertWithNoReferenceDuplication (primarySignal);
+			InsertPullupFromAnotherChannel (primarySignal);
 			continue;
 		}
 
 		if (primarySignal->IsNoisySidePeak ()) {
 
-			ignore.InsertWithNoReferenceDuplication (primarySignal);
+			ignore.insert (primarySignal);
 			continue;
 		}
 
 		if (primarySignal->IsDoNotCall ()) {
 
-			ignore.InsertWithNoReferenceDuplication (primarySignal);
+			ignore.insert (primarySignal);
 			continue;
 		}
 
 		if (primarySignal->DontLook ()) {
 
-			ignore.InsertWithNoReferenceDuplication (primarySignal);
+			ignore.insert (primarySignal);
 			continue;
 		}
 
 		if (primarySignal->Peak () <= secondarySignal->Peak ()) {
 
-			mPullupFromAnotherChannel.InsertWithNoReferenceDuplication (primarySignal);
+			InsertPullupFromAnotherChannel (primarySignal);
 			continue;
 		}
 
@@ -1840,13 +1874,13 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 			// create pair and add to local list to use later or clear
 			//
 
-			mPullupFromAnotherChannel.InsertWithNoReferenceDuplication (primarySignal);
+			InsertPullupFromAnotherChannel (primarySignal);
 			continue;
 		}
 
 		if (secondarySignal->IsPullupFromChannelsOtherThan (primaryChannel, mNumberOfChannels)) {
 
-			mPullupFromAnotherChannel.InsertWithNoReferenceDuplication (primarySignal);
+			InsertPullupFromAnotherChannel (primarySignal);
 			continue;
 		}
 
@@ -1985,7 +2019,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 		SetLinearPullupMatrix (primaryChannel, pullupChannel, 0.0);
 		SetQuadraticPullupMatrix (primaryChannel, pullupChannel, 0.0);
 		mPattern [primaryChannel] [pullupChannel] = false;
-		ignore.Clear ();
+		ignore.clear ();
 		return true;
 	}
 
@@ -2015,7 +2049,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 		SetPullupTestedMatrix(primaryChannel, pullupChannel, true);
 		SetLinearPullupMatrix(primaryChannel, pullupChannel, 0.0);
 		SetQuadraticPullupMatrix(primaryChannel, pullupChannel, 0.0);
-		ignore.Clear ();
+		ignore.clear ();
 
 		while (!pairList.empty()) {
 
@@ -2158,6 +2192,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 	RGDList rawDataPullupPrimaries;  // add raw data primary pullup peaks here so can test later to see if a peak falls in this category
 	RGDList occludedDataPrimaries;  // add primary peaks whose potential pullups are occluded by a nearby peak, but not near enough to cause actual pullup
 	RGDList noPullupPrimaries;  // add non-primary peaks which are not occluded, have no paired pullup and have no raw data pullup
+	set<DataSignal*> occludedMembers;  // same signals as occludedDataPrimaries
 
 	// Perform additional tests to see if hasNegativePullup accurately reflects reality... (10/16/2016)
 	
@@ -2171,10 +2206,10 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 		if (nextSignal->GetMessageValue (laserOffScale) != testLaserOffScale)
 				continue;
 
-		if (ignore.ContainsReference (nextSignal))
+		if (ignore.count (nextSignal) > 0)
 			continue;
 
-		if (mPullupFromAnotherChannel.ContainsReference (nextSignal))
+		if (IsPullupFromAnotherChannel (nextSignal))
 			continue;
 
 		if (nextSignal->GetMessageValue (pullup))   // we leave this in because if the "primary" is also a pullup, we can't know if a cross channel effect is due to this peak
@@ -2185,7 +2220,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 
 		if (nextSignal->IsNegativePeak ()) {
 
-			ignore.InsertWithNoReferenceDuplication (nextSignal);
+			ignore.insert (nextSignal);
 			continue;
 		}
 
@@ -2200,6 +2235,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 		if (nextSignal->HasWeakPullupInChannel (pullupChannel)) {
 
 			occludedDataPrimaries.Append (nextSignal);
+			occludedMembers.insert (nextSignal);
 		}
 
 		//else if (TestMaxAbsoluteRawDataInInterval (pullupChannel, nextSignal->GetMean (), 0.7 * nextSignal->GetWidth (), 0.75, rawHeight)) {  // Don't modify min primary and min ratio based on these...
@@ -2307,13 +2343,13 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 			if (rawDataPullupPrimaries.ContainsReference (nextSignal))
 				continue;
 
-			if (occludedDataPrimaries.ContainsReference (nextSignal))
+			if (occludedMembers.count (nextSignal) > 0)
 				continue;
 
-			if (mPullupFromAnotherChannel.ContainsReference (nextSignal))
+			if (IsPullupFromAnotherChannel (nextSignal))
 				continue;
 
-			if (ignore.ContainsReference (nextSignal))
+			if (ignore.count (nextSignal) > 0)
 				continue;
 
 			//if (nextSignal->Peak () < primaryThreshold)
@@ -2378,7 +2414,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 	double pullupChannelNoise = 0.5 * mDataChannels [pullupChannel]->GetNoiseRange ();
 //	int estimatedMinPrimary;
 	mMinimumInScalePrimaryPeak [primaryChannel] [pullupChannel] = estimatedMinHeight;
-	ignore.Clear ();   //  Does this belong here???????
+	ignore.clear ();   //  Does this belong here???????
 
 	//TEST!!!
 	//trulyMixedPositiveAndNegativePullup = false;
@@ -2742,7 +2778,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 		}
 	}
 
-	ignore.Clear ();
+	ignore.clear ();
 
 	// Add test for required number of peaks here.  If too few, create uncertain pull-ups, except if half width criterion applies.  If enough call ComputePullupParameers below.
 	//  Don't forget to set mPattern appropriately.
@@ -2754,7 +2790,7 @@ bool CoreBioComponent::CollectDataAndComputeCrossChannelEffectForChannelsSM (int
 		SetPullupTestedMatrix(primaryChannel, pullupChannel, true);
 		SetLinearPullupMatrix(primaryChannel, pullupChannel, 0.0);
 		SetQuadraticPullupMatrix(primaryChannel, pullupChannel, 0.0);
-		ignore.Clear ();
+		ignore.clear ();
 
 		while (!pairList.empty()) {
 
@@ -4335,6 +4371,13 @@ bool CoreBioComponent::RemovePrimaryLinksForChannelsSM (int primaryChannel, int
 }
 
 
+void CoreBioComponent :: InsertPullupFromAnotherChannel (DataSignal* primarySignal) {
+
+	mPullupFromAnotherChannel.InsertWithNoReferenceDuplication (primarySignal);
+	mPullupFromAnotherChannelMembers.insert (primarySignal);
+}
+
+
 bool CoreBioComponent::ScavengePullupFromOtherChannelListLaserInScale () {
 
 	// sample phase 1...still in progress.
@@ -4460,6 +4503,7 @@ bool CoreBioComponent::ScavengePullupFromOtherChannelListLaserInScale () {
 		}
 	}
 
+	mPullupFromAnotherChannelMembers.clear ();
 	return true;
 }
 
@@ -4602,6 +4646,7 @@ bool CoreBioComponent::ScavengePullupFromOtherChannelListLaserOffScale () {
 		}
 	}
 
+	mPullupFromAnotherChannelMembers.clear ();
 	return true;
 }
 
@@ -4700,10 +4745,13 @@ int CoreBioComponent :: SetLaneStandardDataSM (SampleData& fileData, TestCharact
 
 int CoreBioComponent :: FitLaneStandardCharacteristicsSM (RGTextOutput& text, RGTextOutput& ExcelText, OsirisMsg& msg, Boolean print) {
 
+	ProfileTimer timer (AnalysisProfiler::PeakFitting);
+
 	//
 	//  This is ladder and sample stage 1
 	//
 
+	TraceSpan span ("FitChannel", "channel", "channel", mLaneStandardChannel);
 	int status = mDataChannels [mLaneStandardChannel]->FitAllCharacteristicsSM (text, ExcelText, msg, print);
 
 	if (status < 0)
@@ -5066,6 +5114,8 @@ int CoreBioComponent :: PrepareSampleForAnalysisSM (SampleData& fileData, Sample
 
 int CoreBioComponent :: NormalizeBaselineForNonILSChannelsSM () {
 
+	ProfileTimer timer (AnalysisProfiler::Normalization);
+
 	int i;
 	int left = (int) floor (mDataChannels [mLaneStandardChannel]->GetFirstAnalyzedMean ());
 	int status = 0;
@@ -5090,6 +5140,8 @@ int CoreBioComponent :: NormalizeBaselineForNonILSChannelsSM () {
 
 		if (i != mLaneStandardChannel) {
 
+			TraceSpan span ("NormalizeChannel", "channel", "channel", i);
+
 			if (mDataChannels [i]->AnalyzeDynamicBaselineAndNormalizeRawDataSM (left, reportMinTime) <= 0) {
 
 				status = -i;
@@ -5140,6 +5192,8 @@ bool CoreBioComponent :: IsLabPositiveControl (const RGString& name, GenotypesFo
 
 int CoreBioComponent :: TestPositiveControlSM (GenotypesForAMarkerSet* genotypes) {
 
+	ProfileTimer timer (AnalysisProfiler::CallsAndQuality);
+
 	//
 	//  This is sample stage 5
 	//
@@ -5271,6 +5325,8 @@ int CoreBioComponent::RemoveAllSignalsOutsideLaneStandardSMLF() {
 
 int CoreBioComponent :: PreliminarySampleAnalysisSM (RGDList& gridList, SampleDataStruct* sampleData) {
 
+	ProfileTimer timer (AnalysisProfiler::LadderMatching);
+
 	//
 	//  This is sample stage 1
 	//
@@ -5462,6 +5518,78 @@ int CoreBioComponent :: WriteSmartArtifactInfoToXMLForChannel (int channel, RGTe
 }
 
 
+void CoreBioComponent :: WritePlotArray (RGFile& file, RGTextOutput& text, const RGString& indent, int channel, int type, const int* values, int numberOfValues, PlotSidecar* sidecar) {
+
+	RGString tag = PlotSidecar::GetArrayTagName (type);
+	Endl endLine;
+	unsigned long textStart = 0;
+
+	text << indent << "<" << tag << ">";
+
+	if (sidecar != NULL)
+		textStart = file.CurrentOffset ();
+
+	text.WriteIntArray (values, numberOfValues, " ");
+
+	if (sidecar != NULL)
+		sidecar->AddArray (channel, type, values, numberOfValues, textStart, file.CurrentOffset ());
+
+	text << "</" << tag << ">" << endLine;
+}
+
+
+int CoreBioComponent :: WritePlotSidecarFile (const RGString& pltFullPath, RGFile& pltFile, const PlotSidecar* sidecar) {
+
+	// Called with the .plt complete.  Without a sidecar, any left from an earlier analysis is removed, so it can't
+	// be paired with the new .plt
+
+	RGString sidecarPath = PlotSidecar::SidecarFileName (pltFullPath.GetData ()).c_str ();
+
+	if (sidecar == NULL) {
+
+		if (RGFile::Exists (sidecarPath.GetData ()))
+			remove (sidecarPath.GetData ());
+
+		return 0;
+	}
+
+	// The sidecar records the size and hash of the .plt as written, so read it back; under Windows, the text mode
+	// .plt has CR LF line ends, which is what the viewer will read
+
+	pltFile.Flush ();
+	RGFile pltReadBack (pltFullPath.GetData (), "rb");
+
+	if (!pltReadBack.isValid ())
+		return -1;
+
+	string pltText;
+	pltText.resize (pltReadBack.GetSizeOfFile ());
+
+	if (!pltText.empty () && !pltReadBack.Read (&pltText [0], pltText.length ()))
+		return -1;
+
+	pltReadBack.Close ();
+	string encoded;
+	sidecar->Encode (encoded, pltText.data (), pltText.length ());
+	RGFile sidecarFile (sidecarPath.GetData (), "wb");
+
+	if (!sidecarFile.isValid ())
+		return -1;
+
+	sidecarFile.Write (encoded.data (), encoded.length ());
+	sidecarFile.Flush ();
+
+	if (sidecarFile.Error ()) {
+
+		sidecarFile.Close ();
+		remove (sidecarPath.GetData ());
+		return -1;
+	}
+
+	return 0;
+}
+
+
 void CoreBioComponent :: InitializeMessageData () {
 
 	int size = SmartMessage::GetSizeOfArrayForScope (GetObjectScope ());
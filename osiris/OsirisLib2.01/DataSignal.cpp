@@ -53,6 +53,7 @@
 #include "SmartMessage.h"
 #include "STRSmartNotices.h"
 #include "OsirisPosix.h"
+#include "AnalysisProfiler.h"
 #include <cmath>
 #include <limits>
 
@@ -3997,6 +3998,7 @@ DataSignal* SampledData :: FindNextCharacteristicFromRight (const DataSignal& Si
 			}
 
 			value->SetDataMode (nextInterval->GetMaxAtMode ());
+			AnalysisProfiler::Count (AnalysisProfiler::PeaksFitted);
 			break;
 		}
 
@@ -4021,8 +4023,11 @@ DataSignal* SampledData :: FindNextCharacteristicFromLeft (const DataSignal& Sig
 	nextInterval->AddSideValues (this);
 	DataSignal* value = Signature.FindCharacteristic (this, nextInterval, TraceWindowSize, fit, previous);
 
-	if (value != NULL)
+	if (value != NULL) {
+
 		value->SetDataMode (nextInterval->GetMaxAtMode ());
+		AnalysisProfiler::Count (AnalysisProfiler::PeaksFitted);
+	}
 
 	return value;
 }
@@ -4498,8 +4503,11 @@ const DataSignal* SampledData :: FindCharacteristicBetweenTwoPeaks (DataSignal*
 	copySignal->SetCurrentDataInterval (NULL);
 	delete newSignal;
 
-	if (copySignal != NULL)
+	if (copySignal != NULL) {
+
 		copySignal->SetDataMode (maxAtMode);
+		AnalysisProfiler::Count (AnalysisProfiler::PeaksFitted);
+	}
 
 	delete shoulderInterval;
 	return copySignal;
@@ -4539,6 +4547,7 @@ DataSignal* SampledData :: FindNextCharacteristicRetry (const DataSignal& Signat
 		}
 
 		value->SetDataMode (nextInterval->GetMaxAtMode ());
+		AnalysisProfiler::Count (AnalysisProfiler::PeaksFitted);
 	}
 
 	return value;
@@ -4906,6 +4915,7 @@ DataSignal* SampledData :: FindNextCharacteristicRetry (const DataSignal& Signat
 	if (value != NULL) {
 
 		value->SetDataMode (nextInterval->GetMaxAtMode ());
+		AnalysisProfiler::Count (AnalysisProfiler::PeaksFitted);
 	}
 
 	delete testInterval;
@@ -6685,6 +6695,8 @@ DataSignal* NormalizedGaussian :: FindNextCharacteristicFromLeft (const DataSign
 DataSignal* NormalizedGaussian :: FindCharacteristic (const DataSignal* Target, const DataInterval* Segment, 
 int windowSize, double& fit, RGDList& previous) const {
 
+	AnalysisProfiler::Count (AnalysisProfiler::FindCharacteristicCalls);
+
 	//
 	//  OK, here's the skinny.  First, assume that the standard deviation, sigma (sigma0) of this Gaussian,
 	// is less than that for any of the curves to fit.  Given that, then here's what to do:
@@ -7784,6 +7796,8 @@ DataSignal* DoubleGaussian :: FindNextCharacteristicFromLeft (const DataSignal&
 DataSignal* DoubleGaussian :: FindCharacteristic (const DataSignal* Target, const DataInterval* Segment, 
 int windowSize, double& fit, RGDList& previous) const {
 
+	AnalysisProfiler::Count (AnalysisProfiler::FindCharacteristicCalls);
+
 	//
 	//  OK, so this is similar to NormalizedGaussian.  First, assume that the standard deviation, sigma (sigma0) of this 
 	// DoubleGaussian, is less than that for any of the curves to fit.  Given that, then here's what to do:
@@ -10067,6 +10081,8 @@ DataSignal* NormalizedSuperGaussian :: FindNextCharacteristicFromLeft (const Dat
 DataSignal* NormalizedSuperGaussian :: FindCharacteristic (const DataSignal* Target, const DataInterval* Segment, 
 int windowSize, double& fit, RGDList& previous) const {
 
+	AnalysisProfiler::Count (AnalysisProfiler::FindCharacteristicCalls);
+
 	// Note:  have to fix scaling and relationship between StandardDeviation (sample) and 'StandardDeviation', the
 	// parameter in the SuperGaussian formula.  We may also have to derive a new relationship for the dot product
 	// of two SuperGaussians of different sigmas and the same mean.  We should add the part at the end where we 
@@ -11464,6 +11480,8 @@ double DualDoubleGaussian :: Norm2 (double left, double right) {
 
 DataSignal* DualDoubleGaussian :: FindCharacteristic (const DataSignal* Target, const DataInterval* Segment, int windowSize, double& fit, RGDList& previous) const {
 
+	AnalysisProfiler::Count (AnalysisProfiler::FindCharacteristicCalls);
+
 	if (Segment->GetNumberOfMinima () == 0) {
 	
 		fit = 0.0;
@@ -37,6 +37,7 @@
 #include "rgfile.h"
 #include "rgvstream.h"
 #include "rgtokenizer.h"
+#include "rgxmlreader.h"
 #include "coordtrans.h"
 #include "RGTextOutput.h"
 #include "OsirisMsg.h"
@@ -9501,50 +9502,36 @@ PopulationCollection :: PopulationCollection (const RGString& inputDirectoryName
 	}
 
 	mILSData.ReadTextFile (ilsInputFile);
-	size_t startIndex = 0;
-	size_t endIndex;
-	size_t setStartIndex = 0;
-	size_t setEndIndex;
-	RGString kitString;
-	RGString setsString;
-	RGString singleSetString;
-	RGXMLTagSearch kitsSearch ("Kits", mILSData);
+	RGXMLReader reader (mILSData);
+	RGXMLView setsString;
+	RGXMLView singleSetString;
 	bool foundKit = false;
 
-	if (!kitsSearch.FindNextTag (startIndex, endIndex, setsString)) {
+	if (!reader.FindNextElement ("Kits", setsString)) {
 
 		Valid = FALSE;
 		ErrorString = "Could not find collection of kit names and files in ILS and Ladder Info, file:  " + ilsFileName;
 		return;
 	}
 
-	startIndex = 0;
-	RGXMLTagSearch setSearch ("Set", setsString);
-	RGXMLTagSearch kitNameSearch ("KitName", singleSetString);
-	RGXMLTagSearch gridFileNameSearch ("FileName", singleSetString);
-
-	RGString kitName;
+	RGXMLReader setReader (setsString);
+	RGXMLView kitName;
 	RGString kitFileName;
 	RGString fullPathGridFileName;
 
-	while (setSearch.FindNextTag (startIndex, endIndex, singleSetString)) {
+	while (setReader.FindNextElement ("Set", singleSetString)) {
 
-		startIndex = endIndex;
-		kitNameSearch.ResetSearch ();
-		gridFileNameSearch.ResetSearch ();
-		setStartIndex = 0;
+		RGXMLReader singleSetReader (singleSetString);
 
-		if (!kitNameSearch.FindNextTag (setStartIndex, setEndIndex, kitName)) {
+		if (!singleSetReader.FindNextElement ("KitName", kitName)) {
 
 			Valid = FALSE;
 			ErrorString = "Marker set does not have a kit name, file:  " + ilsFileName;
 		}
 
-		else if (kitName == markerSetName) {
-
-			setStartIndex = setEndIndex;
+		else if (kitName == markerSetName.GetData ()) {
 
-			if (!gridFileNameSearch.FindNextTag (setStartIndex, setEndIndex, kitFileName)) {
+			if (!singleSetReader.FindNextElement ("FileName", kitFileName)) {
 
 				Valid = FALSE;
 				ErrorString = "Marker set with matching name does not have a kit filename, file:  " + ilsFileName;
@@ -9655,31 +9642,31 @@ void PopulationCollection :: Write (RGFile& textOutput, const RGString& indent)
 
 Boolean PopulationCollection :: BuildMarkerSets (const RGString& textInput) {
 
-	RGString TextInput (textInput);
-	RGBracketStringSearch MarkerSetToken ("<Set>", "</Set>", TextInput);
-	RGBracketStringSearch VersionToken ("<Version>", "</Version>", TextInput);
+	RGXMLReader reader (textInput);
+	RGXMLView version;
 	RGString SetString;
 	BasePopulationMarkerSet* baseSet;
 	PopulationMarkerSet* markerSet;
-	size_t EndPosition;
-	size_t StartPosition = 0;
 	ErrorString = "";
 	Boolean validity = TRUE;
 	RGString LSName;
 	LaneStandard* ls;
 	double v;
 
-	if (VersionToken.FindNextBracketedString (0, EndPosition, SetString)) {
+	if (reader.FindNextElement ("Version", version)) {
 
-		v = SetString.ConvertToDouble ();
+		v = version.ConvertToDouble ();
 
 		if (v > 2.69)
 			UseILSFamilies = true;
 	}
 
-	while (MarkerSetToken.FindNextBracketedString (StartPosition, EndPosition, SetString)) {
+	// the Version need not precede the marker sets
+
+	reader.Reset ();
+
+	while (reader.FindNextElement ("Set", SetString)) {
 
-		StartPosition = EndPosition;
 		baseSet = GetNewPopulationMarkerSet (SetString);
 
 		if (!baseSet->IsValid ()) {
@@ -475,7 +475,7 @@ public:
 	int TestComplexNeighborsForGridSM (DataSignal* testSignal, RGDList& comparisonSignals);
 	int TestSampleNeighborsSM (DataSignal* previous, DataSignal* testSignal, DataSignal* following);
 	int TestSampleAveragesSM (ChannelData* lsData, DataSignal* testSignal, Boolean testRatio = TRUE);
-	virtual Boolean ExtractExtendedSampleSignalsSM (RGDList& channelSignalList, Locus* gridLocus, CoordinateTransform* timeMap, Locus* prevGridLocus, Locus* followingGridLocus);
+	virtual Boolean ExtractExtendedSampleSignalsSM (RGDList& channelSignalList, Locus* gridLocus, CoordinateTransform* timeMap, Locus* prevGridLocus, Locus* followingGridLocus, const double* gridTimes = NULL);	// gridTimes:  timeMap of channelSignalList means, if already computed
 	int MeasureInterlocusSignalAttributesSM ();
 
 	virtual int FinalTestForPeakSizeAndNumberSM (double averageHeight, Boolean isNegCntl, Boolean isPosCntl, GenotypesForAMarkerSet* pGenotypes, RGDList& artifacts);
@@ -4758,7 +4758,7 @@ int Locus :: TestSampleAveragesSM (ChannelData* lsData, DataSignal* testSignal,
 }
 
 
-Boolean Locus :: ExtractExtendedSampleSignalsSM (RGDList& channelSignalList, Locus* gridLocus, CoordinateTransform* timeMap, Locus* prevGridLocus, Locus* followingGridLocus) {
+Boolean Locus :: ExtractExtendedSampleSignalsSM (RGDList& channelSignalList, Locus* gridLocus, CoordinateTransform* timeMap, Locus* prevGridLocus, Locus* followingGridLocus, const double* gridTimes) {
 
 	//
 	//  This is sample stage 1
@@ -4768,6 +4768,7 @@ Boolean Locus :: ExtractExtendedSampleSignalsSM (RGDList& channelSignalList, Loc
 	double gridTime;
 	DataSignal* nextSignal;
 	RGDListIterator it (channelSignalList);
+	int signalIndex = 0;
 	LocusSignalList.Clear ();
 	FinalSignalList.Clear ();
 	mSmartList.Clear ();
@@ -4857,8 +4858,16 @@ Boolean Locus :: ExtractExtendedSampleSignalsSM (RGDList& channelSignalList, Loc
 
 		while (nextSignal = (DataSignal*) it()) {
 
-			mean = nextSignal->GetMean ();
-			gridTime = timeMap->EvaluateWithExtrapolation (mean);
+			if (gridTimes != NULL)
+				gridTime = gridTimes [signalIndex];
+
+			else {
+
+				mean = nextSignal->GetMean ();
+				gridTime = timeMap->EvaluateWithExtrapolation (mean);
+			}
+
+			signalIndex++;
 
 			if (gridLocus->IsTimeWithinExtendedLocusSample (gridTime, location)) {
 
@@ -4947,8 +4956,16 @@ Boolean Locus :: ExtractExtendedSampleSignalsSM (RGDList& channelSignalList, Loc
 
 		while (nextSignal = (DataSignal*) it()) {
 
-			mean = nextSignal->GetMean ();
-			gridTime = timeMap->EvaluateWithExtrapolation (mean);
+			if (gridTimes != NULL)
+				gridTime = gridTimes [signalIndex];
+
+			else {
+
+				mean = nextSignal->GetMean ();
+				gridTime = timeMap->EvaluateWithExtrapolation (mean);
+			}
+
+			signalIndex++;
 
 		//	bpNext = (int)gridLocus->GetBPFromTimeForAnalysis (gridTime);
 			addSignalToLocus = false;
@@ -687,23 +687,29 @@ bool GenotypesForAMarkerSet :: AddLabPositiveControlStringsToControlLists (Synon
 
 IndividualGenotype* GenotypesForAMarkerSet :: FindGenotypeForFileName (const RGString& fileName) {
 
-	RGDListIterator it (mGenotypes);
-	IndividualGenotype* genotype;
-	RGString name;
-	size_t position = 0;
+	// The first genotype in the list whose search criterion the file name contains, found in one pass over the file
+	// name.  Genotypes are only ever added, so the search is rebuilt when the number of them changes
 
-	while (genotype = (IndividualGenotype*) it ()) {
+	if (mFileNameSearch.GetNumberOfStrings () != mGenotypes.Entries ()) {
 
-//		name = genotype->GetName ();
-		name = genotype->GetFileNameSearchCriterion ();
+		RGDListIterator it (mGenotypes);
+		IndividualGenotype* genotype;
+		mFileNameSearch.Clear ();
+		mFileNameSearchGenotypes.clear ();
 
-//		cout << "Control name = " << name.GetData () << endl;
+		while (genotype = (IndividualGenotype*) it ()) {
 
-		if (fileName.FindSubstringCaseIndependent (name, position))
-			return genotype;
+			mFileNameSearch.AddString (genotype->GetFileNameSearchCriterion (), (int)mFileNameSearchGenotypes.size ());
+			mFileNameSearchGenotypes.push_back (genotype);
+		}
 	}
 
-	return NULL;
+	int id = mFileNameSearch.FindSmallestId (fileName);
+
+	if (id < 0)
+		return NULL;
+
+	return mFileNameSearchGenotypes [id];
 }
 
 
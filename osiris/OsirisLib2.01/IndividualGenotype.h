@@ -39,6 +39,7 @@
 #include "rgstring.h"
 #include "rgdlist.h"
 #include "rghashtable.h"
+#include "rgmultisearch.h"
 #include "rgdefs.h"
 #include "SynonymList.h"
 
@@ -265,6 +266,8 @@ protected:
 	LocusCollection* mOffLadderAlleles;  // set of loci and alleles that are allowable off ladder alleles
 	LocusCollection* mSampleTriAlleles;  // set of loci and tri (or more) alleles allowable for samples
 	LocusCollection* mControlTriAlleles;  // set of loci and tri (or more) alleles allowable on positive controls
+	RGMultiStringSearch mFileNameSearch;  // file name search criteria of mGenotypes, with ids their positions in the list
+	vector<IndividualGenotype*> mFileNameSearchGenotypes;
 
 	static RGString PathToStandardControlFile;
 
@@ -35,6 +35,7 @@
 
 
 #include "LeastMedianOfSquares.h"
+#include "AnalysisProfiler.h"
 #include <stdlib.h>
 #include <math.h>
 #include <iostream>
@@ -196,6 +197,7 @@ LeastMedianOfSquares1D :: ~LeastMedianOfSquares1D () {
 
 double LeastMedianOfSquares1D :: CalculateLMS () {
 
+	AnalysisProfiler::Count (AnalysisProfiler::LMSFits);
 	int i;
 	list<double> sortList;
 	double* sortedArray = new double [mSize];
@@ -332,6 +334,7 @@ LeastMedianOfSquares2DExhaustive :: ~LeastMedianOfSquares2DExhaustive () {
 
 double LeastMedianOfSquares2DExhaustive :: CalculateLMS () {
 
+	AnalysisProfiler::Count (AnalysisProfiler::LMSFits);
 	IntersectionPoint*** vertexMatrix = CalculateIntersectionMatrix ();
 	int i;
 	int j;
@@ -1046,6 +1049,7 @@ QuadraticLMSExact :: ~QuadraticLMSExact () {
 
 double QuadraticLMSExact::CalculateLMS () {
 
+	AnalysisProfiler::Count (AnalysisProfiler::LMSFits);
 	// Calculate best median for each of fixed quadratic terms (slopes) and then select best median from among them.
 	// If no primary pull-up acceptable, there is no pull-up.
 
@@ -42,7 +42,7 @@ using namespace std;
 
 OsirisInputFile :: OsirisInputFile (bool debug) : mDebug (debug), mInputFile (NULL), mFinalStdSettingsName (), mCriticalOutputLevel (15), mMinSampleRFU (0.0),
 mMinLadderRFU (0.0), mMinLaneStandardRFU (0.0), mMinInterlocusRFU (0.0), mMinLadderInterlocusRFU (0.0), mSampleDetectionThreshold (-1.0), 
-mUseRawData (true), mUserNamedSettingsFiles (true), mIsLadderFreeAnalysis (false) {
+mUseRawData (true), mUserNamedSettingsFiles (true), mIsLadderFreeAnalysis (false), mTraceTimeline (false), mPlotSidecar (false) {
 
 	mInputLinesIterator = new RGDListIterator (mInputLines);
 	mAnalysisThresholds = new list<channelThreshold*>;
@@ -341,6 +341,29 @@ int OsirisInputFile :: AssignString () {
 		status = 0;
 	}
 
+	else if (mStringLeft == "TraceTimeline") {
+
+		if (mStringRight == "true")
+			mTraceTimeline = true;
+
+		status = 0;
+	}
+
+	else if (mStringLeft == "PlotSidecar") {
+
+		if (mStringRight == "true")
+			mPlotSidecar = true;
+
+		status = 0;
+	}
+
+	else if (mStringLeft == "SnapshotDirectory") {
+
+		SetEmbeddedSlashesToForward (mStringRight);
+		mSnapshotDirectory = mStringRight;
+		status = 0;
+	}
+
 	else if (mStringLeft == "LadderDirectory") {
 
 		SetEmbeddedSlashesToForward (mStringRight);
@@ -58,6 +58,7 @@ public:
 	RGString GetOutputSubDirectory () const { return mOutputSubDirectory; }
 	RGString GetLadderDirectory () const { return mLadderDirectory; }
 	RGString GetReportDirectory () const { return mReportDirectory; }
+	RGString GetSnapshotDirectory () const { return mSnapshotDirectory; }
 	RGString GetMarkerSetName () const { return mMarkerSetName; }
 	RGString GetLaneStandardName () const { return mLaneStandardName; }
 
@@ -89,6 +90,8 @@ public:
 	bool UseRawData () const { return mUseRawData; }
 	bool UserNamedSettingsFiles () const { return mUserNamedSettingsFiles; }
 	bool IsLadderFreeAnalysis () const { return mIsLadderFreeAnalysis; }
+	bool TraceTimeline () const { return mTraceTimeline; }
+	bool PlotSidecar () const { return mPlotSidecar; }
 
 	void ResetInputLines ();
 	RGString* GetNextInputLine ();
@@ -113,6 +116,7 @@ protected:
 	RGString mOutputSubDirectory;
 	RGString mLadderDirectory;
 	RGString mReportDirectory;
+	RGString mSnapshotDirectory;
 	RGString mMarkerSetName;
 	RGString mLaneStandardName;
 	
@@ -143,6 +147,8 @@ protected:
 	bool mUseRawData;
 	bool mUserNamedSettingsFiles;
 	bool mIsLadderFreeAnalysis;
+	bool mTraceTimeline;
+	bool mPlotSidecar;
 
 	list<channelThreshold*>* mAnalysisThresholds;
 	list<channelThreshold*>* mDetectionThresholds;
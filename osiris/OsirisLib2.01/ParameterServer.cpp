@@ -53,6 +53,7 @@
 #include "DataSignal.h"
 #include "RGTextOutput.h"
 #include "rgtokenizer.h"
+#include "rgxmlreader.h"
 #include "STRChannelData.h"
 #include "Genetics.h"
 #include "TestCharacteristic.h"
@@ -384,19 +385,14 @@ bool ParameterServer :: AddGenotypeCollection (const RGString& xmlString, bool i
 	RGString XMLString (xmlString);
 	RGString rfuString;
 	RGString dataTypeString;
-	RGXMLTagSearch FileTypeSearch ("DataFileType", XMLString);
-	RGXMLTagSearch ladderRFUSearch ("LadderRFUTests", XMLString);
-	RGXMLTagSearch laneStdRFUSearch ("LaneStandardRFUTests", XMLString);
-	RGXMLTagSearch sampleRFUSearch ("SampleRFUTests", XMLString);
+	RGXMLReader reader (xmlString);
 	size_t startOffset = 0;
 	size_t endOffset = 0;
 	double limit;
 	
 	if (isLabSettings) {
 
-		if (FileTypeSearch.FindNextTag (startOffset, endOffset, dataTypeString)) {
-
-			startOffset = endOffset;
+		if (reader.FindNextElement ("DataFileType", dataTypeString)) {
 
 			if (dataTypeString.Length () > 0)
 				DirectoryManager::SetDataFileType (dataTypeString);
@@ -410,13 +406,12 @@ bool ParameterServer :: AddGenotypeCollection (const RGString& xmlString, bool i
 			return false;
 		}
 
-		if (!ladderRFUSearch.FindNextTag (startOffset, endOffset, rfuString)) {
+		if (!reader.FindNextElement ("LadderRFUTests", rfuString)) {
 
 			cout << "Could not read lab settings ladder RFU search strings" << endl;
 			return false;
 		}
 
-		startOffset = endOffset;
 		rfuLimits.Reset ();
 
 		if (!ReadLadderLabLimits (rfuString, rfuLimits)) {
@@ -441,13 +436,12 @@ bool ParameterServer :: AddGenotypeCollection (const RGString& xmlString, bool i
 
 		Locus::SetGridFractionalFilter (limit);
 
-		if (!laneStdRFUSearch.FindNextTag (startOffset, endOffset, rfuString)) {
+		if (!reader.FindNextElement ("LaneStandardRFUTests", rfuString)) {
 
 			cout << "Could not read lab settings ILS strings" << endl;
 			return false;
 		}
 
-		startOffset = endOffset;
 		rfuLimits.Reset ();
 
 		if (!ReadRFULimits (rfuString, rfuLimits)) {
@@ -466,10 +460,10 @@ bool ParameterServer :: AddGenotypeCollection (const RGString& xmlString, bool i
 
 		STRLaneStandardChannelData::SetILSFractionalFilter (limit);
 
-		if (!sampleRFUSearch.FindNextTag (startOffset, endOffset, rfuString))
+		if (!reader.FindNextElement ("SampleRFUTests", rfuString))
 			return false;
 
-		startOffset = endOffset;
+		startOffset = reader.GetOffset ();
 		rfuLimits.Reset ();
 
 		if (!ReadSampleLabLimits (rfuString, rfuLimits))
@@ -1367,39 +1361,13 @@ bool ParameterServer :: ReadAlgorithmParameters (const RGString& xmlString) {
 
 bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 
-	RGString XMLString (xmlString);
+	RGXMLReader reader (xmlString);
 	RGString numString;
 	bool returnValue = true;
-	size_t startOffset = 0;
-	size_t endOffset = 0;
 	double numValue;
 	int intNumValue;
 
-	RGXMLTagSearch noiseSearch ("NoiseThreshold", XMLString);
-	RGXMLTagSearch windowWidthSearch ("WindowWidth", XMLString);
-	RGXMLTagSearch normalPeakSearch ("MinFitForNormalPeak", XMLString);
-	RGXMLTagSearch artifactSearch ("TriggerFitForArtifact", XMLString);
-	RGXMLTagSearch absoluteMinFitSearch ("AbsoluteMinimumFit", XMLString);
-	RGXMLTagSearch secondaryContentSearch ("TestForNegSecondaryContent", XMLString);
-	RGXMLTagSearch parametricFitSearch ("ParametricFitTolerance", XMLString);
-	RGXMLTagSearch integrationStepsSearch ("NumberOfIntegrationSteps", XMLString);
-	RGXMLTagSearch sigmaToleranceSearch ("SigmaTolerance", XMLString);
-	RGXMLTagSearch sigmaWidthSearch ("SigmaWidth", XMLString);
-	RGXMLTagSearch maxIterationsSearch ("MaximumIterations", XMLString);
-	RGXMLTagSearch sigmaRatioSearch ("SigmaRatio", XMLString);
-	RGXMLTagSearch spacingSearch ("InterSampleSpacing", XMLString);
-	RGXMLTagSearch signatureSigmaSearch ("SignatureSigma", XMLString);
-	RGXMLTagSearch blobDegreeSearch ("BlobDegree", XMLString);
-	RGXMLTagSearch minPeakDistanceSearch ("MinDistanceBetweenPeaks", XMLString);
-	RGXMLTagSearch endPointFractionSearch ("PeakFractionForEndPtTest", XMLString);
-	RGXMLTagSearch endPointLevelSearch ("PeakLevelForEndPtTest", XMLString);
-
-	RGXMLTagSearch lowTailHeightSearch ("LowTailHeightThreshold", XMLString);
-	RGXMLTagSearch lowTailSlopeSearch ("LowTailSlopeThreshold", XMLString);
-	RGXMLTagSearch minRegressionSamplesSearch ("MinSamplesForSlopeRegression", XMLString);
-
-
-	if (!noiseSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("NoiseThreshold", numString))
 		returnValue = false;
 
 	else {
@@ -1409,9 +1377,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		TracePrequalification::SetDefaultNoiseThreshold (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!windowWidthSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("WindowWidth", numString))
 		returnValue = false;
 
 	else {
@@ -1421,9 +1387,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		TracePrequalification::SetDefaultWindowWidth (intNumValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!normalPeakSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("MinFitForNormalPeak", numString))
 		returnValue = false;
 
 	else {
@@ -1432,9 +1396,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParametricCurve::SetMinimumFitThreshold (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!artifactSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("TriggerFitForArtifact", numString))
 		returnValue = false;
 
 	else {
@@ -1443,9 +1405,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParametricCurve::SetTriggerForArtifactTest (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!absoluteMinFitSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("AbsoluteMinimumFit", numString))
 		returnValue = false;
 
 	else {
@@ -1454,9 +1414,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParametricCurve::SetAbsoluteMinimumFit (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!secondaryContentSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("TestForNegSecondaryContent", numString))
 		returnValue = false;
 
 	else {
@@ -1470,9 +1428,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 			TestCharacteristic::SetGlobalTestForNegative (false);
 	}
 
-	startOffset = endOffset;
-
-	if (!parametricFitSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("ParametricFitTolerance", numString))
 		returnValue = false;
 
 	else {
@@ -1481,9 +1437,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParametricCurve::SetFitTolerance (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!integrationStepsSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("NumberOfIntegrationSteps", numString))
 		returnValue = false;
 
 	else {
@@ -1492,9 +1446,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParameterServer::SetNumberOfIntegrationSteps (intNumValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!sigmaToleranceSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("SigmaTolerance", numString))
 		returnValue = false;
 
 	else {
@@ -1503,9 +1455,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParameterServer::SetGaussianSigmaTolerance (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!sigmaWidthSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("SigmaWidth", numString))
 		returnValue = false;
 
 	else {
@@ -1514,9 +1464,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParameterServer::SetGaussianSigmaWidth (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!maxIterationsSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("MaximumIterations", numString))
 		returnValue = false;
 
 	else {
@@ -1525,9 +1473,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParameterServer::SetMaximumSearchIterations (intNumValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!sigmaRatioSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("SigmaRatio", numString))
 		returnValue = false;
 
 	else {
@@ -1536,9 +1482,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParameterServer::SetDoubleGaussianSigmaRatio (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!spacingSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("InterSampleSpacing", numString))
 		returnValue = false;
 
 	else {
@@ -1547,9 +1491,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParameterServer::SetInterSampleSpacing (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!signatureSigmaSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("SignatureSigma", numString))
 		returnValue = false;
 
 	else {
@@ -1558,9 +1500,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ParametricCurve::SetSigmaForSignature (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!blobDegreeSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("BlobDegree", numString))
 		returnValue = false;
 
 	else {
@@ -1569,9 +1509,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		SuperGaussian::SetBlobDegree (intNumValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!minPeakDistanceSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("MinDistanceBetweenPeaks", numString))
 		returnValue = false;
 
 	else {
@@ -1580,9 +1518,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		ChannelData::SetMinimumDistanceBetweenPeaks (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!endPointFractionSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("PeakFractionForEndPtTest", numString))
 		returnValue = false;
 
 	else {
@@ -1591,9 +1527,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		SampledData::SetPeakFractionForFlatCurveTest (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!endPointLevelSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("PeakLevelForEndPtTest", numString))
 		returnValue = false;
 
 	else {
@@ -1602,9 +1536,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		SampledData::SetPeakLevelForFlatCurveTest (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!lowTailHeightSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("LowTailHeightThreshold", numString))
 		returnValue = false;
 
 	else {
@@ -1613,9 +1545,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		TracePrequalification::SetLowHeightThreshold (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!lowTailSlopeSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("LowTailSlopeThreshold", numString))
 		returnValue = false;
 
 	else {
@@ -1624,9 +1554,7 @@ bool ParameterServer :: ReadCurveFitParameters (const RGString& xmlString) {
 		TracePrequalification::SetLowSlopeThreshold (numValue);
 	}
 
-	startOffset = endOffset;
-
-	if (!minRegressionSamplesSearch.FindNextTag (startOffset, endOffset, numString))
+	if (!reader.FindNextElement ("MinSamplesForSlopeRegression", numString))
 		returnValue = false;
 
 	else {
@@ -1883,53 +1811,38 @@ bool ParameterServer :: ReadLadderLabLimits (const RGString& xmlString, RFULimit
 
 bool ParameterServer :: ReadSampleLabLimits (const RGString& xmlString, RFULimitsStruct& rfuLimits) {
 
-	RGString XMLString (xmlString);
-	RGString result;
-	RGString locusThresholdString;
+	RGXMLReader reader (xmlString);
+	RGXMLView result;
+	RGXMLView locusThresholdString;
 	locusSpecificLimitsStruct limits;
 
-	RGXMLTagSearch minRFUSearch ("MinimumRFU", XMLString);
-	RGXMLTagSearch maxRFUSearch ("MaximumRFU", XMLString);
-	RGXMLTagSearch fractionOfMaxRFUSearch ("FractionOfMaxPeak", XMLString);
-	RGXMLTagSearch pullupFractionOfMaxRFUSearch ("PullupFractionalFilter", XMLString);
-	RGXMLTagSearch stutterThresholdSearch ("StutterThreshold", XMLString);
-	RGXMLTagSearch plusStutterThresholdSearch ("PlusStutterThreshold", XMLString);
-	RGXMLTagSearch adenylationThresholdSearch ("AdenylationThreshold", XMLString);
-
-	RGXMLTagSearch locusThresholdSearch ("LocusThreshold", XMLString);
-	RGXMLTagSearch locusNameSearch ("LocusName", locusThresholdString);
-	RGXMLTagSearch locusFractionalFilterSearch ("FractionOfMaxPeak", locusThresholdString);
-	RGXMLTagSearch locusPullupFractionSearch ("PullupFractionalFilter", locusThresholdString);
-	RGXMLTagSearch locusStutterSearch ("StutterThreshold", locusThresholdString);
-	RGXMLTagSearch locusStutterSearchRight ("StutterThresholdRight", locusThresholdString);
-	RGXMLTagSearch locusPlusStutterSearch ("PlusStutterThreshold", locusThresholdString);
-	RGXMLTagSearch locusPlusStutterSearchRight ("PlusStutterThresholdRight", locusThresholdString);
-	RGXMLTagSearch locusAdenylationSearch ("AdenylationThreshold", locusThresholdString);
-	RGXMLTagSearch locusHeterozygousImbalanceSearch ("HeterozygousImbalanceLimit", locusThresholdString);
-	RGXMLTagSearch locusBoundForHomozygoteSearch ("MinBoundForHomozygote", locusThresholdString);
-
-	int totalLength = XMLString.Length ();
+	int totalLength = xmlString.Length ();
 	size_t endDefaults;
 
-	if (!XMLString.FindSubstring ("<LocusThreshold>", endDefaults))
+	if (!xmlString.FindSubstring ("<LocusThreshold>", endDefaults))
 		endDefaults = totalLength;
 	
+	// The defaults precede the first LocusThreshold; a default found only within a locus threshold is treated as
+	// missing, and the search for the next default starts where this one did
+
 	size_t startOffset = 0;
 	size_t endOffset = 0;
 
-	if (minRFUSearch.FindNextTag (startOffset, endOffset, result)) {
+	if (reader.FindNextElement ("MinimumRFU", result)) {
 
-		startOffset = endOffset;
+		startOffset = reader.GetOffset ();
 		rfuLimits.minRFU = result.ConvertToDouble ();
 	}
 
 	else
 		rfuLimits.minRFU = 1.0;
 
-	if (!maxRFUSearch.FindNextTag (startOffset, endOffset, result))
+	if (!reader.FindNextElement ("MaximumRFU", result))
 		return false;
 
-	if (endOffset < endDefaults) {
+	endOffset = reader.GetOffset ();
+
+	if (endOffset <= endDefaults) {
 
 		startOffset = endOffset;
 		rfuLimits.maxRFU = result.ConvertToDouble ();
@@ -1938,18 +1851,26 @@ bool ParameterServer :: ReadSampleLabLimits (const RGString& xmlString, RFULimit
 	else
 		rfuLimits.maxRFU = -1.0;
 
-	if (!fractionOfMaxRFUSearch.FindNextTag (startOffset, endOffset, result))
+	reader.SetOffset (startOffset);
+
+	if (!reader.FindNextElement ("FractionOfMaxPeak", result))
 		return false;
 
-	if (endOffset < endDefaults) {
+	endOffset = reader.GetOffset ();
+
+	if (endOffset <= endDefaults) {
 
 		startOffset = endOffset;
 		rfuLimits.fractionOfMaxPeak = result.ConvertToDouble ();
 	}
 
-	if (pullupFractionOfMaxRFUSearch.FindNextTag (startOffset, endOffset, result)) {
+	reader.SetOffset (startOffset);
+
+	if (reader.FindNextElement ("PullupFractionalFilter", result)) {
 
-		if (endOffset < endDefaults) {
+		endOffset = reader.GetOffset ();
+
+		if (endOffset <= endDefaults) {
 
 			startOffset = endOffset;
 			rfuLimits.pullupFractionOfMaxPeak = result.ConvertToDouble ();
@@ -1962,10 +1883,14 @@ bool ParameterServer :: ReadSampleLabLimits (const RGString& xmlString, RFULimit
 	else
 		rfuLimits.pullupFractionOfMaxPeak = -1.0;
 
-	if (!stutterThresholdSearch.FindNextTag (startOffset, endOffset, result))
+	reader.SetOffset (startOffset);
+
+	if (!reader.FindNextElement ("StutterThreshold", result))
 		return false;
 
-	if (endOffset < endDefaults) {
+	endOffset = reader.GetOffset ();
+
+	if (endOffset <= endDefaults) {
 
 		startOffset = endOffset;
 		rfuLimits.stutterThreshold = result.ConvertToDouble ();
@@ -1974,9 +1899,13 @@ bool ParameterServer :: ReadSampleLabLimits (const RGString& xmlString, RFULimit
 	else
 		rfuLimits.stutterThreshold = -1.0;
 
-	if (plusStutterThresholdSearch.FindNextTag (startOffset, endOffset, result)) {
+	reader.SetOffset (startOffset);
 
-		if (endOffset < endDefaults) {
+	if (reader.FindNextElement ("PlusStutterThreshold", result)) {
+
+		endOffset = reader.GetOffset ();
+
+		if (endOffset <= endDefaults) {
 
 			startOffset = endOffset;
 			rfuLimits.plusStutterThreshold = result.ConvertToDouble ();
@@ -1989,10 +1918,14 @@ bool ParameterServer :: ReadSampleLabLimits (const RGString& xmlString, RFULimit
 	else
 		rfuLimits.plusStutterThreshold = -1.0;
 
-	if (!adenylationThresholdSearch.FindNextTag (startOffset, endOffset, result))
+	reader.SetOffset (startOffset);
+
+	if (!reader.FindNextElement ("AdenylationThreshold", result))
 		return false;
 
-	if (endOffset < endDefaults) {
+	endOffset = reader.GetOffset ();
+
+	if (endOffset <= endDefaults) {
 
 		startOffset = endOffset;
 		rfuLimits.adenylationThreshold = result.ConvertToDouble ();
@@ -2001,145 +1934,91 @@ bool ParameterServer :: ReadSampleLabLimits (const RGString& xmlString, RFULimit
 	else
 		rfuLimits.adenylationThreshold = -1.0;
 
-	size_t startLocusOffset;
-	size_t endLocusOffset;
+	reader.SetOffset (startOffset);
 
-	while (locusThresholdSearch.FindNextTag (startOffset, endOffset, locusThresholdString)) {
+	while (reader.FindNextElement ("LocusThreshold", locusThresholdString)) {
 
-		startOffset = endOffset;
-		startLocusOffset = 0;
-		locusNameSearch.ResetSearch ();
-		locusFractionalFilterSearch.ResetSearch ();
-		locusPullupFractionSearch.ResetSearch ();
-		locusStutterSearch.ResetSearch ();
-		locusStutterSearchRight.ResetSearch ();
-		locusPlusStutterSearch.ResetSearch ();
-		locusPlusStutterSearchRight.ResetSearch ();
-		locusAdenylationSearch.ResetSearch ();
-		locusHeterozygousImbalanceSearch.ResetSearch ();
-		locusBoundForHomozygoteSearch.ResetSearch ();
+		startOffset = reader.GetOffset ();
+		RGXMLReader locusReader (locusThresholdString);
 
-		if (!locusNameSearch.FindNextTag (startLocusOffset, endLocusOffset, result))
+		if (!locusReader.FindNextElement ("LocusName", result))
 			return false;
 
-		startLocusOffset = endLocusOffset;
 		limits.Reset ();
-		limits.locusName = result;
-
-		if (locusFractionalFilterSearch.FindNextTag (startLocusOffset, endLocusOffset, result)) {
+		result.CopyTo (limits.locusName);
 
-			startLocusOffset = endLocusOffset;
+		if (locusReader.FindNextElement ("FractionOfMaxPeak", result))
 			limits.fractionOfMaxPeak = result.ConvertToDouble ();
-		}
-
-		if (locusPullupFractionSearch.FindNextTag (startLocusOffset, endLocusOffset, result)) {
 
-			startLocusOffset = endLocusOffset;
+		if (locusReader.FindNextElement ("PullupFractionalFilter", result))
 			limits.pullupFractionalFilter = result.ConvertToDouble ();
-		}
 
-		if (locusStutterSearch.FindNextTag (startLocusOffset, endLocusOffset, result)) {
+		if (locusReader.FindNextElement ("StutterThreshold", result)) {
 
-			startLocusOffset = endLocusOffset;
 			limits.stutterThreshold = result.ConvertToDouble ();
 
-			if (locusStutterSearchRight.FindNextTag (startLocusOffset, endLocusOffset, result)) {
-
-				startLocusOffset = endLocusOffset;
+			if (locusReader.FindNextElement ("StutterThresholdRight", result))
 				limits.stutterThresholdRight = result.ConvertToDouble ();
-			}
 		}
 
-		if (locusPlusStutterSearch.FindNextTag (startLocusOffset, endLocusOffset, result)) {
+		if (locusReader.FindNextElement ("PlusStutterThreshold", result)) {
 
-			startLocusOffset = endLocusOffset;
 			limits.plusStutterThreshold = result.ConvertToDouble ();
 
-			if (locusPlusStutterSearchRight.FindNextTag (startLocusOffset, endLocusOffset, result)) {
-
-				startLocusOffset = endLocusOffset;
+			if (locusReader.FindNextElement ("PlusStutterThresholdRight", result))
 				limits.plusStutterThresholdRight = result.ConvertToDouble ();
-			}
 		}
 
-		if (locusAdenylationSearch.FindNextTag (startLocusOffset, endLocusOffset, result)) {
-
-			startLocusOffset = endLocusOffset;
+		if (locusReader.FindNextElement ("AdenylationThreshold", result))
 			limits.adenylationThreshold = result.ConvertToDouble ();
-		}
-
-		if (locusHeterozygousImbalanceSearch.FindNextTag (startLocusOffset, endLocusOffset, result)) {
 
-			startLocusOffset = endLocusOffset;
+		if (locusReader.FindNextElement ("HeterozygousImbalanceLimit", result))
 			limits.heterozygousImbalanceLimit = result.ConvertToDouble ();
-		}
 
-		if (locusBoundForHomozygoteSearch.FindNextTag (startLocusOffset, endLocusOffset, result)) {
-
-			startLocusOffset = endLocusOffset;
+		if (locusReader.FindNextElement ("MinBoundForHomozygote", result))
 			limits.minBoundForHomozygote = result.ConvertToDouble ();
-		}
 
 		AddSampleLocusSpecificThreshold (limits);
 	}
 
-	RGString nsStutterThresholdString;
-	RGString nsStutterLocusThresholdString;
-	RGString nsRatioString;
+	RGXMLView nsStutterThresholdString;
+	RGXMLView nsStutterLocusThresholdString;
+	RGXMLView nsRatioString;
 	locusSpecificNonStandardStutterStruct nsLocusStutter;
 
-	RGXMLTagSearch nonStandardStutterSearch ("NsStutterThresholds", XMLString);
-	RGXMLTagSearch nonStandardLocusSearch ("Locus", nsStutterThresholdString);
-	RGXMLTagSearch nonStandardLocusNameSearch ("Name", nsStutterLocusThresholdString);
-	RGXMLTagSearch nonStandardLocusThresholdSearch ("Threshold", nsStutterLocusThresholdString);
-	RGXMLTagSearch nonStandardLocusBpSearch ("Bps", nsRatioString);
-	RGXMLTagSearch nonStandardLocusRatioSearch ("Ratio", nsRatioString);
-
 	cout << "Start offset for non-standard stutter = " << startOffset << endl;
 
-	if (nonStandardStutterSearch.FindNextTag (startOffset, endOffset, nsStutterThresholdString)) {
+	if (reader.FindNextElement ("NsStutterThresholds", nsStutterThresholdString)) {
 
-		startOffset = endOffset;
-		startLocusOffset = endLocusOffset = 0;
-		nonStandardLocusSearch.ResetSearch ();
+		RGXMLReader nsReader (nsStutterThresholdString);
 
-		while (nonStandardLocusSearch.FindNextTag (startLocusOffset, endLocusOffset, nsStutterLocusThresholdString)) {
+		while (nsReader.FindNextElement ("Locus", nsStutterLocusThresholdString)) {
 
-			startLocusOffset = endLocusOffset;
-			nonStandardLocusNameSearch.ResetSearch ();
-			nonStandardLocusThresholdSearch.ResetSearch ();
-			size_t locusThresholdStartOffset = 0;
-			size_t locusThresholdEndOffset = 0;
+			RGXMLReader nsLocusReader (nsStutterLocusThresholdString);
 			nsLocusStutter.Reset ();
 
-			if (!nonStandardLocusNameSearch.FindNextNonemptyTag (locusThresholdStartOffset, locusThresholdEndOffset, result)) {
+			if (!nsLocusReader.FindNextNonemptyElement ("Name", nsLocusStutter.locusName)) {
 
 				cout << "Could not find locus name in non-standard stutter set-up" << endl;
 				return false;
 			}
 
-			locusThresholdStartOffset = locusThresholdEndOffset;
-			nsLocusStutter.locusName = result;
-
-			while (nonStandardLocusThresholdSearch.FindNextTag (locusThresholdStartOffset, locusThresholdEndOffset, nsRatioString)) {
+			while (nsLocusReader.FindNextElement ("Threshold", nsRatioString)) {
 
-				locusThresholdStartOffset = locusThresholdEndOffset;
-				nonStandardLocusBpSearch.ResetSearch ();
-				nonStandardLocusRatioSearch.ResetSearch ();
-				size_t thisStart = 0;
-				size_t thisEnd = 0;
+				RGXMLReader ratioReader (nsRatioString);
 				int bp;
 				double threshold;
 
-				if (!nonStandardLocusBpSearch.FindNextTag (thisStart, thisEnd, result)) {
+				if (!ratioReader.FindNextElement ("Bps", result)) {
 
 					cout << "Could not find bps in non-standard stutter search for locus named " << (char*) nsLocusStutter.locusName.GetData () << endl;
 					return false;
 				}
 
 				bp = result.ConvertToInteger ();
+				ratioReader.Reset ();
 
-				if (!nonStandardLocusRatioSearch.FindNextTag (thisStart, thisEnd, result)) {
+				if (!ratioReader.FindNextElement ("Ratio", result)) {
 
 					cout << "Could not find ratio in non-standard stutter search for locus named " << (char*) nsLocusStutter.locusName.GetData () << endl;
 					return false;
@@ -0,0 +1,212 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: PeakTimeIndex.cpp
+*
+*/
+//
+//  class PeakTimeIndex is a per-sample index of the peaks in all channels, used to find candidate pull-up peaks near a primary
+//  peak.  Because the window ends at the first peak beyond a limit, not at the last peak within it, a window end is found by
+//  binary search only when the running extreme identifies it; otherwise (an out of order peak on the near side) it is found
+//  by a scan
+//
+
+#include "PeakTimeIndex.h"
+#include "DataSignal.h"
+#include "rgdlist.h"
+#include <algorithm>
+
+using namespace std;
+
+
+PeakTimeIndex :: PeakTimeIndex () {
+
+}
+
+
+PeakTimeIndex :: ~PeakTimeIndex () {
+
+}
+
+
+void PeakTimeIndex :: Build (RGDList& peaks, int numberOfChannels) {
+
+	RGDListIterator it (peaks);
+	DataSignal* nextSignal;
+	int channel;
+	int i;
+	int n;
+
+	Clear ();
+	n = (int)peaks.Entries ();
+	mPeaks.reserve (n);
+	mMeans.reserve (n);
+	mChannels.reserve (n);
+	mChannelPositions.resize (numberOfChannels + 1);
+
+	while (nextSignal = (DataSignal*) it ()) {
+
+		channel = nextSignal->GetChannel ();
+
+		if ((channel < 0) || (channel > numberOfChannels))
+			channel = 0;
+
+		mChannelPositions [channel].push_back ((int)mPeaks.size ());
+		mPeaks.push_back (nextSignal);
+		mMeans.push_back (nextSignal->GetMean ());
+		mChannels.push_back (channel);
+	}
+
+	mMaxMeanThrough.resize (n);
+	mMinMeanFrom.resize (n);
+
+	for (i=0; i<n; i++) {
+
+		if ((i == 0) || (mMeans [i] > mMaxMeanThrough [i - 1]))
+			mMaxMeanThrough [i] = mMeans [i];
+
+		else
+			mMaxMeanThrough [i] = mMaxMeanThrough [i - 1];
+	}
+
+	for (i=n-1; i>=0; i--) {
+
+		if ((i == n - 1) || (mMeans [i] < mMinMeanFrom [i + 1]))
+			mMinMeanFrom [i] = mMeans [i];
+
+		else
+			mMinMeanFrom [i] = mMinMeanFrom [i + 1];
+	}
+}
+
+
+void PeakTimeIndex :: Clear () {
+
+	mPeaks.clear ();
+	mMeans.clear ();
+	mChannels.clear ();
+	mMaxMeanThrough.clear ();
+	mMinMeanFrom.clear ();
+	mChannelPositions.clear ();
+	mSelected.clear ();
+}
+
+
+void PeakTimeIndex :: FindCrossChannelNeighbors (int position, double leftLimit, double rightLimit, vector<DataSignal*>& following, vector<DataSignal*>& preceding) {
+
+	int channel = mChannels [position];
+	int last = FindFollowingLimit (position, rightLimit);
+	int first = FindPrecedingLimit (position, leftLimit);
+	int c;
+	size_t i;
+	vector<int>::const_iterator p;
+	vector<int>::const_iterator pEnd;
+
+	following.clear ();
+	preceding.clear ();
+	mSelected.clear ();
+
+	// positions after position and before last, on other channels
+
+	for (c=0; c<(int)mChannelPositions.size (); c++) {
+
+		if (c == channel)
+			continue;
+
+		const vector<int>& positions = mChannelPositions [c];
+		pEnd = positions.end ();
+
+		for (p=upper_bound (positions.begin (), pEnd, position); (p != pEnd) && (*p < last); p++)
+			mSelected.push_back (*p);
+	}
+
+	sort (mSelected.begin (), mSelected.end ());
+
+	for (i=0; i<mSelected.size (); i++)
+		following.push_back (mPeaks [mSelected [i]]);
+
+	// positions after first and before position, on other channels, nearest first
+
+	mSelected.clear ();
+
+	for (c=0; c<(int)mChannelPositions.size (); c++) {
+
+		if (c == channel)
+			continue;
+
+		const vector<int>& positions = mChannelPositions [c];
+		pEnd = lower_bound (positions.begin (), positions.end (), position);
+
+		for (p=upper_bound (positions.begin (), pEnd, first); p != pEnd; p++)
+			mSelected.push_back (*p);
+	}
+
+	sort (mSelected.begin (), mSelected.end ());
+
+	for (i=mSelected.size (); i>0; i--)
+		preceding.push_back (mPeaks [mSelected [i - 1]]);
+}
+
+
+int PeakTimeIndex :: FindFollowingLimit (int position, double rightLimit) const {
+
+	//  The first position after position with mean above rightLimit, or the number of peaks.  Before the first position at which
+	//  the running maximum exceeds rightLimit, no mean does; if that position is beyond position, it is the answer
+
+	int n = (int)mPeaks.size ();
+	int k = (int)(upper_bound (mMaxMeanThrough.begin (), mMaxMeanThrough.end (), rightLimit) - mMaxMeanThrough.begin ());
+
+	if (k > position)
+		return k;
+
+	for (k=position+1; k<n; k++) {
+
+		if (mMeans [k] > rightLimit)
+			break;
+	}
+
+	return k;
+}
+
+
+int PeakTimeIndex :: FindPrecedingLimit (int position, double leftLimit) const {
+
+	//  The last position before position with mean below leftLimit, or -1.  After the last position at which the running
+	//  minimum is below leftLimit, no mean is; if that position is before position, it is the answer
+
+	int k = (int)(lower_bound (mMinMeanFrom.begin (), mMinMeanFrom.end (), leftLimit) - mMinMeanFrom.begin ()) - 1;
+
+	if (k < position)
+		return k;
+
+	for (k=position-1; k>=0; k--) {
+
+		if (mMeans [k] < leftLimit)
+			break;
+	}
+
+	return k;
+}
+
@@ -0,0 +1,80 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: PeakTimeIndex.h
+*
+*/
+//
+//  class PeakTimeIndex is a per-sample index of the peaks in all channels, in the order of a list merged by increasing mean, used
+//  to find candidate pull-up peaks near a primary peak without walking the whole neighborhood.  For each channel, it keeps the
+//  list positions of that channel's peaks, so the peaks on other channels within a window are found with a binary search per
+//  channel, and the ends of the window with a binary search over running extremes of the means.  Neighbors are returned in the
+//  order in which a scan outward from the primary, stopping at the first peak on any channel beyond the window, would visit them,
+//  even when the merged list is not perfectly sorted
+//
+
+#ifndef _PEAKTIMEINDEX_H_
+#define _PEAKTIMEINDEX_H_
+
+#include <vector>
+
+class DataSignal;
+class RGDList;
+
+
+class PeakTimeIndex {
+
+public:
+	PeakTimeIndex ();
+	~PeakTimeIndex ();
+
+	void Build (RGDList& peaks, int numberOfChannels);   // peaks' channels must be set
+	void Clear ();
+
+	int GetNumberOfPeaks () const { return (int)mPeaks.size (); }
+	DataSignal* GetPeak (int position) const { return mPeaks [position]; }
+
+	//  Peaks on channels other than that of the peak at position, up to but not including the first peak (on any channel) with
+	//  mean above rightLimit in the forward direction and below leftLimit in the backward direction.  following is in list order
+	//  and preceding in reverse list order, i.e., nearest first in both
+
+	void FindCrossChannelNeighbors (int position, double leftLimit, double rightLimit, std::vector<DataSignal*>& following, std::vector<DataSignal*>& preceding);
+
+protected:
+	std::vector<DataSignal*> mPeaks;
+	std::vector<double> mMeans;
+	std::vector<int> mChannels;
+	std::vector<double> mMaxMeanThrough;   // largest mean at or before each position
+	std::vector<double> mMinMeanFrom;   // smallest mean at or after each position
+	std::vector<std::vector<int> > mChannelPositions;   // for each channel, the positions of its peaks, ascending
+	std::vector<int> mSelected;
+
+	int FindFollowingLimit (int position, double rightLimit) const;
+	int FindPrecedingLimit (int position, double leftLimit) const;
+};
+
+
+#endif  /*  _PEAKTIMEINDEX_H_  */
+
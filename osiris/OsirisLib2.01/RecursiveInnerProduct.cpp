@@ -33,6 +33,7 @@
 //
 
 #include "RecursiveInnerProduct.h"
+#include "AnalysisProfiler.h"
 
 
 RecursiveInnerProduct :: RecursiveInnerProduct (RGDList& signalList, const double* idealPts, const double* idealDiffs, const int* htIndices, const double* idealNorm2s, int setSize, double maxHeight, int allowedDiscrepancy) :
@@ -190,6 +191,7 @@ int RecursiveInnerProduct :: BuildFromRight (double cumNorm2, double cumIP, int
 	mLastSignalIndex = lastSignalIndex;
 	mLastIdealIndex = lastIdealIndex;
 	mFromLeft = false;
+	AnalysisProfiler::Count (AnalysisProfiler::ILSNodesVisited);
 
 	double diff;
 	double norm2;
@@ -309,6 +311,7 @@ int RecursiveInnerProduct :: BuildFromLeft (double cumNorm2, double cumIP, int p
 	mLastSignalIndex = lastSignalIndex;
 	mLastIdealIndex = lastIdealIndex;
 	mFromLeft = true;
+	AnalysisProfiler::Count (AnalysisProfiler::ILSNodesVisited);
 
 	double diff;
 	double norm2;
@@ -3931,6 +3931,16 @@ int STRLaneStandardChannelData :: WriteBaselineData (RGTextOutput& text, const R
 }
 
 
+int* STRLaneStandardChannelData :: CreateBaselineDataArray (int& start, int& numberOfValues) {
+
+	// No baseline is written for the lane standard
+
+	start = 0;
+	numberOfValues = 0;
+	return NULL;
+}
+
+
 double STRLaneStandardChannelData :: DotProductWithQuadraticFit (RGDList& set, int size, const double* idealValues, const double* idealDifferences, double idealNorm2) {
 
 	QuadraticFit fit;
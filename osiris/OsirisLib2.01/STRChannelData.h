@@ -196,6 +196,7 @@ public:
 	virtual double GetMeasurementRatio () const;
 	virtual bool IsControlChannel () const { return true; }
 	virtual int WriteBaselineData (RGTextOutput& text, const RGString& delim, const RGString& indent);
+	virtual int* CreateBaselineDataArray (int& start, int& numberOfValues);
 
 
 	// Obsolete...not used**********************************************************************************************************************
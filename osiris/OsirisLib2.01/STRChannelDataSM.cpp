@@ -4145,14 +4145,35 @@ int STRSampleChannelData :: AssignSampleCharacteristicsToLociSM (CoreBioComponen
 
 	mTimeMap = timeMap;  // do not delete this...it is deleted in CoreBioComponent
 
+	// Each locus searches the preliminary curves for its own, so map all of them to ladder time once, in one pass
+
+	DataSignal* nextSignal;
+	RGDListIterator pIt (PreliminaryCurveList);
+	int numberOfSignals = PreliminaryCurveList.Entries ();
+	double* means = new double [numberOfSignals + 1];
+	double* gridTimes = new double [numberOfSignals + 1];
+	int i = 0;
+
+	while (nextSignal = (DataSignal*) pIt ()) {
+
+		means [i] = nextSignal->GetMean ();
+		i++;
+	}
+
+	timeMap->EvaluateSorted (means, gridTimes, numberOfSignals);
+	delete[] means;
+
 	nextLocus = (Locus*) it ();
 
 	while (nextLocus != NULL) {
 
 		gridLocus = grid->FindLocus (mChannel, nextLocus->GetLocusName ());
 
-		if (gridLocus == NULL)
+		if (gridLocus == NULL) {
+
+			delete[] gridTimes;
 			return -1;  // this should never happen...it means that the channel has a locus that the grid has never heard of, but have to test...
+		}
 
 		if (prevLocus == NULL)
 			prevGridLocus = NULL;
@@ -4168,17 +4189,18 @@ int STRSampleChannelData :: AssignSampleCharacteristicsToLociSM (CoreBioComponen
 		else
 			followingGridLocus = grid->FindLocus (mChannel, followingLocus->GetLocusName ());
 
-		nextLocus->ExtractExtendedSampleSignalsSM (PreliminaryCurveList, gridLocus, timeMap, prevGridLocus, followingGridLocus);
+		nextLocus->ExtractExtendedSampleSignalsSM (PreliminaryCurveList, gridLocus, timeMap, prevGridLocus, followingGridLocus, gridTimes);
 
 		prevLocus = nextLocus;
 		nextLocus = followingLocus;
 	}
 
+	delete[] gridTimes;
+
 	// Done extracting all signals from list that lie within a locus.  What remains is inside the internal lane standard but outside all loci.  Now remove
 	// any signals remaining in PreliminaryCurveList that lie in any extended locus
 
-	DataSignal* nextSignal;
-	RGDListIterator pIt (PreliminaryCurveList);
+	pIt.Reset ();
 	bool isCore;
 	bool belongsLeft;
 	bool belongsRight;
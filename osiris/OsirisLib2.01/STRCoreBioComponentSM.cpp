@@ -46,6 +46,10 @@
 #include "STRSmartNotices.h"
 #include "DirectoryManager.h"
 #include "rgtarray.h"
+#include "AnalysisProfiler.h"
+#include "AnalysisTrace.h"
+#include "plotsidecar.h"
+#include "PeakTimeIndex.h"
 #include <set>
 #include <string>
 #include <iostream>
@@ -63,6 +67,8 @@ int STRCoreBioComponent :: AnalyzeGridSM (RGTextOutput& text, RGTextOutput& Exce
 
 int STRCoreBioComponent :: AnalyzeCrossChannelSM () {
 
+	ProfileTimer timer (AnalysisProfiler::PullupAnalysis);
+
 	// This is to be called after CoreBioComponent::FitAllCharacteristics...and BEFORE AnalyzeLaneStandardChannel
 	int size = mNumberOfChannels + 1;
 	DataSignal** OnDeck = new DataSignal* [size];
@@ -1625,6 +1631,8 @@ int STRCoreBioComponent :: AnalyzeCrossChannelWithNegativePeaksSM () {
 
 int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksSM () {
 
+	ProfileTimer timer (AnalysisProfiler::PullupAnalysis);
+
 	//
 	//  This is sample stage 1 - called after ILS is analyzed
 	//
@@ -2100,8 +2108,6 @@ int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksS
 	// OverAllList contains all peaks, including positive and negative, and merged in order of increasing mean value.
 
 	RGDListIterator it (OverallList);
-	RGDListIterator Pos (OverallList);
-	RGDListIterator Neg (OverallList);
 	cout << "Number of overall signals:  " << (int)OverallList.Entries() << endl;
 	RGDList peaksWithNonPositiveHeights;
 	i = 0;
@@ -2195,10 +2201,19 @@ int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksS
 	bool laserStatus;
 	smSelectUserSpecifiedMinRFUForPrimaryPeakPreset useSpecifiedMinRFUForPrimary;
 	bool userSpecifiedMinRFUForPrimary = GetMessageValue (useSpecifiedMinRFUForPrimary);
+	PeakTimeIndex peakIndex;
+	vector<DataSignal*> followingPeaks;
+	vector<DataSignal*> precedingPeaks;
+	int peakPosition;
+	size_t k;
 
-	while (nextSignal = (DataSignal*) it ()) {
+	peakIndex.Build (OverallList, mNumberOfChannels);
+
+	for (peakPosition=0; peakPosition<peakIndex.GetNumberOfPeaks (); peakPosition++) {
+
+		nextSignal = peakIndex.GetPeak (peakPosition);
 
-		// First test if above primaryThreshold and is not negative.  If so, search in vicinity using Pos and Neg to find peaks within region that could be pull-up
+		// First test if above primaryThreshold and is not negative.  If so, search in vicinity using peakIndex to find peaks on other channels within region that could be pull-up
 
 	//	report = false;
 
@@ -2234,8 +2249,6 @@ int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksS
 		// any peaks on other channels that fall within the pull-up tolerance of the primary peak's mean.  Laser off scale between possible primary and possible pull-up mush
 		// match.  Ignore peaks on the same channel as the primary.  Peaks in pull-up channels must be of lesser height than primary peak.
 
-		Pos.ResetTo (it);
-		Neg.ResetTo (it);
 		primeSignal = nextSignal;	
 		primaryWidth = 0.5 * nextSignal->GetWidth ();
 		primaryTolerance = nextSignal->GetPrimaryPullupDisplacementThreshold (nSigmasForPullup);
@@ -2248,17 +2261,16 @@ int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksS
 		weakPullupPeaks.Clear ();
 		laserStatus = primeSignal->GetMessageValue (laserOffScale);
 
-		// Starting at the primary mean, search in the positive direction
+		// Starting at the primary mean, search in the positive direction.  The index stops each direction at the first peak, on any channel, that is
+		// too far away, and omits peaks on the primary channel
 
-		while (nextSignal2 = (DataSignal*)(++Pos)) {
+		peakIndex.FindCrossChannelNeighbors (peakPosition, leftLimitPlus, rightLimitPlus, followingPeaks, precedingPeaks);
 
-			if (nextSignal2->GetMean () > rightLimit) {
+		for (k=0; k<followingPeaks.size (); k++) {
 
-				if (nextSignal2->GetMean () > rightLimitPlus)
-					break;  // too far away; we're done in this direction
+			nextSignal2 = followingPeaks [k];
 
-				if (nextSignal2->GetChannel () == primaryChannel)
-					continue;
+			if (nextSignal2->GetMean () > rightLimit) {
 
 				//This next test is for a peak in the pull-up channel that interferes, above noise level, with primary without being close enough to be called pull-up
 				//The existence of such peaks make the primary "occluded" in that pull-up channel
@@ -2269,9 +2281,6 @@ int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksS
 				continue;
 			}
 
-			if (nextSignal2->GetChannel () == primaryChannel)
-				continue;  //  oops. same channel
-
 			if (nextSignal2->IsNegativePeak ()) {
 
 				probablePullupPeaks.Append (nextSignal2);  // height doesn't matter; negative peaks have to come from pull-up
@@ -2293,15 +2302,11 @@ int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksS
 
 		// Starting at the primary mean, search in the negative direction
 
-		while (nextSignal2 = (DataSignal*)(--Neg)) {
+		for (k=0; k<precedingPeaks.size (); k++) {
 
-			if (nextSignal2->GetMean () < leftLimit) {
-
-				if (nextSignal2->GetMean () < leftLimitPlus)
-					break;  // too far away; we're done in this direction
+			nextSignal2 = precedingPeaks [k];
 
-				if (nextSignal2->GetChannel () == primaryChannel)
-					continue;
+			if (nextSignal2->GetMean () < leftLimit) {
 
 				if (TestForWeakPullup (primaryMean, nextSignal2))
 					weakPullupPeaks.Prepend (nextSignal2);
@@ -2309,9 +2314,6 @@ int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksS
 				continue;
 			}
 
-			if (nextSignal2->GetChannel () == primaryChannel)
-				continue;  //  oops. same channel
-
 			if (nextSignal2->IsNegativePeak ()) {
 
 				probablePullupPeaks.Append (nextSignal2);  // height doesn't matter; negative peaks have to come from pull-up
@@ -2546,6 +2548,7 @@ int STRCoreBioComponent :: AnalyzeCrossChannelUsingPrimaryWidthAndNegativePeaksS
 	}
 
 	ignoreSidePeaks.Clear ();
+	peakIndex.Clear ();
 
 	// Done finding all probable pull-ups and primary pull-ups.  Now edit previously created multi-peak list to remove those that are not really multi-peaks because they have no cross channel affect
 
@@ -3779,6 +3782,8 @@ int STRCoreBioComponent :: UseChannelPatternsToAssessCrossChannelWithNegativePea
 
 int STRCoreBioComponent :: WriteXMLGraphicDataSM (const RGString& graphicDirectory, const RGString& localFileName, SampleData* data, int analysisStage, const RGString& intro) {
 
+	ProfileTimer timer (AnalysisProfiler::OutputWriting);
+
 	RGString fileName = localFileName;
 	int begin;
 	RGString pResult;
@@ -3825,31 +3830,47 @@ int STRCoreBioComponent :: WriteXMLGraphicDataSM (const RGString& graphicDirecto
 		output << indent << "<associatedLadder></associatedLadder>" << endLine;
 
 	RGString indent2 = indent + indent;
+	PlotSidecar* sidecar = CoreBioComponent::GetWritePlotSidecar () ? new PlotSidecar : NULL;
+	int* values;
+	int numberOfValues;
+	int baselineStart;
+	unsigned long peakStart = 0;
 
 	for (int i=1; i<=mNumberOfChannels; i++) {
 
 		output << indent << "<channel>" << endLine;
 		output << indent2 << "<nr>" << i << "</nr>" << endLine;
 		output << indent2 << "<minRFU>" << mDataChannels [i]->GetMinimumHeight () << "</minRFU>" << endLine;
-		output << indent2 << "<rawPoints>";
-		mDataChannels [i]->WriteRawData (output, " ");
-		output << "</rawPoints>" << endLine;
-		output << indent2 << "<analyzedPoints>";
-		mDataChannels [i]->WriteFitData (output, " ");
-		output << "</analyzedPoints>" << endLine;
+		values = mDataChannels [i]->CreateRawDataArray (numberOfValues);
+		WritePlotArray (outputFile, output, indent2, i, PlotSidecar::RawPoints, values, numberOfValues, sidecar);
+		delete[] values;
+		values = mDataChannels [i]->CreateFitDataArray (numberOfValues);
+		WritePlotArray (outputFile, output, indent2, i, PlotSidecar::AnalyzedPoints, values, numberOfValues, sidecar);
+		delete[] values;
 		
 		if ((mAssociatedGrid != NULL) && (i != mLaneStandardChannel)) {
 
-			output << indent2 << "<ladderPoints>";
-			mAssociatedGrid->WriteFitDataForChannel (i, output, " ", mDataChannels [i]);
-			output << "</ladderPoints>" << endLine;
+			values = mAssociatedGrid->CreateFitDataArrayForChannel (i, mDataChannels [i]);
+			numberOfValues = (values != NULL) ? mDataChannels [i]->GetNumberOfSamples () : 0;
+			WritePlotArray (outputFile, output, indent2, i, PlotSidecar::LadderPoints, values, numberOfValues, sidecar);
+			delete[] values;
 		}
 
 		//
 		//	Write Baseline data, if available
 		//
 
-		mDataChannels [i]->WriteBaselineData (output, " ", indent2);
+		values = mDataChannels [i]->CreateBaselineDataArray (baselineStart, numberOfValues);
+
+		if (values != NULL) {
+
+			output << indent2 << "<baselineStart>" << baselineStart << "</baselineStart>" << endLine;
+			WritePlotArray (outputFile, output, indent2, i, PlotSidecar::BaselinePoints, values, numberOfValues, sidecar);
+			delete[] values;
+		}
+
+		if (sidecar != NULL)
+			peakStart = outputFile.CurrentOffset ();
 
 		WriteSmartPeakInfoToXMLForChannel (i, output, indent2, "samplePeak");
 		WriteSmartArtifactInfoToXMLForChannel (i, output, indent2);
@@ -3857,6 +3878,9 @@ int STRCoreBioComponent :: WriteXMLGraphicDataSM (const RGString& graphicDirecto
 		if ((mAssociatedGrid != NULL) && (i != mLaneStandardChannel))
 			mAssociatedGrid->WriteSmartPeakInfoToXMLForChannel (i, output, indent2, "ladderPeak");
 
+		if (sidecar != NULL)
+			sidecar->AddPeakSection (i, peakStart, outputFile.CurrentOffset ());
+
 		output << indent << "</channel>" << endLine;
 	}
 
@@ -3865,6 +3889,8 @@ int STRCoreBioComponent :: WriteXMLGraphicDataSM (const RGString& graphicDirecto
 
 	output << "</plt>" << endLine;
 	outputFile.Flush ();
+	WritePlotSidecarFile (fullPath, outputFile, sidecar);
+	delete sidecar;
 
 	return 0;
 }
@@ -4028,6 +4054,8 @@ bool STRCoreBioComponent :: TestForWeakPullup (double testMean, DataSignal* test
 
 int STRLadderCoreBioComponent :: AnalyzeGridLociSM (RGTextOutput& text, RGTextOutput& ExcelText, OsirisMsg& msg, Boolean print) {
 
+	ProfileTimer timer (AnalysisProfiler::LadderMatching);
+
 	//
 	//  This is ladder stage 2
 	//
@@ -4205,6 +4233,8 @@ void STRLadderCoreBioComponent :: MakeNonCoreLadderArtifactsNoncritical () {
 
 int STRLadderCoreBioComponent :: AnalyzeCrossChannelSM () {
 
+	ProfileTimer timer (AnalysisProfiler::PullupAnalysis);
+
 	//
 	//  This is ladder stage 1
 	//
@@ -4628,6 +4658,8 @@ int STRLadderCoreBioComponent :: AnalyzeCrossChannelSM () {
 
 int STRLadderCoreBioComponent :: GridQualityTestSM () {
 
+	ProfileTimer timer (AnalysisProfiler::CallsAndQuality);
+
 	//
 	//  This is ladder stage 3
 	//
@@ -4762,6 +4794,8 @@ int STRLadderCoreBioComponent :: RemoveInterlocusSignalsSM () {
 
 int STRLadderCoreBioComponent :: WriteXMLGraphicDataSM (const RGString& graphicDirectory, const RGString& localFileName, SampleData* data, int analysisStage, const RGString& intro) {
 
+	ProfileTimer timer (AnalysisProfiler::OutputWriting);
+
 	RGString fileName = localFileName;
 	int begin;
 	RGString pResult;
@@ -4803,20 +4837,32 @@ int STRLadderCoreBioComponent :: WriteXMLGraphicDataSM (const RGString& graphicD
 	output << indent << "<associatedLadder></associatedLadder>" << endLine;
 	RGString indent2 = indent + indent;
 	int i;
+	PlotSidecar* sidecar = CoreBioComponent::GetWritePlotSidecar () ? new PlotSidecar : NULL;
+	int* values;
+	int numberOfValues;
+	unsigned long peakStart = 0;
 
 	for (i=1; i<=mNumberOfChannels; i++) {
 
 		output << indent << "<channel>" << endLine;
 		output << indent2 << "<nr>" << i << "</nr>" << endLine;
 		output << indent2 << "<minRFU>" << mDataChannels [i]->GetMinimumHeight () << "</minRFU>" << endLine;
-		output << indent2 << "<rawPoints>";
-		mDataChannels [i]->WriteRawData (output, " ");
-		output << "</rawPoints>" << endLine;
-		output << indent2 << "<analyzedPoints>";
-		mDataChannels [i]->WriteFitData (output, " ");
-		output << "</analyzedPoints>" << endLine;
+		values = mDataChannels [i]->CreateRawDataArray (numberOfValues);
+		WritePlotArray (outputFile, output, indent2, i, PlotSidecar::RawPoints, values, numberOfValues, sidecar);
+		delete[] values;
+		values = mDataChannels [i]->CreateFitDataArray (numberOfValues);
+		WritePlotArray (outputFile, output, indent2, i, PlotSidecar::AnalyzedPoints, values, numberOfValues, sidecar);
+		delete[] values;
+
+		if (sidecar != NULL)
+			peakStart = outputFile.CurrentOffset ();
+
 		WriteSmartPeakInfoToXMLForChannel (i, output, indent2, "samplePeak");
 		WriteSmartArtifactInfoToXMLForChannel (i, output, indent2);
+
+		if (sidecar != NULL)
+			sidecar->AddPeakSection (i, peakStart, outputFile.CurrentOffset ());
+
 		output << indent << "</channel>" << endLine;
 	}
 
@@ -4828,6 +4874,8 @@ int STRLadderCoreBioComponent :: WriteXMLGraphicDataSM (const RGString& graphicD
 
 	output << "</plt>" << endLine;
 	outputFile.Flush ();
+	WritePlotSidecarFile (fullPath, outputFile, sidecar);
+	delete sidecar;
 
 	return 0;
 }
@@ -4839,6 +4887,8 @@ int STRLadderCoreBioComponent :: WriteXMLGraphicDataSM (const RGString& graphicD
 
 int STRSampleCoreBioComponent :: AnalyzeSampleLociSM (RGTextOutput& text, RGTextOutput& ExcelText, OsirisMsg& msg, Boolean print) {
 
+	ProfileTimer timer (AnalysisProfiler::LocusAnalysis);
+
 	//  OK, so here is what we have to do.  First, we have to test neighbors (stutter/adenylation and
 	//  (optional) ratio test.  Then, we test for heterozygous imbalance and homozygosity (using the average, above).  Then, we have 
 	//  to gather some data that we'll need, particularly, the average height over all peaks accepted so far, across all 
@@ -4853,8 +4903,11 @@ int STRSampleCoreBioComponent :: AnalyzeSampleLociSM (RGTextOutput& text, RGText
 
 	for (int i=1; i<=mNumberOfChannels; i++) {
 
-		if (i != mLaneStandardChannel)
+		if (i != mLaneStandardChannel) {
+
+			TraceSpan span ("AnalyzeChannelLoci", "channel", "channel", i);
 			mDataChannels [i]->AnalyzeSampleLociSM (mLSData, text, ExcelText, msg, print);
+		}
 	}
 
 	return status;
@@ -4875,6 +4928,8 @@ int STRSampleCoreBioComponent :: ResolveAmbiguousInterlocusSignalsSM () {
 
 int STRSampleCoreBioComponent :: SampleQualityTestSM (GenotypesForAMarkerSet* genotypes) {
 
+	ProfileTimer timer (AnalysisProfiler::CallsAndQuality);
+
 	//
 	//  This is sample stage 5
 	//
@@ -5037,6 +5092,8 @@ int STRSampleCoreBioComponent :: SampleQualityTestSMLF () {
 
 int STRSampleCoreBioComponent :: SignalQualityTestSM () {
 
+	ProfileTimer timer (AnalysisProfiler::CallsAndQuality);
+
 	//
 	//  This is sample stage 4
 	//
@@ -5123,6 +5180,8 @@ int STRSampleCoreBioComponent :: SignalQualityTestSM () {
 
 int STRSampleCoreBioComponent :: FitAllSampleCharacteristicsSM (RGTextOutput& text, RGTextOutput& ExcelText, OsirisMsg& msg, Boolean print) {
 
+	ProfileTimer timer (AnalysisProfiler::PeakFitting);
+
 	//
 	//  This is sample stage 1
 	//
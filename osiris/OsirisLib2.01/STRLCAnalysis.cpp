@@ -1678,9 +1678,8 @@ finishOutput:
 		return -5;
 	}
 
-	RGString in3;
-	in3.ReadTextFile (tempInputXMLSummaryLinks);
-	XMLExcelLinks << CLevel (1) << in3;
+	XMLExcelLinks << CLevel (1);
+	XMLExcelLinks.WriteFile (tempInputXMLSummaryLinks);
 	XMLExcelLinks << "\t</Messages>\n" << PLevel ();
 
 	// First add directory alerts and then...Merge here to get messages...
@@ -1717,11 +1716,13 @@ finishOutput:
 		return -5;
 	}
 	
-	RGString in1;
-	RGString in2;
+	ExcelSummary.SetOutputLevel (1);
+	ExcelLinks.SetOutputLevel (1);
 
-	in1.ReadTextFile (tempInputSummary);
-	in2.ReadTextFile (tempInputSummaryLinks);
+	ExcelSummary.WriteFile (tempInputSummary);
+	ExcelLinks.WriteFile (tempInputSummaryLinks);
+	ExcelSummary << "\n";
+	ExcelLinks << "\n";
 
 	tempInputSummary.Close ();
 	tempInputSummaryLinks.Close ();
@@ -1731,12 +1732,6 @@ finishOutput:
 	remove (tempSummaryFullPath.GetData ());
 	remove (tempSummaryFullPathWithLinks.GetData ());
 	remove (tempXMLSummaryFullPathWithLinks.GetData ());
-
-	ExcelSummary.SetOutputLevel (1);
-	ExcelLinks.SetOutputLevel (1);
-
-	ExcelSummary << in1 << "\n";
-	ExcelLinks << in2 << "\n";
 	
 	OutputFile.Flush ();
 	OutputFile.Close ();
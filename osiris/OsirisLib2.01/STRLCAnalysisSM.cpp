@@ -64,6 +64,7 @@
 #include "LeastMedianOfSquares.h"
 #include "STRLCAnalysis.h"
 #include "ModPairs.h"
+#include "AnalysisProfiler.h"
 #include <list>
 #include <iostream>
 #include <time.h>
@@ -772,6 +773,8 @@ int STRLCAnalysis :: AnalyzeIncrementallySM (const RGString& prototypeInputDirec
 
 	cout << "Opened output file:  " << OutputFullPath << " and text echo file:  " << WholeConsoleName << endl;
 
+	AnalysisProfiler::StartRun (FullPathForReports, OutputFileName);
+
 	RGLogBook ExcelText (&OutputFile, outputLevel, FALSE);
 	RGLogBook ExcelSummary (&OutputSummary, outputLevel, FALSE);
 	RGLogBook ExcelLinks (&OutputSummaryLinks, outputLevel, FALSE);
@@ -790,6 +793,7 @@ int STRLCAnalysis :: AnalyzeIncrementallySM (const RGString& prototypeInputDirec
 		STRLCAnalysis::mFailureMessage->CouldNotFindNamedMarkerSet (markerSetName);
 		STRLCAnalysis::mFailureMessage->SetPingValue (390);
 		STRLCAnalysis::mFailureMessage->WriteAndResetCurrentPingValue ();
+		AnalysisProfiler::EndRun ();
 		return -10000;
 	}
 
@@ -1122,6 +1126,7 @@ int STRLCAnalysis :: AnalyzeIncrementallySM (const RGString& prototypeInputDirec
 	while (SampleDirectory->GetNextLadderFile (LadderFileName, cycled) && !cycled) {
 
 		FullPathName = DirectoryName + "/" + LadderFileName;
+		AnalysisProfiler::StartSample (LadderFileName, "Ladder");
 		cout << "Found ladder name " << (char*)FullPathName.GetData () << endl;
 		nLadders++;
 
@@ -1421,6 +1426,8 @@ int STRLCAnalysis :: AnalyzeIncrementallySM (const RGString& prototypeInputDirec
 		}
 	}
 
+	AnalysisProfiler::EndSample ();
+
 	cout << "Processed all ladders.  Number of ladders = " << LadderList.Entries () << endl;
 	ChannelData::SetTestForDualSignal (true);
 	ChannelData::SetUseILSLadderEndPointAlgorithm (false);
@@ -1441,6 +1448,7 @@ int STRLCAnalysis :: AnalyzeIncrementallySM (const RGString& prototypeInputDirec
 		ExcelText << CLevel (1) << NoticeStr << "\n" << PLevel ();
 		text << NoticeStr << "\n";
 		foundALadder = false;
+		AnalysisProfiler::EndRun ();
 		return -42;
 	}
 
@@ -1518,6 +1526,7 @@ int STRLCAnalysis :: AnalyzeIncrementallySM (const RGString& prototypeInputDirec
 	while (SampleDirectory->GetNextOrderedSampleFile (FileName)) {
 
 		CoreBioComponent::ResetCrashMode (false);
+		AnalysisProfiler::StartSample (FileName, "Sample");
 		CoreBioComponent::SetCurrentStage (1);
 		CoreBioComponent::AddOneToCrashCount ();
 		CoreBioComponent::ResetNoDataChannels ();
@@ -1975,6 +1984,8 @@ int STRLCAnalysis :: AnalyzeIncrementallySM (const RGString& prototypeInputDirec
 		//cout << "Clean up time and on to the next" << endl;
 	}
 
+	AnalysisProfiler::EndSample ();
+
 	if (!hasPosControl) {
 
 		SetMessageValue (noPosCtrlFound, true);
@@ -2020,12 +2031,12 @@ finishOutput:
 	if (!tempInputXMLSummaryLinks.isValid ()) {
 
 		cout << "Could not complete output xml summary; temporary file unavailable..." << endl;
+		AnalysisProfiler::EndRun ();
 		return -5;
 	}
 
-	RGString in3;
-	in3.ReadTextFile (tempInputXMLSummaryLinks);
-	XMLExcelLinks << CLevel (1) << in3;
+	XMLExcelLinks << CLevel (1);
+	XMLExcelLinks.WriteFile (tempInputXMLSummaryLinks);
 	XMLExcelLinks << "\t</Messages>\n" << PLevel ();
 	SmartMessagingObject::ReportAllExportSpecifications (XMLExcelLinks);
 
@@ -2055,20 +2066,24 @@ finishOutput:
 	if (!tempInputSummary.isValid ()) {
 
 		cout << "Could not complete output summary; temporary file unavailable..." << endl;
+		AnalysisProfiler::EndRun ();
 		return -5;
 	}
 
 	if (!tempInputSummaryLinks.isValid ()) {
 
 		cout << "Could not complete output summary; temporary file unavailable..." << endl;
+		AnalysisProfiler::EndRun ();
 		return -5;
 	}
 	
-	RGString in1;
-	RGString in2;
+	ExcelSummary.SetOutputLevel (1);
+	ExcelLinks.SetOutputLevel (1);
 
-	in1.ReadTextFile (tempInputSummary);
-	in2.ReadTextFile (tempInputSummaryLinks);
+	ExcelSummary.WriteFile (tempInputSummary);
+	ExcelLinks.WriteFile (tempInputSummaryLinks);
+	ExcelSummary << "\n";
+	ExcelLinks << "\n";
 
 	tempInputSummary.Close ();
 	tempInputSummaryLinks.Close ();
@@ -2078,16 +2093,12 @@ finishOutput:
 	remove (tempSummaryFullPath.GetData ());
 	remove (tempSummaryFullPathWithLinks.GetData ());
 	remove (tempXMLSummaryFullPathWithLinks.GetData ());
-
-	ExcelSummary.SetOutputLevel (1);
-	ExcelLinks.SetOutputLevel (1);
-
-	ExcelSummary << in1 << "\n";
-	ExcelLinks << in2 << "\n";
 	
 	OutputFile.Flush ();
 	OutputFile.Close ();
 
+	AnalysisProfiler::EndRun ();
+
 	if (!foundALadder)
 		return -20;
 
@@ -2404,6 +2415,8 @@ int STRLCAnalysis :: AnalyzeIncrementallySMLF (const RGString& prototypeInputDir
 
 	cout << "Opened output file:  " << OutputFullPath << " and text echo file:  " << WholeConsoleName << endl;
 
+	AnalysisProfiler::StartRun (FullPathForReports, OutputFileName);
+
 	RGLogBook ExcelText (&OutputFile, outputLevel, FALSE);
 	RGLogBook ExcelSummary (&OutputSummary, outputLevel, FALSE);
 	RGLogBook ExcelLinks (&OutputSummaryLinks, outputLevel, FALSE);
@@ -2422,6 +2435,7 @@ int STRLCAnalysis :: AnalyzeIncrementallySMLF (const RGString& prototypeInputDir
 		STRLCAnalysis::mFailureMessage->CouldNotFindNamedMarkerSet (markerSetName);
 		STRLCAnalysis::mFailureMessage->SetPingValue (530);
 		STRLCAnalysis::mFailureMessage->WriteAndResetCurrentPingValue ();
+		AnalysisProfiler::EndRun ();
 		return -10000;
 	}
 
@@ -2858,6 +2872,7 @@ int STRLCAnalysis :: AnalyzeIncrementallySMLF (const RGString& prototypeInputDir
 	while (SampleDirectory->GetNextOrderedSampleFile (FileName)) {
 
 		CoreBioComponent::ResetCrashMode (false);
+		AnalysisProfiler::StartSample (FileName, "Sample");
 		CoreBioComponent::SetCurrentStage (1);
 		CoreBioComponent::AddOneToCrashCount ();
 		CoreBioComponent::ResetNoDataChannels ();
@@ -3325,6 +3340,8 @@ int STRLCAnalysis :: AnalyzeIncrementallySMLF (const RGString& prototypeInputDir
 		//cout << "Clean up time and on to the next" << endl;
 	}
 
+	AnalysisProfiler::EndSample ();
+
 	if (!hasPosControl) {
 
 		SetMessageValue (noPosCtrlFound, true);
@@ -3367,12 +3384,12 @@ int STRLCAnalysis :: AnalyzeIncrementallySMLF (const RGString& prototypeInputDir
 	if (!tempInputXMLSummaryLinks.isValid ()) {
 
 		cout << "Could not complete output xml summary; temporary file unavailable..." << endl;
+		AnalysisProfiler::EndRun ();
 		return -5;
 	}
 
-	RGString in3;
-	in3.ReadTextFile (tempInputXMLSummaryLinks);
-	XMLExcelLinks << CLevel (1) << in3;
+	XMLExcelLinks << CLevel (1);
+	XMLExcelLinks.WriteFile (tempInputXMLSummaryLinks);
 	XMLExcelLinks << "\t</Messages>\n" << PLevel ();
 	SmartMessagingObject::ReportAllExportSpecifications (XMLExcelLinks);
 
@@ -3402,20 +3419,24 @@ int STRLCAnalysis :: AnalyzeIncrementallySMLF (const RGString& prototypeInputDir
 	if (!tempInputSummary.isValid ()) {
 
 		cout << "Could not complete output summary; temporary file unavailable..." << endl;
+		AnalysisProfiler::EndRun ();
 		return -5;
 	}
 
 	if (!tempInputSummaryLinks.isValid ()) {
 
 		cout << "Could not complete output summary; temporary file unavailable..." << endl;
+		AnalysisProfiler::EndRun ();
 		return -5;
 	}
 	
-	RGString in1;
-	RGString in2;
+	ExcelSummary.SetOutputLevel (1);
+	ExcelLinks.SetOutputLevel (1);
 
-	in1.ReadTextFile (tempInputSummary);
-	in2.ReadTextFile (tempInputSummaryLinks);
+	ExcelSummary.WriteFile (tempInputSummary);
+	ExcelLinks.WriteFile (tempInputSummaryLinks);
+	ExcelSummary << "\n";
+	ExcelLinks << "\n";
 
 	tempInputSummary.Close ();
 	tempInputSummaryLinks.Close ();
@@ -3425,16 +3446,12 @@ int STRLCAnalysis :: AnalyzeIncrementallySMLF (const RGString& prototypeInputDir
 	remove (tempSummaryFullPath.GetData ());
 	remove (tempSummaryFullPathWithLinks.GetData ());
 	remove (tempXMLSummaryFullPathWithLinks.GetData ());
-
-	ExcelSummary.SetOutputLevel (1);
-	ExcelLinks.SetOutputLevel (1);
-
-	ExcelSummary << in1 << "\n";
-	ExcelLinks << in2 << "\n";
 	
 	OutputFile.Flush ();
 	OutputFile.Close ();
 
+	AnalysisProfiler::EndRun ();
+
 	if (!foundALadder)
 		return -20;
 
@@ -35,6 +35,7 @@
 
 #include "STRSmartMessage.h"
 #include "rgtokenizer.h"
+#include "rgxmlreader.h"
 #include "Expression.h"
 #include "SmartMessagingObject.h"
 #include "STRLCAnalysis.h"
@@ -444,20 +445,15 @@ int STRBaseSmartMessage :: GetIntegerValue (SmartMessagingComm& comm, int numHig
 SmartMessage* STRBaseSmartMessage :: GetNewMessageV4 (const RGString& inputString) const {
 
 	size_t startIndex = 0;
-	size_t endIndex;
-	RGString localInputString (inputString);
+	RGXMLReader reader (inputString);
 	RGString messageTypeString;
-	RGXMLTagSearch messageTypeSearch ("MessageType", localInputString);
-	RGXMLTagSearch nameSearch ("Name", localInputString);
 	SmartMessage* newMsg;
 	RGString name;
 
-	if (nameSearch.FindNextTag (startIndex, endIndex, name)) {
-
-		startIndex = endIndex;
-	}
+	if (reader.FindNextElement ("Name", name))
+		startIndex = reader.GetOffset ();
 
-	if (!messageTypeSearch.FindNextTag (startIndex, endIndex, messageTypeString))
+	if (!reader.FindNextElement ("MessageType", messageTypeString))
 		newMsg = new STRSmartMessage ();
 
 	else if (messageTypeString == "boolean")
@@ -495,20 +491,17 @@ int STRBaseSmartMessage :: ConfigureDescriptionToSampleTypeV4 (const RGString& i
 
 	mValid = 0;
 
-	RGString localInputString (inputString);
-	RGXMLTagSearch descriptionSearch ("Description", localInputString);
-	RGXMLTagSearch sampleTypeSearch ("SampleType", localInputString);
-
-	RGString numericString;
-	size_t overallStartIndex = startIndex;
+	RGXMLReader reader (inputString);
+	RGXMLView numericString;
+	reader.SetOffset (startIndex);
 
-	if (descriptionSearch.FindNextTag (overallStartIndex, endIndex, mDescription))
-		overallStartIndex = endIndex;
+	if (reader.FindNextElement ("Description", mDescription))
+		endIndex = reader.GetOffset ();
 
-	if (!sampleTypeSearch.FindNextTag (overallStartIndex, endIndex, numericString))
+	if (!reader.FindNextElement ("SampleType", numericString))
 		return -1;
 
-	overallStartIndex = endIndex;
+	endIndex = reader.GetOffset ();
 	mSampleType = numericString.ConvertToInteger ();
 
 	return 0;
@@ -517,173 +510,116 @@ int STRBaseSmartMessage :: ConfigureDescriptionToSampleTypeV4 (const RGString& i
 
 int STRBaseSmartMessage :: ConfigureReportCriterionToEndV4 (const RGString& inputString, size_t startIndex) {
 
-	RGString localInputString (inputString);
-	RGXMLTagSearch reportCriterionSearch ("ReportCriterion", localInputString);
-	RGXMLTagSearch textSearch ("Text", localInputString);
-	RGXMLTagSearch textForDataSearch ("TextForData", localInputString);
-	RGXMLTagSearch separatorTextSearch ("SeparatorText", localInputString);
-	RGXMLTagSearch closingTextSearch ("ClosingText", localInputString);
-	RGXMLTagSearch reportLevelSearch ("ReportLevel", localInputString);
-	RGXMLTagSearch alternateReportSearch ("AlternateReport", localInputString);
-	RGXMLTagSearch scopeSearch ("Scope", localInputString);
-	RGXMLTagSearch callCriterionSearch ("CallCriterion", localInputString);
-	RGXMLTagSearch restrictionSearch ("Restriction", localInputString);
-	RGXMLTagSearch acceptDataSearch ("AcceptTriggerDataMode", localInputString);
-	RGXMLTagSearch shareWithClusterSearch ("ShareWithCluster", localInputString);
-	RGXMLTagSearch allowPeakEdit ("AllowPeakEdit", localInputString);
-	RGXMLTagSearch debugSearch ("Debug", localInputString);
-	RGXMLTagSearch editableSearch ("Editable", localInputString);
-	RGXMLTagSearch protocolSearch ("ExportProtocolList", localInputString);
-	RGXMLTagSearch displayExportSearch ("DisplayExportInfo", localInputString);
+	// One pass over the message from startIndex; nested elements are read through views into inputString
 
-	RGString numericString;
-	RGString expressionString;
-	RGString alternateReportString;
-	RGString restrictionString;
-	RGString watchString;
+	RGXMLReader reader (inputString);
+	RGXMLView numericString;
+	RGXMLView expressionString;
+	RGXMLView alternateReportString;
+	RGXMLView restrictionString;
+	RGXMLView watchString;
 	RGString debugString;
-	RGString tempString;
-
-	RGXMLTagSearch alternateReportLevelSearch ("AlternateReportLevel", alternateReportString);
-	RGXMLTagSearch alternateReportCriterionSearch ("AlternateReportCriterion", alternateReportString);
-	RGXMLTagSearch expressionSearch ("Expression", expressionString);
-	RGXMLTagSearch restrictionLevelSearch ("RestrictionLevel", restrictionString);
-	RGXMLTagSearch restrictionCriterionSearch ("RestrictionCriterion", restrictionString);
-	RGXMLTagSearch debugWatchSearch ("Watch", watchString);
-
-	size_t overallStartIndex = startIndex;
-	size_t overallEndIndex;
-
-	size_t localStartIndex = 0;
-	size_t localEndIndex;
+	RGXMLView tempString;
 	DebugInfo* debugInfo;
 
-	if (!reportCriterionSearch.FindNextTag (overallStartIndex, overallEndIndex, expressionString))
+	reader.SetOffset (startIndex);
+
+	if (!reader.FindNextElement ("ReportCriterion", expressionString))
 		return -1;
 
-	overallStartIndex = overallEndIndex;
-	expressionSearch.ResetSearch ();
-	localStartIndex = 0;
+	RGXMLReader reportCriterionReader (expressionString);
 
-	if (!expressionSearch.FindNextTag (localStartIndex, localEndIndex, mReportCriterion))
+	if (!reportCriterionReader.FindNextElement ("Expression", mReportCriterion))
 		return -1;
 
-	if (!textSearch.FindNextTag (overallStartIndex, overallEndIndex, mMessageText))
+	if (!reader.FindNextElement ("Text", mMessageText))
 		return -1;
 
-	overallStartIndex = overallEndIndex;
-
-	if (textForDataSearch.FindNextTag (overallStartIndex, overallEndIndex, mAdditionalTextForData))
-		overallStartIndex = overallEndIndex;
-
-	if (separatorTextSearch.FindNextTag (overallStartIndex, overallEndIndex, mSeparatorText))
-		overallStartIndex = overallEndIndex;
-
-	if (closingTextSearch.FindNextTag (overallStartIndex, overallEndIndex, mClosingText))
-		overallStartIndex = overallEndIndex;
+	reader.FindNextElement ("TextForData", mAdditionalTextForData);
+	reader.FindNextElement ("SeparatorText", mSeparatorText);
+	reader.FindNextElement ("ClosingText", mClosingText);
 
-	if (!reportLevelSearch.FindNextTag (overallStartIndex, overallEndIndex, numericString))
+	if (!reader.FindNextElement ("ReportLevel", numericString))
 		return -1;
 
-	overallStartIndex = overallEndIndex;
 	mReportLevel = numericString.ConvertToInteger ();
 
-	if (alternateReportSearch.FindNextTag (overallStartIndex, overallEndIndex, alternateReportString)) {
+	if (reader.FindNextElement ("AlternateReport", alternateReportString)) {
 
-		overallStartIndex = overallEndIndex;
-		alternateReportLevelSearch.ResetSearch ();
-		alternateReportCriterionSearch.ResetSearch ();
-		localStartIndex = 0;
+		RGXMLReader alternateReportReader (alternateReportString);
 
-		if (!alternateReportLevelSearch.FindNextTag (localStartIndex, localEndIndex, numericString))
+		if (!alternateReportReader.FindNextElement ("AlternateReportLevel", numericString))
 			return -1;
 
-		localStartIndex = localEndIndex;
 		mAlternateReportLevel = numericString.ConvertToInteger ();
 
-		if (!alternateReportCriterionSearch.FindNextTag (localStartIndex, localEndIndex, expressionString))
+		if (!alternateReportReader.FindNextElement ("AlternateReportCriterion", expressionString))
 			return -1;
 
-		expressionSearch.ResetSearch ();
+		RGXMLReader alternateCriterionReader (expressionString);
 
-		if (!expressionSearch.FindNextTag (0, localEndIndex, mAlternateReportCriterion))
+		if (!alternateCriterionReader.FindNextElement ("Expression", mAlternateReportCriterion))
 			return -1;
 	}
 
-	if (!scopeSearch.FindNextTag (overallStartIndex, overallEndIndex, numericString))
+	if (!reader.FindNextElement ("Scope", numericString))
 		return -1;
 
-	overallStartIndex = overallEndIndex;
 	mScope = numericString.ConvertToInteger ();
 
-	if (callCriterionSearch.FindNextTag (overallStartIndex, overallEndIndex, expressionString)) {
+	if (reader.FindNextElement ("CallCriterion", expressionString)) {
 
-		overallStartIndex = overallEndIndex;
-		expressionSearch.ResetSearch ();
-		localStartIndex = 0;
+		RGXMLReader callCriterionReader (expressionString);
 
-		if (!expressionSearch.FindNextTag (localStartIndex, localEndIndex, mCallCriterion))
+		if (!callCriterionReader.FindNextElement ("Expression", mCallCriterion))
 			return -1;
 	}
 
-	if (restrictionSearch.FindNextTag (overallStartIndex, overallEndIndex, restrictionString)) {
+	if (reader.FindNextElement ("Restriction", restrictionString)) {
 
-		overallStartIndex = overallEndIndex;
-		localStartIndex = 0;
-		restrictionLevelSearch.ResetSearch ();
-		restrictionCriterionSearch.ResetSearch ();
+		RGXMLReader restrictionReader (restrictionString);
 
-		if (!restrictionLevelSearch.FindNextTag (localStartIndex, localEndIndex, numericString))
+		if (!restrictionReader.FindNextElement ("RestrictionLevel", numericString))
 			return -1;
 
-		localEndIndex = localStartIndex;
 		mRestrictionLevel = numericString.ConvertToInteger ();
 
-		if (!restrictionCriterionSearch.FindNextTag (localStartIndex, localEndIndex, expressionString))
-			return -1;
+		// the criterion is searched for from the beginning of the restriction, not after the level
 
-		localStartIndex = 0;
-		expressionSearch.ResetSearch ();
+		restrictionReader.Reset ();
 
-		if (!expressionSearch.FindNextTag (localStartIndex, localEndIndex, mRestrictionCriterion))
+		if (!restrictionReader.FindNextElement ("RestrictionCriterion", expressionString))
 			return -1;
-	}
 
-	if (acceptDataSearch.FindNextTag (overallStartIndex, overallEndIndex, numericString)) {
+		RGXMLReader restrictionCriterionReader (expressionString);
 
-		overallStartIndex = overallEndIndex;
-		mAcceptData = numericString.ConvertToInteger ();
+		if (!restrictionCriterionReader.FindNextElement ("Expression", mRestrictionCriterion))
+			return -1;
 	}
 
-	if (shareWithClusterSearch.FindNextTag (overallStartIndex, overallEndIndex, numericString)) {
+	if (reader.FindNextElement ("AcceptTriggerDataMode", numericString))
+		mAcceptData = numericString.ConvertToInteger ();
 
-		overallStartIndex = overallEndIndex;
+	if (reader.FindNextElement ("ShareWithCluster", numericString))
 		mShareWithCluster = numericString.ConvertToInteger ();
-	}
 
 	else
 		mShareWithCluster = 0;
 
-	if (allowPeakEdit.FindNextTag (overallStartIndex, overallEndIndex, numericString)) {
-
-		overallStartIndex = overallEndIndex;
+	if (reader.FindNextElement ("AllowPeakEdit", numericString))
 		mAllowPeakEdit = numericString.ConvertToInteger ();
-	}
 
 	else
 		mAllowPeakEdit = 1;
 
 	if (SmartMessage::GetDebugMode ()) {
 
-		if (debugSearch.FindNextTag (overallStartIndex, overallEndIndex, watchString)) {
+		if (reader.FindNextElement ("Debug", watchString)) {
 
-			overallStartIndex = overallEndIndex;
-			localStartIndex = 0;
-			debugWatchSearch.ResetSearch ();
+			RGXMLReader watchReader (watchString);
 
-			while (debugWatchSearch.FindNextTag (localStartIndex, localEndIndex, debugString)) {
+			while (watchReader.FindNextElement ("Watch", debugString)) {
 
-				localStartIndex = localEndIndex;
 				debugInfo = new DebugInfo;
 				*(debugInfo->mName) = debugString;
 				debugInfo->mIndex = debugInfo->mScope = 0;
@@ -692,9 +628,7 @@ int STRBaseSmartMessage :: ConfigureReportCriterionToEndV4 (const RGString& inpu
 		}
 	}
 
-	if (editableSearch.FindNextTag (overallStartIndex, overallEndIndex, tempString)) {
-
-		overallStartIndex = overallEndIndex;
+	if (reader.FindNextElement ("Editable", tempString)) {
 
 		if (tempString == "false")
 			mEditable = false;
@@ -703,9 +637,8 @@ int STRBaseSmartMessage :: ConfigureReportCriterionToEndV4 (const RGString& inpu
 			mEditable = true;
 	}
 
-	if (displayExportSearch.FindNextTag (overallStartIndex, overallEndIndex, tempString)) {
+	if (reader.FindNextElement ("DisplayExportInfo", tempString)) {
 
-		overallStartIndex = overallEndIndex;
 		mExportReportMirrorsOarReport = false;
 
 		if (tempString == "false")
@@ -721,8 +654,7 @@ int STRBaseSmartMessage :: ConfigureReportCriterionToEndV4 (const RGString& inpu
 		mExportReportMirrorsOarReport = true;
 	}
 
-	if (protocolSearch.FindNextTag (overallStartIndex, overallEndIndex, mExportProtocolList))
-		overallStartIndex = overallEndIndex;
+	reader.FindNextElement ("ExportProtocolList", mExportProtocolList);
 
 	mValid = 1;
 	return 0;
@@ -1695,12 +1627,14 @@ size_t STRBaseSmartMessage :: StoreSize () const {
 	size += mReportCriterion.StoreSize ();
 	size += mAlternateReportCriterion.StoreSize () + mCallCriterion.StoreSize ();
 	size += mTriggerNames.StoreSize ();
+	size += 4 * sizeof (int) + mRestrictionCriterion.StoreSize () + mExportProtocolList.StoreSize ();
 	return size;
 }
 
 
 void STRBaseSmartMessage :: RestoreAll (RGFile& f) {
 
+	int value;
 	SmartMessage::RestoreAll (f);
 	mReportCriterion.RestoreAll (f);
 	f.Read (mReportLevel);
@@ -1709,11 +1643,21 @@ void STRBaseSmartMessage :: RestoreAll (RGFile& f) {
 	mCallCriterion.RestoreAll (f);
 	mTriggerNames.ClearAndDelete ();
 	mTriggerNames.RestoreAll (f);
+	f.Read (mRestrictionLevel);
+	mRestrictionCriterion.RestoreAll (f);
+	f.Read (value);
+	mEditable = (value != 0);
+	f.Read (value);
+	mDisplayExportInfo = (value != 0);
+	f.Read (value);
+	mExportReportMirrorsOarReport = (value != 0);
+	mExportProtocolList.RestoreAll (f);
 }
 
 
 void STRBaseSmartMessage :: RestoreAll (RGVInStream& f) {
 
+	int value;
 	SmartMessage::RestoreAll (f);
 	mReportCriterion.RestoreAll (f);
 	f >> mReportLevel;
@@ -1722,6 +1666,15 @@ void STRBaseSmartMessage :: RestoreAll (RGVInStream& f) {
 	mCallCriterion.RestoreAll (f);
 	mTriggerNames.ClearAndDelete ();
 	mTriggerNames.RestoreAll (f);
+	f >> mRestrictionLevel;
+	mRestrictionCriterion.RestoreAll (f);
+	f >> value;
+	mEditable = (value != 0);
+	f >> value;
+	mDisplayExportInfo = (value != 0);
+	f >> value;
+	mExportReportMirrorsOarReport = (value != 0);
+	mExportProtocolList.RestoreAll (f);
 }
 
 
@@ -1734,6 +1687,12 @@ void STRBaseSmartMessage :: SaveAll (RGFile& f) const {
 	mAlternateReportCriterion.SaveAll (f);
 	mCallCriterion.SaveAll (f);
 	mTriggerNames.SaveAll (f);
+	f.Write (mRestrictionLevel);
+	mRestrictionCriterion.SaveAll (f);
+	f.Write ((int) mEditable);
+	f.Write ((int) mDisplayExportInfo);
+	f.Write ((int) mExportReportMirrorsOarReport);
+	mExportProtocolList.SaveAll (f);
 }
 
 
@@ -1746,6 +1705,12 @@ void STRBaseSmartMessage :: SaveAll (RGVOutStream& f) const {
 	mAlternateReportCriterion.SaveAll (f);
 	mCallCriterion.SaveAll (f);
 	mTriggerNames.SaveAll (f);
+	f << mRestrictionLevel;
+	mRestrictionCriterion.SaveAll (f);
+	f << (int) mEditable;
+	f << (int) mDisplayExportInfo;
+	f << (int) mExportReportMirrorsOarReport;
+	mExportProtocolList.SaveAll (f);
 }
 
 
@@ -2432,41 +2397,30 @@ int STRSmartCountingMessage :: ConfigureV4 (const RGString& inputString, size_t
 
 	mValid = 0;
 
-	RGString localInputString (inputString);
-	RGXMLTagSearch countingDataInfoSearch ("CountingDataInfo", localInputString);
-
-	RGString subString;
-	RGString numericString;
+	RGXMLReader reader (inputString);
+	RGXMLView subString;
+	RGXMLView numericString;
 	RGString comparisonString;
-	RGXMLTagSearch thresholdSearch ("Threshold", subString);
-	RGXMLTagSearch comparisonSearch ("Comparison", subString);
-
 
 	size_t overallStartIndex = startIndex;
 	size_t overallEndIndex = startIndex;
 
-	size_t localStartIndex = 0;
-	size_t localEndIndex;
-
-	if (ConfigureDescriptionToSampleTypeV4 (localInputString, overallStartIndex, overallEndIndex) < 0)
+	if (ConfigureDescriptionToSampleTypeV4 (inputString, overallStartIndex, overallEndIndex) < 0)
 		return -1;
 
-	overallStartIndex = overallEndIndex;
+	reader.SetOffset (overallEndIndex);
 
-	if (countingDataInfoSearch.FindNextTag (overallStartIndex, overallEndIndex, subString)) {
+	if (reader.FindNextElement ("CountingDataInfo", subString)) {
 
-		overallStartIndex = overallEndIndex;
-		thresholdSearch.ResetSearch ();
-		comparisonSearch.ResetSearch ();
-		localStartIndex = 0;
+		overallStartIndex = reader.GetOffset ();
+		RGXMLReader subReader (subString);
 
-		if (!thresholdSearch.FindNextTag (localStartIndex, localEndIndex, numericString))
+		if (!subReader.FindNextElement ("Threshold", numericString))
 			return -1;
 
 		mThreshold = numericString.ConvertToInteger ();
-		localStartIndex = localEndIndex;
 
-		if (!comparisonSearch.FindNextTag (localStartIndex, localEndIndex, comparisonString))
+		if (!subReader.FindNextElement ("Comparison", comparisonString))
 			mTestForGreater = true;
 
 		else {
@@ -2484,7 +2438,7 @@ int STRSmartCountingMessage :: ConfigureV4 (const RGString& inputString, size_t
 	else
 		return -1;
 
-	if (ConfigureReportCriterionToEndV4 (localInputString, overallStartIndex) < 0)
+	if (ConfigureReportCriterionToEndV4 (inputString, overallStartIndex) < 0)
 		return -1;
 
 	mValid = 1;
@@ -2802,49 +2756,34 @@ int STRSmartPercentMessage :: ConfigureV4 (const RGString& inputString, size_t s
 
 	mValid = 0;
 
-	RGString localInputString (inputString);
-	RGXMLTagSearch percentDataInfoSearch ("PercentDataInfo", localInputString);
-
-	RGString subString;
-	RGString numericString;
+	RGXMLReader reader (inputString);
+	RGXMLView subString;
+	RGXMLView numericString;
 	RGString comparisonString;
-	RGXMLTagSearch thresholdSearch ("Threshold", subString);
-	RGXMLTagSearch comparisonSearch ("Comparison", subString);
-	RGXMLTagSearch numeratorSearch ("NumeratorName", subString);
-	RGXMLTagSearch denominatorSearch ("DenominatorName", subString);
 
 	size_t overallStartIndex = startIndex;
 	size_t overallEndIndex = startIndex;
 
-	size_t localStartIndex = 0;
-	size_t localEndIndex;
-
-	if (ConfigureDescriptionToSampleTypeV4 (localInputString, overallStartIndex, overallEndIndex) < 0)
+	if (ConfigureDescriptionToSampleTypeV4 (inputString, overallStartIndex, overallEndIndex) < 0)
 		return -1;
 
-	overallStartIndex = overallEndIndex;
+	reader.SetOffset (overallEndIndex);
 
-	if (percentDataInfoSearch.FindNextTag (overallStartIndex, overallEndIndex, subString)) {
+	if (reader.FindNextElement ("PercentDataInfo", subString)) {
 
-		overallStartIndex = overallEndIndex;
-		thresholdSearch.ResetSearch ();
-		comparisonSearch.ResetSearch ();
-		numeratorSearch.ResetSearch ();
-		denominatorSearch.ResetSearch ();
-		localStartIndex = 0;
+		overallStartIndex = reader.GetOffset ();
+		RGXMLReader subReader (subString);
 
-		if (!thresholdSearch.FindNextTag (localStartIndex, localEndIndex, numericString))
+		if (!subReader.FindNextElement ("Threshold", numericString))
 			return -1;
 
 		mThreshold = numericString.ConvertToInteger ();
-		localStartIndex = localEndIndex;
 
-		if (!comparisonSearch.FindNextTag (localStartIndex, localEndIndex, comparisonString))
+		if (!subReader.FindNextElement ("Comparison", comparisonString))
 			mTestForGreater = true;
 
 		else {
 
-			localStartIndex = localEndIndex;
 			comparisonString.ToLower ();
 
 			if (comparisonString == "less")
@@ -2854,17 +2793,17 @@ int STRSmartPercentMessage :: ConfigureV4 (const RGString& inputString, size_t s
 				mTestForGreater = true;
 		}
 
-		//if (numeratorSearch.FindNextTag (localStartIndex, localEndIndex, mNumeratorName))
-		//	localStartIndex = localEndIndex;
+		//if (subReader.FindNextElement ("NumeratorName", mNumeratorName))
+		//	;
 
-		//if (denominatorSearch.FindNextTag (localStartIndex, localEndIndex, mDenominatorName))
-		//	localStartIndex = localEndIndex;
+		//if (subReader.FindNextElement ("DenominatorName", mDenominatorName))
+		//	;
 	}
 
 	else
 		return -1;
 
-	if (ConfigureReportCriterionToEndV4 (localInputString, overallStartIndex) < 0)	// change to ConfigureReportCriterionToEndV4
+	if (ConfigureReportCriterionToEndV4 (inputString, overallStartIndex) < 0)	// change to ConfigureReportCriterionToEndV4
 		return -1;
 
 	mValid = 1;
@@ -3184,33 +3123,25 @@ int STRSmartPresetMessage :: ConfigureV4 (const RGString& inputString, size_t st
 
 	mValid = 0;
 
-	RGString localInputString (inputString);
-	RGXMLTagSearch presetDataInfoSearch ("PresetDataInfo", localInputString);
-
-	RGString subString;
-	RGString numericString;
-	RGString comparisonString;
-	RGXMLTagSearch thresholdSearch ("Threshold", subString);
+	RGXMLReader reader (inputString);
+	RGXMLView subString;
+	RGXMLView numericString;
 
 	size_t overallStartIndex = startIndex;
 	size_t overallEndIndex = startIndex;
-
-	size_t localStartIndex = 0;
-	size_t localEndIndex;
 	int val;
 
-	if (ConfigureDescriptionToSampleTypeV4 (localInputString, overallStartIndex, overallEndIndex) < 0)
+	if (ConfigureDescriptionToSampleTypeV4 (inputString, overallStartIndex, overallEndIndex) < 0)
 		return -1;
 
-	overallStartIndex = overallEndIndex;
+	reader.SetOffset (overallEndIndex);
 
-	if (presetDataInfoSearch.FindNextTag (overallStartIndex, overallEndIndex, subString)) {
+	if (reader.FindNextElement ("PresetDataInfo", subString)) {
 
-		overallStartIndex = overallEndIndex;
-		thresholdSearch.ResetSearch ();
-		localStartIndex = 0;
+		overallStartIndex = reader.GetOffset ();
+		RGXMLReader subReader (subString);
 
-		if (!thresholdSearch.FindNextTag (localStartIndex, localEndIndex, numericString))
+		if (!subReader.FindNextElement ("Threshold", numericString))
 			return -1;
 
 		if (numericString == "false")
@@ -3229,14 +3160,12 @@ int STRSmartPresetMessage :: ConfigureV4 (const RGString& inputString, size_t st
 			else
 				mInitialValue = true;
 		}
-
-		localStartIndex = localEndIndex;
 	}
 
 	else
 		return -1;
 
-	if (ConfigureReportCriterionToEndV4 (localInputString, overallStartIndex) < 0)	// change to ConfigureReportCriterionToEndV4
+	if (ConfigureReportCriterionToEndV4 (inputString, overallStartIndex) < 0)	// change to ConfigureReportCriterionToEndV4
 		return -1;
 
 	mValid = 1;
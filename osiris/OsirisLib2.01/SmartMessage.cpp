@@ -34,8 +34,12 @@
 
 #include "SmartMessage.h"
 #include "rgtokenizer.h"
+#include "rgxmlreader.h"
+#include "rgdirectory.h"
 #include "SmartNotice.h"
 #include "STRLCAnalysis.h"
+#include "OsirisVersion.h"
+#include <cstdio>
 
 
 
@@ -59,6 +63,7 @@ RGFile* SmartMessage :: DebugFile = NULL;
 RGTextOutput* SmartMessage :: DebugTextOutput = NULL;
 RGString SmartMessage :: MsgBookText;
 int SmartMessage :: SeverityTrigger = 15;
+RGString SmartMessage :: SnapshotDirectory;
 SmartMessageKill SmartMessage :: kill;
 
 
@@ -133,8 +138,8 @@ SmartMessage :: ~SmartMessage () {
 
 size_t SmartMessage :: StoreSize () const {
 
-	size_t size = 8 * sizeof (int) + mName.StoreSize () + mDescription.StoreSize ();
-	size += mMessageText.StoreSize () + mAdditionalTextForData.StoreSize () + mSeparatorText.StoreSize ();
+	size_t size = 11 * sizeof (int) + mName.StoreSize () + mDescription.StoreSize ();
+	size += mMessageText.StoreSize () + mAdditionalTextForData.StoreSize () + mSeparatorText.StoreSize () + mClosingText.StoreSize ();
 	return size;
 }
 
@@ -171,6 +176,7 @@ void SmartMessage :: RestoreAll (RGFile& f) {
 	mMessageText.RestoreAll (f);
 	mAdditionalTextForData.RestoreAll (f);
 	mSeparatorText.RestoreAll (f);
+	mClosingText.RestoreAll (f);
 	f.Read (mScope);
 	f.Read (mWhichElementWithinDataArray);
 	f.Read (mWhichElementWithinValueArray);
@@ -178,6 +184,7 @@ void SmartMessage :: RestoreAll (RGFile& f) {
 	f.Read (mCompiled);
 	f.Read (mAcceptData);
 	f.Read (mShareWithCluster);
+	f.Read (mAllowPeakEdit);
 }
 
 
@@ -191,6 +198,7 @@ void SmartMessage :: RestoreAll (RGVInStream& f) {
 	mMessageText.RestoreAll (f);
 	mAdditionalTextForData.RestoreAll (f);
 	mSeparatorText.RestoreAll (f);
+	mClosingText.RestoreAll (f);
 	f >> mScope;
 	f >> mWhichElementWithinDataArray;
 	f >> mWhichElementWithinValueArray;
@@ -198,6 +206,7 @@ void SmartMessage :: RestoreAll (RGVInStream& f) {
 	f >> mCompiled;
 	f >> mAcceptData;
 	f >> mShareWithCluster;
+	f >> mAllowPeakEdit;
 }
 
 
@@ -211,6 +220,7 @@ void SmartMessage :: SaveAll (RGFile& f) const {
 	mMessageText.SaveAll (f);
 	mAdditionalTextForData.SaveAll (f);
 	mSeparatorText.SaveAll (f);
+	mClosingText.SaveAll (f);
 	f.Write (mScope);
 	f.Write (mWhichElementWithinDataArray);
 	f.Write (mWhichElementWithinValueArray);
@@ -218,6 +228,7 @@ void SmartMessage :: SaveAll (RGFile& f) const {
 	f.Write (mCompiled);
 	f.Write (mAcceptData);
 	f.Write (mShareWithCluster);
+	f.Write (mAllowPeakEdit);
 }
 
 
@@ -231,6 +242,7 @@ void SmartMessage :: SaveAll (RGVOutStream& f) const {
 	mMessageText.SaveAll (f);
 	mAdditionalTextForData.SaveAll (f);
 	mSeparatorText.SaveAll (f);
+	mClosingText.SaveAll (f);
 	f << mScope;
 	f << mWhichElementWithinDataArray;
 	f << mWhichElementWithinValueArray;
@@ -238,6 +250,7 @@ void SmartMessage :: SaveAll (RGVOutStream& f) const {
 	f << mCompiled;
 	f << mAcceptData;
 	f << mShareWithCluster;
+	f << mAllowPeakEdit;
 }
 
 
@@ -1378,21 +1391,16 @@ int SmartMessage :: GetEndIndexForListAndStage (int list, int stage) {
 
 int SmartMessage :: LoadAllMessagesV4 (const RGString& inputString, SmartMessage* prototype) {
 
-	RGString declarationString;
+	// One pass over the message book:  the declarations block is read as a view into inputString, and each message
+	// is copied out once, for the message to configure itself from
+
+	RGXMLReader reader (inputString);
+	RGXMLView declarationString;
 	RGString msgString;
-	RGString overallString (inputString);
-	RGString debugString;
+	RGXMLView debugString;
 	RGString buildString;
 	int debugInt;
-	RGXMLTagSearch declarationsSearch ("MessageDeclarations", overallString);
-	RGXMLTagSearch msgSearch ("SmartMessage", declarationString);
-	RGXMLTagSearch debugSearch ("DebugMode", overallString);
-	RGXMLTagSearch buildTimeSearch ("BuildTime", overallString);
 	size_t startIndex = 0;
-	size_t endIndex;
-
-	size_t testStartIndex;
-	size_t testEndIndex;
 
 	SmartMessage* nextMsg;
 	int status = 0;
@@ -1404,16 +1412,12 @@ int SmartMessage :: LoadAllMessagesV4 (const RGString& inputString, SmartMessage
 		StageEndIndex [i] = NULL;
 	}
 
-	if (buildTimeSearch.FindNextTag (startIndex, endIndex, buildString)) {
-
-		startIndex = endIndex;
+	if (reader.FindNextElement ("BuildTime", buildString))
 		STRLCAnalysis::SetMsgBookBuildTime (buildString);
-	}
 
-	if (debugSearch.FindNextTag (startIndex, endIndex, debugString)) {
+	if (reader.FindNextElement ("DebugMode", debugString)) {
 
 		debugInt = debugString.ConvertToInteger ();
-		startIndex = endIndex;
 
 		if (debugInt == 0)
 			DebugMode = 0;
@@ -1425,7 +1429,7 @@ int SmartMessage :: LoadAllMessagesV4 (const RGString& inputString, SmartMessage
 	else
 		DebugMode = 0;
 
-	if (!declarationsSearch.FindNextTag (startIndex, endIndex, declarationString)) {
+	if (!reader.FindNextElement ("MessageDeclarations", declarationString)) {
 
 		cout << "There are no smart message declarations.  MessageBook is empty!" << endl;
 		STRLCAnalysis::mFailureMessage->MessageBookIsEmpty ();
@@ -1434,15 +1438,31 @@ int SmartMessage :: LoadAllMessagesV4 (const RGString& inputString, SmartMessage
 		return -1;
 	}
 
-	startIndex = endIndex;
-	msgSearch.ResetSearch ();
-	testStartIndex = 0;
+	startIndex = reader.GetOffset ();
 
-	while (msgSearch.FindNextTag (testStartIndex, testEndIndex, msgString)) {
+	// The declarations are the bulk of the book and change only when the book does, so with a snapshot directory set,
+	// the parsed messages are saved under a hash of the declarations text and restored from there on later runs.  Watch
+	// lists are kept only in debug mode, and are not in the snapshot
+
+	bool useSnapshot = (SnapshotDirectory.Length () > 0) && (DebugMode == 0);
+	UINT64 declarationHash = 0;
+
+	if (useSnapshot) {
+
+		declarationHash = HashDeclarations (declarationString.GetData (), declarationString.Length ());
+
+		if (RestoreDeclarationsSnapshot (declarationHash, declarationString.Length (), prototype))
+			return AssembleMessagesV4 (inputString, startIndex, prototype);
+	}
+
+	RGXMLReader msgReader (declarationString);
+	RGDList declaredMessages;
+
+	while (msgReader.FindNextElement ("SmartMessage", msgString)) {
 
-		testStartIndex = testEndIndex;
 		nextMsg = prototype->GetNewMessageV4 (msgString);
 		OverAllMessageTable->Append (nextMsg);
+		declaredMessages.Append (nextMsg);
 //		OverAllMessageList.Append (nextMsg);
 
 		if (!nextMsg->IsValid ()) {
@@ -1454,13 +1474,210 @@ int SmartMessage :: LoadAllMessagesV4 (const RGString& inputString, SmartMessage
 
 	if (status < 0) {
 
+		declaredMessages.Clear ();
 		STRLCAnalysis::mFailureMessage->CouldNotIdentifyMessageType ();
 		STRLCAnalysis::mFailureMessage->SetPingValue (240);
 		STRLCAnalysis::mFailureMessage->WriteAndResetCurrentPingValue ();
 		return status;
 	}
 
-	return AssembleMessagesV4 (overallString, startIndex, prototype);  // change to AssembleMessagesV4
+	if (useSnapshot)
+		SaveDeclarationsSnapshot (declarationHash, declarationString.Length (), prototype, declaredMessages);
+
+	declaredMessages.Clear ();
+
+	return AssembleMessagesV4 (inputString, startIndex, prototype);  // change to AssembleMessagesV4
+}
+
+
+//
+// Message declaration snapshots:  a header (magic number, format, sizeof (long), prototype class, hash and length of the
+// declarations text, Osiris version), the number of messages, each message as class ID followed by SaveAll, in
+// declaration order, and the magic number again.  Any mismatch, or a short file, and the declarations are parsed as usual
+//
+
+static const int SnapshotMagic = 0x4f534d42;   // "OSMB"
+static const int SnapshotFormat = 1;   // change whenever a message SaveAll or this layout changes
+
+
+UINT64 SmartMessage :: HashDeclarations (const char* declarations, size_t length) {
+
+	// 64 bit FNV-1a
+
+	UINT64 hash = 14695981039346656037ULL;
+	const unsigned char* p = (const unsigned char*) declarations;
+	const unsigned char* end = p + length;
+
+	for (; p<end; p++) {
+
+		hash ^= *p;
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+
+RGString SmartMessage :: DeclarationsSnapshotName (UINT64 hash) {
+
+	char hex [24];
+	sprintf (hex, "%08x%08x", (unsigned int)(hash >> 32), (unsigned int)(hash & 0xffffffff));
+	RGString name = SnapshotDirectory;
+
+	if ((name.Length () > 0) && (name.GetLastCharacter () != '/'))
+		name += "/";
+
+	name += "MessageBook_";
+	name += hex;
+	name += ".snp";
+	return name;
+}
+
+
+bool SmartMessage :: RestoreDeclarationsSnapshot (UINT64 hash, size_t length, const SmartMessage* prototype) {
+
+	RGString snapshotName = DeclarationsSnapshotName (hash);
+
+	if (!RGFile::Exists (snapshotName.GetData ()))
+		return false;
+
+	RGFile snapshot (snapshotName.GetData (), "rb");
+
+	if (!snapshot.isValid ())
+		return false;
+
+	int magic = 0;
+	int format = 0;
+	int longSize = 0;
+	int prototypeID = 0;
+	unsigned int hashHigh = 0;
+	unsigned int hashLow = 0;
+	unsigned long declarationLength = 0;
+	RGString version;
+	int nMessages = 0;
+	int i;
+	int classID;
+	RGPersistent* restored;
+	SmartMessage* nextMsg;
+	RGDList restoredMessages;
+
+	snapshot.Read (magic);
+	snapshot.Read (format);
+	snapshot.Read (longSize);
+	snapshot.Read (prototypeID);
+	snapshot.Read (hashHigh);
+	snapshot.Read (hashLow);
+	snapshot.Read (declarationLength);
+
+	if ((magic != SnapshotMagic) || (format != SnapshotFormat) || (longSize != (int)sizeof (long)) || (prototypeID != prototype->GetID ()))
+		return false;
+
+	if ((hashHigh != (unsigned int)(hash >> 32)) || (hashLow != (unsigned int)(hash & 0xffffffff)) || (declarationLength != (unsigned long)length))
+		return false;
+
+	version.RestoreAll (snapshot);
+
+	if (version != OSIRIS_VERSION)
+		return false;
+
+	snapshot.Read (nMessages);
+
+	if (snapshot.Error () || (nMessages <= 0))
+		return false;
+
+	for (i=0; i<nMessages; i++) {
+
+		if (!snapshot.Read (classID))
+			break;
+
+		restored = RGWarehouse::TestForID (classID);
+
+		if (restored == NULL)
+			break;
+
+		nextMsg = (SmartMessage*) restored;
+		restoredMessages.Append (nextMsg);
+		nextMsg->RestoreAll (snapshot);
+
+		if (snapshot.Error () || snapshot.Eof () || !nextMsg->IsValid ())
+			break;
+	}
+
+	magic = 0;
+	snapshot.Read (magic);
+
+	if ((i < nMessages) || (magic != SnapshotMagic) || snapshot.Error ()) {
+
+		cout << "Could not restore message book snapshot " << snapshotName.GetData () << ".  Reading message book declarations..." << endl;
+		restoredMessages.ClearAndDelete ();
+		return false;
+	}
+
+	while (nextMsg = (SmartMessage*) restoredMessages.GetFirst ())
+		OverAllMessageTable->Append (nextMsg);
+
+	cout << "Restored " << nMessages << " message declarations from snapshot " << snapshotName.GetData () << endl;
+	return true;
+}
+
+
+void SmartMessage :: SaveDeclarationsSnapshot (UINT64 hash, size_t length, const SmartMessage* prototype, RGDList& messages) {
+
+	// Written to a temporary file and renamed, so a concurrent run never sees a partial snapshot.  Failure to write
+	// is not an error:  the next run parses the declarations again
+
+	RGString snapshotName = DeclarationsSnapshotName (hash);
+	RGString tempName = snapshotName + ".tmp";
+	RGString version (OSIRIS_VERSION);
+	RGDListIterator it (messages);
+	SmartMessage* nextMsg;
+	bool written;
+
+	if (!RGDirectory::FileOrDirectoryExists (SnapshotDirectory))
+		RGDirectory::MakeDirectory (SnapshotDirectory);
+
+	{
+		RGFile snapshot (tempName.GetData (), "wb");
+
+		if (!snapshot.isValid ())
+			return;
+
+		snapshot.Write (SnapshotMagic);
+		snapshot.Write (SnapshotFormat);
+		snapshot.Write ((int)sizeof (long));
+		snapshot.Write (prototype->GetID ());
+		snapshot.Write ((unsigned int)(hash >> 32));
+		snapshot.Write ((unsigned int)(hash & 0xffffffff));
+		snapshot.Write ((unsigned long)length);
+		version.SaveAll (snapshot);
+		snapshot.Write (messages.Entries ());
+
+		while (nextMsg = (SmartMessage*) it ()) {
+
+			snapshot.Write (nextMsg->GetID ());
+			nextMsg->SaveAll (snapshot);
+		}
+
+		snapshot.Write (SnapshotMagic);
+		snapshot.Flush ();
+		written = !snapshot.Error ();
+	}
+
+	if (!written) {
+
+		remove (tempName.GetData ());
+		return;
+	}
+
+	remove (snapshotName.GetData ());
+
+	if (rename (tempName.GetData (), snapshotName.GetData ()) != 0) {
+
+		remove (tempName.GetData ());
+		return;
+	}
+
+	cout << "Wrote message book snapshot " << snapshotName.GetData () << endl;
 }
 
 
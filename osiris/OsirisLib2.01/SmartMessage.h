@@ -204,6 +204,10 @@ public:
 	static int GetSeverityTrigger () { return SeverityTrigger; }
 	static void SetSeverityTrigger (int severity) { SeverityTrigger = severity; }
 
+	// Directory for binary snapshots of parsed message declarations; empty (the default) means no snapshots
+	static void SetSnapshotDirectory (const RGString& dir) { SnapshotDirectory = dir; }
+	static RGString GetSnapshotDirectory () { return SnapshotDirectory; }
+
 	static int CompileAllMessages ();
 	static int InitializeAllMessages ();
 	static bool EvaluateAllMessages (bool* const msgMatrix, RGDList& subObjects, int stage, int scope);
@@ -263,10 +267,15 @@ protected:
 	static RGTextOutput* DebugTextOutput;
 	static RGString MsgBookText;
 	static int SeverityTrigger;
+	static RGString SnapshotDirectory;
 
 	static int AssembleMessages ();
 	static int AssembleMessagesV4 (const RGString& inputString, size_t startIndex, SmartMessage* prototype);
 	static int ImportMessageDynamicDataV4 (const RGString& inputString, size_t startIndex, SmartMessage* prototype);
+	static UINT64 HashDeclarations (const char* declarations, size_t length);
+	static RGString DeclarationsSnapshotName (UINT64 hash);
+	static bool RestoreDeclarationsSnapshot (UINT64 hash, size_t length, const SmartMessage* prototype);
+	static void SaveDeclarationsSnapshot (UINT64 hash, size_t length, const SmartMessage* prototype, RGDList& messages);
 	static SmartMessageKill kill;
 };
 
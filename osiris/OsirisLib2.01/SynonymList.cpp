@@ -67,6 +67,7 @@ SynonymList :: SynonymList (const RGString& tagName, const RGString& xmlString)
 			startPos = endPos;
 			newString = new RGString (textString);
 			mList.Append (newString);
+			mSearch.AddString (textString, 0);
 		}
 	}
 }
@@ -82,6 +83,7 @@ void SynonymList :: AddSynonym (const RGString& str) {
 
 	RGString* newString = new RGString (str);
 	mList.Append (newString);
+	mSearch.AddString (*newString, 0);
 }
 
 
@@ -89,6 +91,7 @@ void SynonymList :: AddSynonym (const char* str) {
 
 	RGString* newString = new RGString (str);
 	mList.Append (newString);
+	mSearch.AddString (*newString, 0);
 }
 
 
@@ -147,16 +150,8 @@ bool SynonymList :: DoesTargetStringEqualASynonymCaseIndep (const RGString& targ
 
 bool SynonymList :: DoesTargetStringContainASynonymCaseIndep (const RGString& target) {
 
-	mIt.Reset ();
-	RGString* nextString;
-	size_t pos = 0;
-
-	while (nextString = (RGString*) mIt ()) {
+	// One pass over target for all of the synonyms
 
-		if (target.FindSubstringCaseIndependent (*nextString, pos))
-			return true;
-	}
-
-	return false;
+	return mSearch.FindSmallestId (target) >= 0;
 }
 
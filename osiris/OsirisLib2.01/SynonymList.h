@@ -37,6 +37,7 @@
 
 #include "rgdlist.h"
 #include "rgstring.h"
+#include "rgmultisearch.h"
 
 class SynonymList {
 
@@ -50,7 +51,7 @@ public:
 
 	void AddSynonym (const RGString& str);
 	void AddSynonym (const char* str);
-	void FlushSynonymList () { mList.ClearAndDelete (); }
+	void FlushSynonymList () { mList.ClearAndDelete (); mSearch.Clear (); }
 
 	bool DoesTargetStringEqualASynonym (const RGString& target);
 	bool DoesTargetStringContainASynonym (const RGString& target);
@@ -62,6 +63,7 @@ protected:
 	RGDList mList;
 	RGDListIterator mIt;
 	bool mValid;
+	RGMultiStringSearch mSearch;  // the synonyms, for DoesTargetStringContainASynonymCaseIndep
 };
 
 
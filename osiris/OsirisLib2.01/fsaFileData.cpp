@@ -34,6 +34,7 @@
 
 #include "fsaFileData.h"
 #include "fsaDataDefs.h"
+#include "AnalysisProfiler.h"
 
 /*
 const char* ABIModelNumberTag = "MODL";
@@ -67,6 +68,7 @@ const int AmbientChannelIDLimit = 4;
 
 fsaFileData :: fsaFileData (const RGString& fsaFileName) : SampleData (fsaFileName) {
 
+	ProfileTimer timer (AnalysisProfiler::ReadInput);
 	fsaInput = new fsaFileInput (fsaFileName);
 }
 
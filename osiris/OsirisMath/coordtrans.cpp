@@ -84,21 +84,6 @@ ErrorFlag (0) {
 	}
 }
 
-//
-// The following not needed yet:
-//
-/*CoordinateTransform :: CoordinateTransform (const list<double>& coord1, const list<double>& coord2, const CoefficientFactory& factory) :  
-Spacing (0.0), ErrorFlag (0) {
-
-	Left = LastAbscissa = LastInSequenceAbscissa = coord1.begin ();
-	Right = coord1.end ();
-	LastValue = LastValueInSequence = coord2.begin ();
-
-	if (coord2.size () != coord1.size ())
-		ErrorFlag = 1;
-}*/
-
-
 CoordinateTransform :: ~CoordinateTransform () {
 
 }
@@ -185,6 +170,21 @@ double CoordinateTransform :: MaxDeltaThirdDerivative () const {
 }
 
 
+int CoordinateTransform :: EvaluateSorted (const double* abscissas, double* result, double* yPrimes, int size) {
+
+	for (int k=0; k<size; k++) {
+
+		if (yPrimes == NULL)
+			result [k] = EvaluateWithExtrapolation (abscissas [k]);
+
+		else
+			result [k] = EvaluateWithExtrapolation (abscissas [k], yPrimes [k]);
+	}
+
+	return 0;
+}
+
+
 
 CSplineTransform :: CSplineTransform (const list<double>& coord1, const list<double>& coord2) : CoordinateTransform (coord1, coord2),
 CurrentInterval (-1), CurrentSequenceInterval (-1), Knots (NULL), Ordinates (NULL), A (NULL), B (NULL), C (NULL), D (NULL), mIsHermite (false) {
@@ -833,11 +833,46 @@ int CSplineTransform :: Initialize () {
 	}
 
 	moments [NumberOfCubics] = u[NumberOfCubics];
-	double OneSixth = 1.0 / 6.0;
 
 	for (j=NumberOfCubics-1; j>=0; j--)
 		moments[j] = q[j] * moments[j+1] + u[j];
 
+	SetNaturalSplineCoefficients (h, gamma, moments);
+
+	delete[] lambda;
+	delete[] mu;
+	delete[] h;
+	delete[] d;
+	delete[] moments;
+	delete[] q;
+	delete[] u;
+	delete[] del;
+	delete[] gamma;
+	return 0;
+}
+
+
+int CSplineTransform :: Initialize (const CSplineCoefficientFactory& factory) {
+
+	// Same as Initialize (), but the knot dependent part of the computation is shared through the factory
+
+	double* moments = new double [NumberOfKnots];
+	double* gamma = new double [NumberOfKnots];
+
+	factory.GetMoments (Ordinates, gamma, moments);
+	SetNaturalSplineCoefficients (factory.GetIntervalWidths (), gamma, moments);
+
+	delete[] moments;
+	delete[] gamma;
+	return 0;
+}
+
+
+int CSplineTransform :: SetNaturalSplineCoefficients (const double* h, const double* gamma, const double* moments) {
+
+	int j;
+	double OneSixth = 1.0 / 6.0;
+
 	for (j=0; j<NumberOfCubics; j++) {
 
 		// These are coefficient for polynomial between Knots [j] and Knots [j+1]
@@ -859,16 +894,6 @@ int CSplineTransform :: Initialize () {
 	double x = Right - Knots [NumberOfCubics-1];
 	mRight = (3.0 * D [LastCubic] * x + 2.0 * C [LastCubic]) * x + B [LastCubic];
 	bRight = Ordinates [NumberOfCubics];
-
-	delete[] lambda;
-	delete[] mu;
-	delete[] h;
-	delete[] d;
-	delete[] moments;
-	delete[] q;
-	delete[] u;
-	delete[] del;
-	delete[] gamma;
 	return 0;
 }
 
@@ -930,10 +955,39 @@ int CSplineTransform :: InitializeHermite (const double* derivs) {
 
 
 
-//
-//  The following not needed yet:
-//
-//CSplineTransform :: CSplineTransform (const list<double>& coord1, const list<double>& coord2, const CoefficientFactory& factory);
+CSplineTransform :: CSplineTransform (const CSplineCoefficientFactory& factory, const double* coord2) :
+CoordinateTransform (factory.GetCoordinates (), coord2, factory.GetNumberOfCoordinates ()),
+CurrentInterval (-1), CurrentSequenceInterval (-1), Knots (NULL), Ordinates (NULL), A (NULL), B (NULL), C (NULL), D (NULL), mIsHermite (false) {
+
+	if (ErrorFlag == 0) {
+
+		const double* coord1 = factory.GetCoordinates ();
+		NumberOfKnots = factory.GetNumberOfCoordinates (); // n+1
+		NumberOfCubics = NumberOfKnots - 1; // n
+		Knots = new double [NumberOfKnots];
+		Ordinates = new double [NumberOfKnots];
+
+		A = new double [NumberOfCubics];
+		B = new double [NumberOfCubics];
+		C = new double [NumberOfCubics];
+		D = new double [NumberOfCubics];
+
+		for (int i=0; i<NumberOfKnots; i++) {
+
+			Knots [i] = coord1 [i];
+			Ordinates [i] = coord2 [i];
+		}
+
+		Left = Knots [0];
+		Right = Knots [NumberOfCubics];
+		Initialize (factory);
+	}
+
+	else {
+
+		NumberOfKnots = NumberOfCubics = 0;
+	}
+}
 
 
 CSplineTransform :: ~CSplineTransform () {
@@ -1165,6 +1219,77 @@ int CSplineTransform :: EvaluateFullSequence (const double* abscissas, double* r
 }
 
 
+int CSplineTransform :: EvaluateSorted (const double* abscissas, double* result, double* yPrimes, int size) {
+
+	//  Same values as EvaluateWithExtrapolation.  While the abscissas increase, the search for each one's interval continues
+	// from the previous one's, so a sorted batch visits each interval once; a decrease starts a new binary search
+
+	if ((ErrorFlag != 0) || (NumberOfCubics < 1))
+		return CoordinateTransform :: EvaluateSorted (abscissas, result, yPrimes, size);
+
+	int k;
+	int interval = 0;
+	int lastInterval = NumberOfCubics - 1;
+	int lastInRange = -1;
+	int lastInRangeInterval = 0;
+	double abscissa;
+	double previous = Left;
+	double x;
+
+	for (k=0; k<size; k++) {
+
+		abscissa = abscissas [k];
+
+		if (abscissa < Left) {
+
+			result [k] = (abscissa - Left) * mLeft + bLeft;
+
+			if (yPrimes != NULL)
+				yPrimes [k] = mLeft;
+
+			continue;
+		}
+
+		if (abscissa > Right) {
+
+			result [k] = (abscissa - Right) * mRight + bRight;
+
+			if (yPrimes != NULL)
+				yPrimes [k] = mRight;
+
+			continue;
+		}
+
+		if (abscissa < previous)
+			interval = SearchForInterval (abscissa);
+
+		else {
+
+			while ((interval < lastInterval) && (abscissa > Knots [interval + 1]))
+				interval++;
+		}
+
+		previous = abscissa;
+		lastInRange = k;
+		lastInRangeInterval = interval;
+		x = abscissa - Knots [interval];
+		result [k] = (((D[interval] * x + C[interval]) * x) + B[interval]) * x + A[interval];
+
+		if (yPrimes != NULL)
+			yPrimes [k] = (3.0 * D[interval] * x + 2.0 * C[interval]) * x + B[interval];
+	}
+
+	if (lastInRange >= 0) {
+
+		LastAbscissa = abscissas [lastInRange];
+		LastValue = result [lastInRange];
+		CurrentInterval = lastInRangeInterval;
+	}
+
+	return 0;
+}
+
+
 double CSplineTransform :: MaxSecondDerivative () const {
 
 	double maxValue = 0.0;
@@ -1624,3 +1749,100 @@ double CSplineTransform :: CalulateFirstDerivative (double abscissa, int interva
 }
 
 
+
+CSplineCoefficientFactory :: CSplineCoefficientFactory (const double* coords, int size) : NumberOfCoordinates (size),
+Coordinates (NULL), H (NULL), SixAlpha (NULL), Mu (NULL), P (NULL), Q (NULL) {
+
+	if ((coords == NULL) || (size < 2))
+		return;
+
+	//
+	// The knot dependent part of CSplineTransform :: Initialize (), with the same operations in the same order
+	//
+
+	int j;
+	int numberOfCubics = size - 1;
+	double alpha;
+	double lambda;
+	Coordinates = new double [size];
+	H = new double [size];
+	SixAlpha = new double [size];
+	Mu = new double [size];
+	P = new double [size];
+	Q = new double [size];
+
+	for (j=0; j<size; j++)
+		Coordinates [j] = coords [j];
+
+	for (j=0; j<numberOfCubics; j++)
+		H[j+1] = Coordinates[j+1] - Coordinates[j];
+
+	Q[0] = 0.0;
+
+	for (j=1; j<=numberOfCubics; j++) {
+
+		if (j < numberOfCubics) {
+
+			alpha = 1.0 / (H[j] + H[j+1]);
+			lambda = H[j+1] * alpha;
+			Mu[j] = 1.0 - lambda;
+			SixAlpha[j] = 6.0 * alpha;
+		}
+
+		else {
+
+			lambda = Mu[j] = SixAlpha[j] = 0.0;
+		}
+
+		P[j] = Mu[j] * Q[j-1] + 2.0;
+		Q[j] = - lambda / P[j];
+	}
+}
+
+
+CSplineCoefficientFactory :: ~CSplineCoefficientFactory () {
+
+	delete[] Coordinates;
+	delete[] H;
+	delete[] SixAlpha;
+	delete[] Mu;
+	delete[] P;
+	delete[] Q;
+}
+
+
+int CSplineCoefficientFactory :: GetMoments (const double* targetCoordData, double* gamma, double* moments) const {
+
+	if (Coordinates == NULL)
+		return -1;
+
+	int j;
+	int numberOfCubics = NumberOfCoordinates - 1;
+	double d;
+	double* u = new double [NumberOfCoordinates];
+
+	for (j=0; j<numberOfCubics; j++)
+		gamma[j+1] = (targetCoordData[j+1] - targetCoordData[j]) / H[j+1];
+
+	u[0] = 0.0;
+
+	for (j=1; j<=numberOfCubics; j++) {
+
+		if (j < numberOfCubics)
+			d = SixAlpha[j] * (gamma[j+1] - gamma[j]);
+
+		else
+			d = 0.0;
+
+		u[j] = (d - Mu[j] * u[j-1]) / P[j];
+	}
+
+	moments [numberOfCubics] = u[numberOfCubics];
+
+	for (j=numberOfCubics-1; j>=0; j--)
+		moments[j] = Q[j] * moments[j+1] + u[j];
+
+	delete[] u;
+	return 0;
+}
+
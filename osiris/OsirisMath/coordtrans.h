@@ -42,6 +42,9 @@
 using namespace std;
 
 
+class CSplineCoefficientFactory;
+
+
 struct SupplementaryData {
 
 	const double* abscissas;
@@ -56,7 +59,6 @@ class CoordinateTransform {
 public:
 	CoordinateTransform (const list<double>& coord1, const list<double>& coord2);
 	CoordinateTransform (const double* coord1, const double* coord2, int size);
-//	CoordinateTransform (const list<double>& coord1, const list<double>& coord2, const CoefficientFactory& factory);  // not needed yet
 	virtual ~CoordinateTransform ();
 
 	bool IsValid () const { return ErrorFlag == 0; }
@@ -75,6 +77,11 @@ public:
 
 	// evaluates sequence of length 'size' based on irregularly spaced, ORDERED abscissas in 'abscissas'; returns >=0 on OK
 	virtual int EvaluateFullSequence (const double* abscissas, double* result, int size);
+
+	// same as EvaluateWithExtrapolation at each of 'size' abscissas, fastest when they are in increasing order; yPrimes may be NULL
+	int EvaluateSorted (const double* abscissas, double* result, int size) { return EvaluateSorted (abscissas, result, NULL, size); }
+	virtual int EvaluateSorted (const double* abscissas, double* result, double* yPrimes, int size);
+
 	virtual double MaxSecondDerivative () const;
 	virtual double MaxDeltaThirdDerivative () const;
 	virtual int GetFirstDerivativeAtKnots (double*& firstDerivs) { firstDerivs = NULL; return 0; }
@@ -110,7 +117,7 @@ public:
 	CSplineTransform (const list<double>& coord1, const list<double>& coord2, bool isHermite);	// this is primarily for Hermite cubic splines, but using finite differences for derivatives
 	CSplineTransform (const double* coord1, const double* coord2, int size, bool isHermite, bool useQuad);	// this is primarily for Hermite cubic splines, but using monotone preserving quadratic approx. for derivatives
 	CSplineTransform (const list<double>& coord1, const list<double>& coord2, bool isHermite, bool useQuad);	// this is primarily for Hermite cubic splines, but using monotone preserving quadratic approx. for derivatives
-//	CSplineTransform (const list<double>& coord1, const list<double>& coord2, const CoefficientFactory& factory);  // not needed yet
+	CSplineTransform (const CSplineCoefficientFactory& factory, const double* coord2);	// natural spline, knots and factorization from factory
 	virtual ~CSplineTransform ();
 
 	virtual double Evaluate (double abscissa);  // single evaluation, not part of a sequence
@@ -128,6 +135,10 @@ public:
 	// evaluates sequence of length 'size' based on irregularly spaced, ORDERED abscissas in 'abscissas'; returns >=0 on OK
 	virtual int EvaluateFullSequence (const double* abscissas, double* result, int size);
 
+	// same as EvaluateWithExtrapolation at each of 'size' abscissas; increasing abscissas share one pass through the intervals
+	int EvaluateSorted (const double* abscissas, double* result, int size) { return EvaluateSorted (abscissas, result, NULL, size); }
+	virtual int EvaluateSorted (const double* abscissas, double* result, double* yPrimes, int size);
+
 	virtual double MaxSecondDerivative () const;
 	virtual double MaxDeltaThirdDerivative () const;
 	virtual int GetFirstDerivativeAtKnots (double*& firstDerivs);
@@ -170,6 +181,8 @@ private:
 	double bRight;
 
 	int Initialize ();
+	int Initialize (const CSplineCoefficientFactory& factory);
+	int SetNaturalSplineCoefficients (const double* h, const double* gamma, const double* moments);
 	int InitializeHermite (const double* derivs);
 	int SearchForInterval (double abscissa);
 	int SearchForInterval (double abscissa, double start, int startInterval);
@@ -183,36 +196,39 @@ private:
 
 
 //
-//  The following is commented out because it is not thought to be needed as of 03/22/07.  If
-// that changes, it can be restored.
+//  The part of the natural spline computation that depends only on the knots:  interval widths and the pivots of the
+// tridiagonal moment system.  Transforms from one set of knots to many sets of ordinates (a sample's ILS to each of the
+// ladders) can share one factory, so that each transform only back-substitutes for its moments.  Results are identical
+// to those of CSplineTransform (coord1, coord2, size).
 //
 
-/*
-class CoefficientFactory {
+class CSplineCoefficientFactory {
 
 public:
-	CoefficientFactory (const list<double>& coords);
-	virtual ~CoefficientFactory ();
+	CSplineCoefficientFactory (const double* coords, int size);
+	~CSplineCoefficientFactory ();
 
-	virtual int GetMoments (const double* targetCoordData, double*& moments) const;
+	bool IsValid () const { return Coordinates != NULL; }
 	int GetNumberOfCoordinates () const { return NumberOfCoordinates; }
+	const double* GetCoordinates () const { return Coordinates; }
+	const double* GetIntervalWidths () const { return H; }
+
+	// computes gamma [j+1] = (targetCoordData [j+1] - targetCoordData [j]) / h [j+1] and the natural spline moments
+	int GetMoments (const double* targetCoordData, double* gamma, double* moments) const;
 
 protected:
 	int NumberOfCoordinates;
-};
+	double* Coordinates;
+	double* H;
+	double* SixAlpha;
+	double* Mu;
+	double* P;
+	double* Q;
 
-
-class CSplineCoefficientFactory : public CoefficientFactory {
-
-public:
-	CSplineCoefficientFactory (const list<double>& coords);
-	virtual ~CSplineCoefficientFactory ();
-
-	virtual int GetMoments (const double* targetCoordData, double*& moments) const;
-
-protected:
-	double** FactoryMatrix;
+private:
+	// owns its arrays, so not copyable; declared and not defined
+	CSplineCoefficientFactory (const CSplineCoefficientFactory&);
+	CSplineCoefficientFactory& operator= (const CSplineCoefficientFactory&);
 };
-*/
 
 #endif  /*  _COORDTRANS_H_  */
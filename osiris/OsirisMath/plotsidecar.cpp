@@ -0,0 +1,443 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: plotsidecar.cpp
+*
+*/
+//
+// class PlotSidecar, the binary companion to a .plt file, with its trace arrays in delta coded chunks
+//
+
+#include "plotsidecar.h"
+#include <cstring>
+
+// OsirisMath is also built without BaseClassLib on the include path, so rgdefs.h is not available
+
+#ifdef _WIN32
+typedef __int64 INT64;
+typedef unsigned __int64 UINT64;
+#else
+#include <stdint.h>
+typedef int64_t INT64;
+typedef uint64_t UINT64;
+#endif
+
+
+static const char* SidecarMagic = "OSPB";
+
+
+static void PutUnsigned (string& output, UINT64 value, int nBytes) {
+
+	for (int i=0; i<nBytes; i++) {
+
+		output += (char)(value & 0xff);
+		value >>= 8;
+	}
+}
+
+
+static bool GetUnsigned (const unsigned char*& p, const unsigned char* end, int nBytes, UINT64& value) {
+
+	if (end - p < nBytes)
+		return false;
+
+	value = 0;
+
+	for (int i=nBytes-1; i>=0; i--)
+		value = (value << 8) | p [i];
+
+	p += nBytes;
+	return true;
+}
+
+
+const char* PlotSidecar :: Extension = ".pltb";
+const int PlotSidecar :: ChunkSize = 4096;
+const int PlotSidecar :: Format = 2;   // change whenever the layout changes
+
+
+PlotSidecar :: PlotSidecar () : mPltSize (0), mPltHash (0) {
+
+}
+
+
+PlotSidecar :: ~PlotSidecar () {
+
+	Clear ();
+}
+
+
+const char* PlotSidecar :: GetArrayTagName (int type) {
+
+	switch (type) {
+
+		case RawPoints:
+			return "rawPoints";
+
+		case AnalyzedPoints:
+			return "analyzedPoints";
+
+		case LadderPoints:
+			return "ladderPoints";
+
+		case BaselinePoints:
+			return "baselinePoints";
+	}
+
+	return "";
+}
+
+
+string PlotSidecar :: SidecarFileName (const string& pltFileName) {
+
+	size_t length = pltFileName.length ();
+
+	if ((length >= 4) && (pltFileName.compare (length - 4, 4, ".plt") == 0))
+		return pltFileName.substr (0, length - 4) + Extension;
+
+	return pltFileName + Extension;
+}
+
+
+unsigned long long PlotSidecar :: HashText (const char* text, size_t length) {
+
+	const unsigned char* p = (const unsigned char*) text;
+	UINT64 hash = 14695981039346656037ULL;
+
+	for (size_t i=0; i<length; i++) {
+
+		hash ^= p [i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+
+void PlotSidecar :: Clear () {
+
+	vector<PlotSidecarArray*>::iterator it;
+
+	for (it=mArrays.begin (); it!=mArrays.end (); it++)
+		delete *it;
+
+	mArrays.clear ();
+	mPeakSections.clear ();
+	mPltSize = 0;
+	mPltHash = 0;
+}
+
+
+void PlotSidecar :: AddArray (int channel, int type, const int* values, int numberOfValues, unsigned long textOffset, unsigned long textEnd) {
+
+	PlotSidecarArray* array = new PlotSidecarArray;
+	array->channel = channel;
+	array->type = type;
+	array->textOffset = textOffset;
+	array->textLength = (textEnd > textOffset) ? textEnd - textOffset : 0;
+
+	if ((values != NULL) && (numberOfValues > 0))
+		array->values.assign (values, values + numberOfValues);
+
+	mArrays.push_back (array);
+}
+
+
+void PlotSidecar :: AddPeakSection (int channel, unsigned long offset, unsigned long end) {
+
+	PlotSidecarPeakSection section;
+	section.channel = channel;
+	section.offset = offset;
+	section.length = (end > offset) ? end - offset : 0;
+	mPeakSections.push_back (section);
+}
+
+
+void PlotSidecar :: Encode (string& output, const char* pltText, size_t pltLength) const {
+
+	vector<PlotSidecarArray*>::const_iterator it;
+	vector<PlotSidecarPeakSection>::const_iterator sectionIt;
+	PlotSidecarArray* array;
+	int numberOfValues;
+	int start;
+	int n;
+	string chunk;
+
+	output.erase ();
+	output.append (SidecarMagic, 4);
+	PutUnsigned (output, Format, 4);
+	PutUnsigned (output, pltLength, 8);
+	PutUnsigned (output, HashText (pltText, pltLength), 8);
+	PutUnsigned (output, mArrays.size (), 4);
+
+	for (it=mArrays.begin (); it!=mArrays.end (); it++) {
+
+		array = *it;
+		numberOfValues = (int)array->values.size ();
+		PutUnsigned (output, (unsigned int)array->channel, 4);
+		PutUnsigned (output, (unsigned int)array->type, 4);
+		PutUnsigned (output, array->textOffset, 8);
+		PutUnsigned (output, array->textLength, 8);
+		PutUnsigned (output, numberOfValues, 4);
+		PutUnsigned (output, (numberOfValues + ChunkSize - 1) / ChunkSize, 4);
+
+		for (start=0; start<numberOfValues; start+=ChunkSize) {
+
+			n = numberOfValues - start;
+
+			if (n > ChunkSize)
+				n = ChunkSize;
+
+			chunk.erase ();
+			EncodeChunk (chunk, &array->values [start], n);
+			PutUnsigned (output, n, 4);
+			PutUnsigned (output, chunk.length (), 4);
+			output += chunk;
+		}
+	}
+
+	PutUnsigned (output, mPeakSections.size (), 4);
+
+	for (sectionIt=mPeakSections.begin (); sectionIt!=mPeakSections.end (); sectionIt++) {
+
+		PutUnsigned (output, (unsigned int)sectionIt->channel, 4);
+		PutUnsigned (output, sectionIt->offset, 8);
+		PutUnsigned (output, sectionIt->length, 8);
+	}
+
+	output.append (SidecarMagic, 4);
+}
+
+
+bool PlotSidecar :: Decode (const char* data, size_t length) {
+
+	const unsigned char* p = (const unsigned char*) data;
+	const unsigned char* end = p + length;
+	const unsigned char* chunkEnd;
+	UINT64 value;
+	UINT64 numberOfArrays;
+	UINT64 numberOfValues;
+	UINT64 numberOfChunks;
+	UINT64 chunkValues;
+	UINT64 chunkBytes;
+	UINT64 numberOfSections;
+	UINT64 i;
+	UINT64 j;
+	PlotSidecarArray* array;
+	PlotSidecarPeakSection section;
+
+	Clear ();
+
+	if ((length < 8) || (memcmp (p, SidecarMagic, 4) != 0) || (memcmp (end - 4, SidecarMagic, 4) != 0))
+		return false;
+
+	p += 4;
+	end -= 4;
+
+	if (!GetUnsigned (p, end, 4, value) || (value != (UINT64)Format))
+		return false;
+
+	if (!GetUnsigned (p, end, 8, value))
+		return false;
+
+	mPltSize = (unsigned long)value;
+
+	if (!GetUnsigned (p, end, 8, value))
+		return false;
+
+	mPltHash = value;
+
+	if (!GetUnsigned (p, end, 4, numberOfArrays))
+		return false;
+
+	for (i=0; i<numberOfArrays; i++) {
+
+		array = new PlotSidecarArray;
+		mArrays.push_back (array);
+
+		if (!GetUnsigned (p, end, 4, value))
+			break;
+
+		array->channel = (int)value;
+
+		if (!GetUnsigned (p, end, 4, value))
+			break;
+
+		array->type = (int)value;
+
+		if (!GetUnsigned (p, end, 8, value))
+			break;
+
+		array->textOffset = (unsigned long)value;
+
+		if (!GetUnsigned (p, end, 8, value))
+			break;
+
+		array->textLength = (unsigned long)value;
+
+		if (!GetUnsigned (p, end, 4, numberOfValues) || !GetUnsigned (p, end, 4, numberOfChunks))
+			break;
+
+		// every value takes at least one byte
+
+		if (numberOfValues > (UINT64)(end - p))
+			break;
+
+		array->values.reserve ((size_t)numberOfValues);
+
+		for (j=0; j<numberOfChunks; j++) {
+
+			if (!GetUnsigned (p, end, 4, chunkValues) || !GetUnsigned (p, end, 4, chunkBytes))
+				break;
+
+			if ((chunkBytes > (UINT64)(end - p)) || (chunkValues > chunkBytes))
+				break;
+
+			chunkEnd = p + chunkBytes;
+
+			if (!DecodeChunk (p, chunkEnd, (int)chunkValues, array->values) || (p != chunkEnd))
+				break;
+		}
+
+		if ((j < numberOfChunks) || (array->values.size () != numberOfValues))
+			break;
+	}
+
+	if ((i < numberOfArrays) || !GetUnsigned (p, end, 4, numberOfSections)) {
+
+		Clear ();
+		return false;
+	}
+
+	for (i=0; i<numberOfSections; i++) {
+
+		if (!GetUnsigned (p, end, 4, value))
+			break;
+
+		section.channel = (int)value;
+
+		if (!GetUnsigned (p, end, 8, value))
+			break;
+
+		section.offset = (unsigned long)value;
+
+		if (!GetUnsigned (p, end, 8, value))
+			break;
+
+		section.length = (unsigned long)value;
+		mPeakSections.push_back (section);
+	}
+
+	if ((i < numberOfSections) || (p != end)) {
+
+		Clear ();
+		return false;
+	}
+
+	return true;
+}
+
+
+bool PlotSidecar :: MatchesPltText (const char* pltText, size_t pltLength) const {
+
+	vector<PlotSidecarArray*>::const_iterator it;
+	unsigned long offset;
+	unsigned long textEnd;
+
+	if ((pltLength != mPltSize) || (HashText (pltText, pltLength) != mPltHash))
+		return false;
+
+	for (it=mArrays.begin (); it!=mArrays.end (); it++) {
+
+		offset = (*it)->textOffset;
+		textEnd = offset + (*it)->textLength;
+
+		if ((offset == 0) || (textEnd >= pltLength) || (textEnd < offset))
+			return false;
+
+		if ((pltText [offset - 1] != '>') || (pltText [textEnd] != '<'))
+			return false;
+	}
+
+	return true;
+}
+
+
+void PlotSidecar :: EncodeChunk (string& output, const int* values, int numberOfValues) {
+
+	// Each chunk starts from zero, so chunks decode independently.  Differences are zigzag coded, so small steps
+	// of either sign are small, and written seven bits to a byte, low bits first
+
+	int previous = 0;
+	UINT64 zigzag;
+	INT64 delta;
+
+	for (int i=0; i<numberOfValues; i++) {
+
+		delta = (INT64)values [i] - (INT64)previous;
+		previous = values [i];
+		zigzag = (UINT64)((delta << 1) ^ (delta >> 63));
+
+		while (zigzag >= 0x80) {
+
+			output += (char)((zigzag & 0x7f) | 0x80);
+			zigzag >>= 7;
+		}
+
+		output += (char)zigzag;
+	}
+}
+
+
+bool PlotSidecar :: DecodeChunk (const unsigned char*& p, const unsigned char* end, int numberOfValues, vector<int>& values) {
+
+	int previous = 0;
+	UINT64 zigzag;
+	int shift;
+	INT64 delta;
+
+	for (int i=0; i<numberOfValues; i++) {
+
+		zigzag = 0;
+		shift = 0;
+
+		do {
+
+			if ((p >= end) || (shift > 63))
+				return false;
+
+			zigzag |= (UINT64)(*p & 0x7f) << shift;
+			shift += 7;
+		}
+		while (*p++ & 0x80);
+
+		delta = (INT64)(zigzag >> 1) ^ -(INT64)(zigzag & 1);
+		previous = (int)((INT64)previous + delta);
+		values.push_back (previous);
+	}
+
+	return true;
+}
+
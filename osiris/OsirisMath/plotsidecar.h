@@ -0,0 +1,121 @@
+/*
+* ===========================================================================
+*
+*                            PUBLIC DOMAIN NOTICE
+*               National Center for Biotechnology Information
+*
+*  This software/database is a "United States Government Work" under the
+*  terms of the United States Copyright Act.  It was written as part of
+*  the author's official duties as a United States Government employee and
+*  thus cannot be copyrighted.  This software/database is freely available
+*  to the public for use. The National Library of Medicine and the U.S.
+*  Government have not placed any restriction on its use or reproduction.
+*
+*  Although all reasonable efforts have been taken to ensure the accuracy
+*  and reliability of the software and data, the NLM and the U.S.
+*  Government do not and cannot warrant the performance or results that
+*  may be obtained by using this software or data. The NLM and the U.S.
+*  Government disclaim all warranties, express or implied, including
+*  warranties of performance, merchantability or fitness for any particular
+*  purpose.
+*
+*  Please cite the author in any work or product based on this material.
+*
+* ===========================================================================
+*
+*  FileName: plotsidecar.h
+*
+*/
+//
+// class PlotSidecar, the binary companion to a .plt file.  The trace arrays of the .plt (rawPoints, analyzedPoints,
+// ladderPoints and baselinePoints for each channel) are stored columnar, one array at a time, in chunks of delta
+// coded variable length integers; most points of a trace take one byte.  Each array records the byte range of its text
+// in the .plt, and each channel the byte range of its peak and artifact elements, so a reader can take the arrays from
+// the sidecar and parse only the rest of the .plt.  The sidecar records the size of the .plt it was written with; a
+// reader must check it, and fall back to the .plt alone if it differs.  Shared by the analysis, which writes the
+// sidecar, and the viewer, which reads it; neither needs the other's file classes.
+//
+// Layout, all integers little endian:  "OSPB", format (4 bytes), .plt size (8), .plt hash (8), number of
+// arrays (4), the arrays, number
+// of peak sections (4), the peak sections, "OSPB".  Array:  channel (4), type (4), text offset (8), text length (8),
+// number of values (4), number of chunks (4), then for each chunk the number of values (4), the number of bytes (4)
+// and the bytes.  Peak section:  channel (4), offset (8), length (8)
+//
+
+#ifndef _PLOTSIDECAR_H_
+#define _PLOTSIDECAR_H_
+
+#include <string>
+#include <vector>
+
+
+using namespace std;
+
+
+struct PlotSidecarArray {
+
+	int channel;
+	int type;
+	unsigned long textOffset;
+	unsigned long textLength;
+	vector<int> values;
+};
+
+
+struct PlotSidecarPeakSection {
+
+	int channel;
+	unsigned long offset;
+	unsigned long length;
+};
+
+
+class PlotSidecar {
+
+public:
+	PlotSidecar ();
+	~PlotSidecar ();
+
+	enum {RawPoints, AnalyzedPoints, LadderPoints, BaselinePoints, NumberOfArrayTypes};
+
+	static const char* Extension;   // ".pltb", replacing the .plt extension
+	static const char* GetArrayTagName (int type);
+	static string SidecarFileName (const string& pltFileName);
+	static unsigned long long HashText (const char* text, size_t length);   // 64 bit FNV-1a
+
+	void Clear ();
+
+	// Writing:  textOffset and textEnd bound the array's text in the .plt, between its start and end tags
+
+	void AddArray (int channel, int type, const int* values, int numberOfValues, unsigned long textOffset, unsigned long textEnd);
+	void AddPeakSection (int channel, unsigned long offset, unsigned long end);
+	void Encode (string& output, const char* pltText, size_t pltLength) const;
+
+	// Reading:  false if the data are not a complete sidecar
+
+	bool Decode (const char* data, size_t length);
+	unsigned long GetPltSize () const { return mPltSize; }
+	const vector<PlotSidecarArray*>& GetArrays () const { return mArrays; }
+	const vector<PlotSidecarPeakSection>& GetPeakSections () const { return mPeakSections; }
+
+	// True if the .plt text has the recorded size and hash, and every array's range in it is the content of an element:
+	// a '>' before it and a '<' after it
+
+	bool MatchesPltText (const char* pltText, size_t pltLength) const;
+
+protected:
+	unsigned long mPltSize;
+	unsigned long long mPltHash;
+	vector<PlotSidecarArray*> mArrays;
+	vector<PlotSidecarPeakSection> mPeakSections;
+
+	static const int ChunkSize;
+	static const int Format;
+
+	static void EncodeChunk (string& output, const int* values, int numberOfValues);
+	static bool DecodeChunk (const unsigned char*& p, const unsigned char* end, int numberOfValues, vector<int>& values);
+};
+
+
+#endif  /*  _PLOTSIDECAR_H_  */
+
@@ -69,6 +69,7 @@
 #include "OsirisInputFile.h"
 #include "IndividualGenotype.h"
 #include "rgparray.h"
+#include "AnalysisTrace.h"
 
 
 #include <string>
@@ -185,6 +186,15 @@ int _tmain(int argc, _TCHAR* argv[]) {
 	if (inputFile.IsLadderFreeAnalysis ())
 		isLadderFree = true;
 
+	if (inputFile.TraceTimeline ())
+		AnalysisTrace::SetEnabled (true);
+
+	if (inputFile.PlotSidecar ())
+		CoreBioComponent::SetWritePlotSidecar (true);
+
+	if (inputFile.GetSnapshotDirectory ().Length () > 0)
+		SmartMessage::SetSnapshotDirectory (inputFile.GetSnapshotDirectory ());
+
 	STRLCAnalysis::SetOutputSubDirectory (OutputSubDirectory);
 	GenotypesForAMarkerSet::SetPathToStandardControlFile (ConfigDirectory);
 
@@ -1179,7 +1179,7 @@ public:
       // OS-357, no need to wait for lock, will check reload later.
       //  discard this and following lines on 6/5/2018
       // (m_pLock->HasLock(sFileName) || m_pLock->WaitUntilUnlocked(sFileName,3)) &&
-      (bExist ? apDoc->Load(sFileName) : true);
+      (bExist ? LoadDocument(apDoc.get(),sFileName) : true);
     m_dtFileModTime.Set((time_t)0);
     if(!bRtn) {}
     else if(bExist)
@@ -1331,6 +1331,12 @@ public:
   }
 
 protected:
+  virtual bool LoadDocument(wxXmlDocument *pDoc, const wxString &sFileName)
+  {
+    // used by LoadFile(), a subclass can override this
+    // to load a document from a file differently
+    return pDoc->Load(sFileName);
+  }
   virtual void ClearRegistration()
   {
     m_xml.Clear();
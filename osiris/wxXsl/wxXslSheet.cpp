@@ -32,7 +32,39 @@
 #include "nwx/nwxString.h"
 #include <libxslt/transform.h>
 #include <libxslt/xsltutils.h>
+#include <wx/filename.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdio.h>
+
+extern "C"
+{
+  static void SharedErrorFunction(void *pCtx, const char *msg,...)
+  {
+    // same as GenericErrorFunction() in wxXml2Object.cpp except
+    // that the message is appended to a vector<wxString>
+    va_list ap;
+    va_start(ap,msg);
+    const size_t BUFFERSIZE = 4095;
+    char sBuffer[BUFFERSIZE + 1];
+    memset(sBuffer,0, sizeof(sBuffer));
+    vsnprintf(sBuffer,BUFFERSIZE,msg,ap);
+    sBuffer[BUFFERSIZE] = 0;
+    va_end(ap);
+
+    size_t nLen = strlen(sBuffer);
+    while(nLen > 0 && sBuffer[nLen - 1] <= 32)
+    {
+      nLen--;
+      sBuffer[nLen] = 0;
+    }
+    if(sBuffer[0] && (pCtx != NULL))
+    {
+      ((vector<wxString> *)pCtx)->push_back(wxString(sBuffer));
+    }
+  }
+};
 
 
 wxXslSheet::wxXslSheet() : 
@@ -220,6 +252,84 @@ bool wxXslSheet::TransformToFile(
   return bRtn;
 }
 
+bool wxXslSheet::TransformToFileShared(
+  const wxString &sFileName,
+  wxXml2Document *pXml2,
+  vector<wxString> *pasErrors)
+{
+  xmlDocPtr pDocShared = pXml2->GetDocPtr();
+  xmlDocPtr pDocIn = NULL;
+  xmlDocPtr pDoc = NULL;
+  xsltTransformContextPtr pCtxt = NULL;
+  bool bRtn = false;
+
+  // libxml2 error handlers are per thread and this may run on
+  // the main thread, so the caller's handler is restored below.
+  // libxslt errors are sent to the transform context
+
+  xmlGenericErrorFunc pSaveErrorFunc = xmlGenericError;
+  void *pSaveErrorContext = xmlGenericErrorContext;
+  xmlSetGenericErrorFunc(pasErrors,SharedErrorFunction);
+
+  // xsl:key, generate-id() and xsl:strip-space write to the
+  // input document, so each transform gets a copy of its own
+  // and the shared document is only read
+
+  if((m_pSheet != NULL) && (pDocShared != NULL))
+  {
+    pDocIn = xmlCopyDoc(pDocShared,1);
+  }
+  if(pDocIn != NULL)
+  {
+    pCtxt = xsltNewTransformContext(m_pSheet,pDocIn);
+  }
+  if(pCtxt != NULL)
+  {
+    xsltSetTransformErrorFunc(pCtxt,pasErrors,SharedErrorFunction);
+    pDoc = xsltApplyStylesheetUser(
+      m_pSheet,pDocIn,m_parmsUser.GetParms(),NULL,NULL,pCtxt);
+    xsltFreeTransformContext(pCtxt);
+  }
+  if(pDoc != NULL)
+  {
+    wxString sTemp = wxFileName::CreateTempFileName(sFileName);
+    wxString s;
+    if(sTemp.IsEmpty())
+    {
+      s = _T("Could not create temporary file for: ");
+    }
+    else if(xsltSaveResultToFilename(
+      sTemp.utf8_str(),pDoc,m_pSheet,0) < 0)
+    {
+      s = _T("Could not write file: ");
+    }
+    else if(!wxRenameFile(sTemp,sFileName,true))
+    {
+      s = _T("Could not replace existing file: ");
+    }
+    else
+    {
+      bRtn = true;
+    }
+    if(!bRtn)
+    {
+      s.Append(sFileName);
+      pasErrors->push_back(s);
+      if(!sTemp.IsEmpty() && wxFileExists(sTemp))
+      {
+        wxRemoveFile(sTemp);
+      }
+    }
+    xmlFreeDoc(pDoc);
+  }
+  if(pDocIn != NULL)
+  {
+    xmlFreeDoc(pDocIn);
+  }
+  xmlSetGenericErrorFunc(pSaveErrorContext,pSaveErrorFunc);
+  return bRtn;
+}
+
 
 //********************************************* wxXslParams
 
@@ -149,6 +149,17 @@ public:
   }
   wxXml2Document *TransformToDOM(wxXml2Document *);
   bool TransformToFile(const wxString &sFileName,wxXml2Document *);
+
+  // for transforms running concurrently on worker threads:
+  // the document is only read, each transform uses a copy of it,
+  // errors are collected in pasErrors instead of sent to the
+  // receivers, and the output is written to a temporary file
+  // which is then renamed to sFileName
+
+  bool TransformToFileShared(
+    const wxString &sFileName,
+    wxXml2Document *,
+    vector<wxString> *pasErrors);
   void ClearParms()
   {
     m_parmsUser.Clear();
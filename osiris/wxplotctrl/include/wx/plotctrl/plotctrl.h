@@ -574,6 +574,16 @@ public:
     void SetDrawSpline( bool drawspline = false )
         { m_draw_spline = drawspline; Redraw(wxPLOTCTRL_REDRAW_PLOT); }
 
+    // Keep the curves drawn in the plot window in a bitmap so that redrawing
+    //   what is under or over them (markers, labels, ...) doesn't redraw
+    //   every point, the curves are redrawn when the view, the size, the
+    //   curves, their pens or selections change. Call InvalidateCurveCache
+    //   if the points of a curve are changed in place.
+    bool GetCacheCurves() const { return m_cache_curves; }
+    void SetCacheCurves( bool cache_curves = true )
+        { m_cache_curves = cache_curves; InvalidateCurveCache(); }
+    void InvalidateCurveCache() { m_curveCacheKey.Clear(); }
+
     // Draw the plot grid over the whole window, else just tick marks at edge
     bool GetDrawGrid() const { return m_draw_grid; }
     void SetDrawGrid( bool drawgrid = true )
@@ -807,6 +817,10 @@ public:
     virtual void DrawPlotCtrl( wxDC *dc );
     // Draw the area window
     virtual void DrawAreaWindow( wxDC *dc, const wxRect& rect );
+    // Draw the area window onto its backing bitmap, see SetCacheCurves
+    void DrawAreaBitmap( wxDC *dc, const wxRect& rect );
+    // Draw all the curves, the active curve on top
+    virtual void DrawCurves( wxDC *dc, const wxRect &rect );
     // Draw a wxPlotData derived curve
     virtual void DrawDataCurve( wxDC *dc, wxPlotData *curve, int curve_index, const wxRect &rect );
     // Draw a generic wxPlotCurve curve
@@ -1014,6 +1028,15 @@ protected:
     wxRect2DDouble m_defaultPlotRect;   // default extent of the plot, fallback
     wxRect         m_areaClientRect;    // rect of (wxPoint(0,0), PlotArea.GetClientSize())
 
+    // cache of the curves drawn in the area window, see SetCacheCurves
+    bool           m_cache_curves;
+    bool           m_drawing_area_bitmap; // DrawAreaWindow is drawing m_area's bitmap
+    wxBitmap       m_curveBitmap;
+    wxRect2DDouble m_curveCacheView;
+    wxArrayLong    m_curveCacheKey;       // empty when the bitmap is invalid
+    bool DrawCachedCurves( wxDC *dc, const wxRect &rect );
+    void GetCurveCacheKey( wxArrayLong &key ) const;
+
     wxArrayInt m_xAxisTicks, m_yAxisTicks; // pixel coordinates of the tic marks
     wxArrayString m_xAxisTickLabels, m_yAxisTickLabels; // the tick labels
     wxString   m_xAxisTickFormat, m_yAxisTickFormat; // format %lg for example
@@ -231,6 +231,12 @@ public:
     int GetMinYIndex(int start_index = 0, int end_index = -1) const;
     int GetMaxYIndex(int start_index = 0, int end_index = -1) const;
 
+    // Get the indexes of the first min and max y values in [start_index, end_index]
+    //   in O(log(count)) time from a min/max pyramid built by CalcBoundingRect.
+    //   Returns false if there is none, X is not ordered or Y is not all finite.
+    bool GetMinMaxYIndexes(int start_index, int end_index,
+                           int &min_index, int &max_index) const;
+
     //-------------------------------------------------------------------------
     // Data processing functions
     //-------------------------------------------------------------------------
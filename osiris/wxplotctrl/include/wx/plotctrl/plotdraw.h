@@ -222,6 +222,10 @@ public:
     virtual void Draw(wxDC *dc, wxPlotData* plotData, int curve_index);
 
 private:
+    // Draw lines through only the first, min, max and last points of each
+    //   pixel column, returns false if the curve has no min/max pyramid
+    bool DrawDecimated(wxDC *dc, wxPlotData* plotData, int n_start, int n_end);
+
     DECLARE_ABSTRACT_CLASS(wxPlotDrawerDataCurve);
 };
 
@@ -38,6 +38,7 @@
 #include "wx/splitter.h"
 #include "wx/math.h"
 #include "wx/image.h"
+#include "wx/graphics.h"
 
 #include "wx/plotctrl/plotctrl.h"
 #include "wx/plotctrl/plotdraw.h"
@@ -332,7 +333,7 @@ void wxPlotCtrlArea::CreateBitmap( const wxRect &rect )
 
     wxMemoryDC mdc;
     mdc.SelectObject( m_bitmap );
-    m_owner->DrawAreaWindow( &mdc, refreshRect );
+    m_owner->DrawAreaBitmap( &mdc, refreshRect );
     mdc.SelectObject( wxNullBitmap );
 }
 
@@ -502,6 +503,9 @@ void wxPlotCtrl::Init()
     m_curveBoundingRect = m_defaultPlotRect;
     m_areaClientRect    = wxRect(0, 0, 10, 10);
 
+    m_cache_curves        = false;
+    m_drawing_area_bitmap = false;
+
     m_xAxisTickFormat = m_yAxisTickFormat = wxT("%lf");
     m_xAxisTick_step  = m_yAxisTick_step  = 1.0;
     m_xAxisTick_count = m_yAxisTick_count = 4;
@@ -1223,6 +1227,8 @@ bool wxPlotCtrl::AddCurve( wxPlotCurve *curve, bool select, bool send_event )
     m_curves.Add( curve );
     m_curveSelections.Add(new wxRangeDoubleSelection());
     m_dataSelections.Add(new wxRangeIntSelection());
+    // a new curve may be allocated where a deleted one was
+    InvalidateCurveCache();
 
     CalcBoundingPlotRect();
     CreateKeyString();
@@ -2611,6 +2617,31 @@ void wxPlotCtrl::DrawAreaWindow( wxDC *dc, const wxRect &rect )
     // in printouts, the curve sometimes escapes the rectangle
     //dc->DestroyClippingRegion();
 
+    if (!DrawCachedCurves( dc, refreshRect ))
+        DrawCurves( dc, refreshRect );
+
+    DrawCurveCursor( dc );
+    DrawKey( dc );
+
+    // refresh border
+    dc->SetBrush( *wxTRANSPARENT_BRUSH );
+    dc->SetPen( wxPen(GetBorderColour(), m_area_border_width, wxSOLID) );
+    dc->DrawRectangle(clientRect);
+
+    dc->SetPen( wxNullPen );
+    dc->SetBrush( wxNullBrush );
+}
+
+void wxPlotCtrl::DrawAreaBitmap( wxDC *dc, const wxRect &rect )
+{
+    // only the window's own bitmap uses the curve cache, not printing
+    m_drawing_area_bitmap = true;
+    DrawAreaWindow( dc, rect );
+    m_drawing_area_bitmap = false;
+}
+
+void wxPlotCtrl::DrawCurves( wxDC *dc, const wxRect &rect )
+{
     int i;
     wxPlotCurve *curve;
     wxPlotCurve *activeCurve = GetActiveCurve();
@@ -2621,30 +2652,124 @@ void wxPlotCtrl::DrawAreaWindow( wxDC *dc, const wxRect &rect )
         if (curve != activeCurve)
         {
             if (wxDynamicCast(curve, wxPlotData))
-                DrawDataCurve( dc, wxDynamicCast(curve, wxPlotData), i, refreshRect );
+                DrawDataCurve( dc, wxDynamicCast(curve, wxPlotData), i, rect );
             else
-                DrawCurve( dc, curve, i, refreshRect );
+                DrawCurve( dc, curve, i, rect );
         }
     }
     // active curve is drawn on top
     if (activeCurve)
     {
         if (wxDynamicCast(activeCurve, wxPlotData))
-            DrawDataCurve( dc, wxDynamicCast(activeCurve, wxPlotData), GetActiveIndex(), refreshRect );
+            DrawDataCurve( dc, wxDynamicCast(activeCurve, wxPlotData), GetActiveIndex(), rect );
         else
-            DrawCurve( dc, activeCurve, GetActiveIndex(), refreshRect );
+            DrawCurve( dc, activeCurve, GetActiveIndex(), rect );
     }
+}
 
-    DrawCurveCursor( dc );
-    DrawKey( dc );
+void wxPlotCtrl::GetCurveCacheKey( wxArrayLong &key ) const
+{
+    // everything, other than the view and size, that changes how the curves look
+    key.Clear();
+    key.Add(m_draw_lines ? 1 : 0);
+    key.Add(m_draw_spline ? 1 : 0);
+    key.Add(m_active_index);
+    key.Add(GetCurveCount());
 
-    // refresh border
-    dc->SetBrush( *wxTRANSPARENT_BRUSH );
-    dc->SetPen( wxPen(GetBorderColour(), m_area_border_width, wxSOLID) );
-    dc->DrawRectangle(clientRect);
+    int i, p;
+    for(i=0; i<GetCurveCount(); i++)
+    {
+        wxPlotCurve *curve = GetCurve(i);
+        wxPlotData *plotData = wxDynamicCast(curve, wxPlotData);
 
-    dc->SetPen( wxNullPen );
-    dc->SetBrush( wxNullBrush );
+        key.Add((long)wxPtrToUInt(curve));
+        key.Add(plotData ? plotData->GetCount() : 0);
+        key.Add(plotData ? GetDataCurveSelection(i)->GetCount()
+                         : GetCurveSelection(i)->GetCount());
+
+        for (p=0; p<wxPLOTPEN_MAXTYPE; p++)
+        {
+            wxGenericPen pen(curve->GetPen(wxPlotPen_Type(p)));
+            wxColour c(pen.GetColour());
+            key.Add((long(c.Red()) << 16) | (long(c.Green()) << 8) | long(c.Blue()));
+            key.Add(pen.GetWidth());
+            key.Add(pen.GetStyle());
+        }
+    }
+}
+
+bool wxPlotCtrl::DrawCachedCurves( wxDC *dc, const wxRect &rect )
+{
+    // symbols are bitmaps that may use any colour, so they can't be masked
+    if (!m_cache_curves || !m_drawing_area_bitmap || m_draw_symbols)
+        return false;
+
+    wxRect clientRect(GetPlotAreaRect());
+    wxArrayLong key;
+    GetCurveCacheKey(key);
+
+    bool valid = m_curveBitmap.Ok() && (m_curveCacheView == m_viewRect) &&
+                 (m_curveBitmap.GetWidth()  == clientRect.width) &&
+                 (m_curveBitmap.GetHeight() == clientRect.height) &&
+                 (m_curveCacheKey.GetCount() == key.GetCount());
+
+    size_t n;
+    for (n=0; valid && (n<key.GetCount()); n++)
+        valid = (m_curveCacheKey[n] == key[n]);
+
+    if (!valid)
+    {
+        // draw all of the curves over a colour none of them use and mask it
+        static const unsigned char maskColours[][3] = {
+            {255, 0, 255}, {1, 254, 253}, {253, 1, 254}, {254, 253, 1} };
+        const size_t maskCount = WXSIZEOF(maskColours);
+        wxColour maskColour;
+        size_t m;
+        for (m=0; m<maskCount; m++)
+        {
+            maskColour.Set(maskColours[m][0], maskColours[m][1], maskColours[m][2]);
+            bool used = false;
+            int i, p;
+            for (i=0; !used && (i<GetCurveCount()); i++)
+            {
+                for (p=0; !used && (p<wxPLOTPEN_MAXTYPE); p++)
+                    used = (GetCurve(i)->GetPen(wxPlotPen_Type(p)).GetColour() == maskColour);
+            }
+            if (!used) break;
+        }
+        if (m == maskCount)
+            return false;
+
+        if (!m_curveBitmap.Ok() || (m_curveBitmap.GetWidth()  != clientRect.width) ||
+                                   (m_curveBitmap.GetHeight() != clientRect.height))
+        {
+            m_curveBitmap.Create(clientRect.width, clientRect.height);
+        }
+
+        wxMemoryDC mdc;
+        mdc.SelectObject( m_curveBitmap );
+        mdc.SetBackground( wxBrush(maskColour, wxSOLID) );
+        mdc.Clear();
+#if wxUSE_GRAPHICS_CONTEXT
+        // where the dc draws through a graphics context (Mac, GTK3) an anti-aliased
+        // edge blends the curve into the mask colour and leaves a fringe of it
+        wxGraphicsContext *gc = mdc.GetGraphicsContext();
+        if (gc)
+            gc->SetAntialiasMode(wxANTIALIAS_NONE);
+#endif
+        DrawCurves( &mdc, clientRect );
+        mdc.SelectObject( wxNullBitmap );
+        m_curveBitmap.SetMask(new wxMask(m_curveBitmap, maskColour));
+
+        m_curveCacheView = m_viewRect;
+        m_curveCacheKey  = key;
+    }
+
+    wxMemoryDC mdc;
+    mdc.SelectObject( m_curveBitmap );
+    dc->Blit(rect.x, rect.y, rect.width, rect.height, &mdc, rect.x, rect.y, wxCOPY, true);
+    mdc.SelectObject( wxNullBitmap );
+    return true;
 }
 
 void wxPlotCtrl::DrawMouseMarker( wxDC *dc, int type, const wxRect &rect )
@@ -2736,6 +2861,8 @@ void wxPlotCtrl::DrawCurve( wxDC *dc, wxPlotCurve *curve, int curve_index, const
 
 void wxPlotCtrl::RedrawDataCurve(int index, int min_index, int max_index)
 {
+    // the selection or the cursor may have changed
+    InvalidateCurveCache();
     if (m_batch_count) return;
 
     wxCHECK_RET((index>=0)&&(index<(int)m_curves.GetCount()), wxT("invalid curve index"));
@@ -2783,6 +2910,7 @@ void wxPlotCtrl::RedrawDataCurve(int index, int min_index, int max_index)
 
 void wxPlotCtrl::RedrawCurve(int index, double min_x, double max_x)
 {
+    InvalidateCurveCache();
     if (m_batch_count) return;
 
     wxCHECK_RET((min_x<=max_x)&&(index>=0)&&(index<(int)m_curves.GetCount()), wxT("invalid curve index"));
@@ -66,6 +66,10 @@ public:
     void CopyData(const wxPlotDataRefData &source);
     void CopyExtra(const wxPlotDataRefData &source);
 
+    // Build or free the min/max pyramid of the y data
+    void CreateMinMax();
+    void DestroyMinMax();
+
     int     m_count;
 
     double *m_Xdata;
@@ -75,6 +79,14 @@ public:
 
     bool    m_Xordered;
 
+    // min/max pyramid, level k holds the indexes of the min and max y values
+    //   of each consecutive block of 2^(k+1) points, starting at m_minmaxOffsets[k]
+    int    *m_minIndexes;
+    int    *m_maxIndexes;
+    int     m_minmaxOffsets[32];
+    int     m_minmaxLevels; // 0 if there is no pyramid
+    bool    m_minmaxCreated;
+
     wxBitmap m_normalSymbol,
              m_activeSymbol,
              m_selectedSymbol;
@@ -92,6 +104,11 @@ wxPlotDataRefData::wxPlotDataRefData() : wxPlotCurveRefData()
 
     m_Xordered = false;
 
+    m_minIndexes    = (int*)NULL;
+    m_maxIndexes    = (int*)NULL;
+    m_minmaxLevels  = 0;
+    m_minmaxCreated = false;
+
     m_normalSymbol   = wxPlotSymbolNormal;
     m_activeSymbol   = wxPlotSymbolActive;
     m_selectedSymbol = wxPlotSymbolSelected;
@@ -100,6 +117,16 @@ wxPlotDataRefData::wxPlotDataRefData() : wxPlotCurveRefData()
 wxPlotDataRefData::wxPlotDataRefData(const wxPlotDataRefData& data)
                   :wxPlotCurveRefData()
 {
+    m_Xdata  = (double*)NULL;
+    m_Ydata  = (double*)NULL;
+    m_Yidata = (double*)NULL;
+    m_static = false;
+
+    m_minIndexes    = (int*)NULL;
+    m_maxIndexes    = (int*)NULL;
+    m_minmaxLevels  = 0;
+    m_minmaxCreated = false;
+
     CopyData(data);
     CopyExtra(data);
 }
@@ -123,6 +150,8 @@ void wxPlotDataRefData::Destroy()
     m_Ydata    = NULL;
     m_Yidata   = NULL;
     m_Xordered = false;
+
+    DestroyMinMax();
 }
 
 void wxPlotDataRefData::CopyData(const wxPlotDataRefData &source)
@@ -150,6 +179,87 @@ void wxPlotDataRefData::CopyData(const wxPlotDataRefData &source)
     }
 }
 
+void wxPlotDataRefData::CreateMinMax()
+{
+    DestroyMinMax();
+    m_minmaxCreated = true;
+
+    // only ordered, finite curves can be drawn from the pyramid
+    if (!m_Xordered || (m_count < 2) || !m_Ydata) return;
+
+    const double *y_data = m_Ydata;
+    int i, k, size, total = 0, levels = 0;
+
+    for (i = 0; i < m_count; i++)
+    {
+        if (wxFinite(y_data[i]) == 0) return;
+    }
+
+    for (size = m_count; (size > 1) && (levels < 32); levels++)
+    {
+        size = (size + 1) / 2;
+        m_minmaxOffsets[levels] = total;
+        total += size;
+    }
+
+    m_minIndexes = (int*)malloc( total*sizeof(int) );
+    m_maxIndexes = (int*)malloc( total*sizeof(int) );
+    if (!m_minIndexes || !m_maxIndexes)
+    {
+        DestroyMinMax();
+        m_minmaxCreated = true;
+        return;
+    }
+
+    // level 0 from the data, each later level from the one before,
+    //   keeping the first index on ties
+    int lo0, lo1, hi0, hi1, prev_size = m_count;
+    int *min_prev = NULL, *max_prev = NULL;
+
+    for (k = 0; k < levels; k++)
+    {
+        int *min_level = m_minIndexes + m_minmaxOffsets[k];
+        int *max_level = m_maxIndexes + m_minmaxOffsets[k];
+        size = (prev_size + 1) / 2;
+
+        for (i = 0; i < size; i++)
+        {
+            int j0 = 2*i, j1 = (2*i + 1 < prev_size) ? 2*i + 1 : 2*i;
+
+            if (k == 0)
+            {
+                lo0 = hi0 = j0;
+                lo1 = hi1 = j1;
+            }
+            else
+            {
+                lo0 = min_prev[j0]; lo1 = min_prev[j1];
+                hi0 = max_prev[j0]; hi1 = max_prev[j1];
+            }
+
+            min_level[i] = (y_data[lo1] < y_data[lo0]) ? lo1 : lo0;
+            max_level[i] = (y_data[hi1] > y_data[hi0]) ? hi1 : hi0;
+        }
+
+        min_prev = min_level;
+        max_prev = max_level;
+        prev_size = size;
+    }
+
+    m_minmaxLevels = levels;
+}
+
+void wxPlotDataRefData::DestroyMinMax()
+{
+    if ( m_minIndexes ) free( m_minIndexes );
+    if ( m_maxIndexes ) free( m_maxIndexes );
+
+    m_minIndexes    = NULL;
+    m_maxIndexes    = NULL;
+    m_minmaxLevels  = 0;
+    m_minmaxCreated = false;
+}
+
 void wxPlotDataRefData::CopyExtra(const wxPlotDataRefData &source)
 {
     wxPlotCurveRefData::Copy(source);
@@ -577,6 +687,7 @@ void wxPlotData::CalcBoundingRect()
         M_PLOTDATA->m_boundingRect = wxNullPlotBounds;
 
     M_PLOTDATA->m_Xordered = xordered;
+    M_PLOTDATA->CreateMinMax();
 }
 
 bool wxPlotData::GetIsXOrdered() const
@@ -1110,7 +1221,7 @@ void wxPlotData::SetXValue( int index, double x )
     }
 
     M_PLOTDATA->m_Xdata[index] = x;
-
+    M_PLOTDATA->DestroyMinMax();
 }
 void wxPlotData::SetYValue( int index, double y )
 {
@@ -1129,6 +1240,7 @@ void wxPlotData::SetYValue( int index, double y )
     }
 
     M_PLOTDATA->m_Ydata[index] = y;
+    M_PLOTDATA->DestroyMinMax();
 }
 
 void wxPlotData::SetValue(int index, double x, double y)
@@ -1140,6 +1252,7 @@ void wxPlotData::SetValue(int index, double x, double y)
 
     M_PLOTDATA->m_Xdata[index] = x;
     M_PLOTDATA->m_Ydata[index] = y;
+    M_PLOTDATA->DestroyMinMax();
 
     if (M_PLOTDATA->m_count == 1)
     {
@@ -1179,6 +1292,7 @@ void wxPlotData::SetXValues( int start_index, int count, double x )
     double *x_data = M_PLOTDATA->m_Xdata;
     for (int n = start_index; n <= end_index; n++)
         *x_data++ = x;
+    M_PLOTDATA->DestroyMinMax();
 }
 void wxPlotData::SetYValues( int start_index, int count, double y )
 {
@@ -1191,6 +1305,7 @@ void wxPlotData::SetYValues( int start_index, int count, double y )
     double *y_data = M_PLOTDATA->m_Ydata;
     for (int n = start_index; n <= end_index; n++)
         *y_data++ = y;
+    M_PLOTDATA->DestroyMinMax();
 }
 
 void wxPlotData::SetXStepValues( int start_index, int count, double x_start, double dx )
@@ -1205,6 +1320,7 @@ void wxPlotData::SetXStepValues( int start_index, int count, double x_start, dou
     double *x_data = M_PLOTDATA->m_Xdata + start_index;
     for (int i = 0; i < count; i++, x_data++)
         *x_data = x_start + (i * dx);
+    M_PLOTDATA->DestroyMinMax();
 }
 void wxPlotData::SetYStepValues( int start_index, int count, double y_start, double dy )
 {
@@ -1218,6 +1334,7 @@ void wxPlotData::SetYStepValues( int start_index, int count, double y_start, dou
     double *y_data = M_PLOTDATA->m_Ydata + start_index;
     for (int i = 0; i < count; i++, y_data++)
         *y_data = y_start + (i * dy);
+    M_PLOTDATA->DestroyMinMax();
 }
 
 int wxPlotData::GetIndexFromX( double x, wxPlotData::Index_Type type ) const
@@ -1539,6 +1656,51 @@ int wxPlotData::GetMaxYIndex(int start_index, int end_index) const
     return max_y_index;
 }
 
+bool wxPlotData::GetMinMaxYIndexes(int start_index, int end_index,
+                                   int &min_index, int &max_index) const
+{
+    wxCHECK_MSG( Ok(), false, wxT("Invalid wxPlotData") );
+    wxCHECK_MSG((start_index >= 0) && (start_index <= end_index) && (end_index < M_PLOTDATA->m_count),
+                false, wxT("Invalid data index"));
+
+    if (!M_PLOTDATA->m_minmaxCreated)
+        M_PLOTDATA->CreateMinMax();
+
+    const int levels = M_PLOTDATA->m_minmaxLevels;
+    if (levels == 0) return false;
+
+    const double *y_data = M_PLOTDATA->m_Ydata;
+    int n = start_index, k, block, lo, hi;
+    min_index = max_index = start_index;
+
+    // cover the range with the largest aligned blocks that fit, left to right
+    while (n <= end_index)
+    {
+        for (k = -1; k + 1 < levels; k++)
+        {
+            block = 2 << (k + 1);
+            if (((n & (block - 1)) != 0) || (n + block - 1 > end_index)) break;
+        }
+
+        if (k < 0)
+        {
+            lo = hi = n;
+            n++;
+        }
+        else
+        {
+            lo = M_PLOTDATA->m_minIndexes[M_PLOTDATA->m_minmaxOffsets[k] + (n >> (k + 1))];
+            hi = M_PLOTDATA->m_maxIndexes[M_PLOTDATA->m_minmaxOffsets[k] + (n >> (k + 1))];
+            n += 2 << k;
+        }
+
+        if (y_data[lo] < y_data[min_index]) min_index = lo;
+        if (y_data[hi] > y_data[max_index]) max_index = hi;
+    }
+
+    return true;
+}
+
 //----------------------------------------------------------------------------
 // Data processing functions
 //----------------------------------------------------------------------------
@@ -2772,6 +2934,7 @@ bool wxPlotData::SortByX()
 {
     wxCHECK_MSG( Ok(), false, wxT("Invalid wxPlotData") );
     IMPLEMENT_PIXEL_QSORT2(double, M_PLOTDATA->m_Xdata, M_PLOTDATA->m_Ydata, M_PLOTDATA->m_count);
+    M_PLOTDATA->DestroyMinMax();
     return true;
 }
 
@@ -2779,6 +2942,7 @@ bool wxPlotData::SortByY()
 {
     wxCHECK_MSG( Ok(), false, wxT("Invalid wxPlotData") );
     IMPLEMENT_PIXEL_QSORT2(double, M_PLOTDATA->m_Ydata, M_PLOTDATA->m_Xdata, M_PLOTDATA->m_count);
+    M_PLOTDATA->DestroyMinMax();
     return true;
 }
 
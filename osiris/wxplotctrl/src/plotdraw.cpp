@@ -890,6 +890,16 @@ void wxPlotDrawerDataCurve::Draw(wxDC *dc, wxPlotData* curve, int curve_index)
         }
     }
 
+    // When there are many more points than pixel columns, as for a full view
+    //   of a trace, draw only the points that decide each column's pixels
+    if (x_ordered && (range_count == 0) && (n_end - n_start > 4*dcRect.width) &&
+        m_owner->GetDrawLines() && !m_owner->GetDrawSymbols() && !m_owner->GetDrawSpline() &&
+        DrawDecimated(dc, curve, n_start, n_end))
+    {
+        dc->SetPen(wxNullPen);
+        return;
+    }
+
     // data variables
     const double *x_data = &curve->GetXData()[n_start];
     const double *y_data = &curve->GetYData()[n_start];
@@ -1007,6 +1017,92 @@ void wxPlotDrawerDataCurve::Draw(wxDC *dc, wxPlotData* curve, int curve_index)
     dc->SetPen(wxNullPen);
 }
 
+bool wxPlotDrawerDataCurve::DrawDecimated(wxDC *dc, wxPlotData* curve, int n_start, int n_end)
+{
+    // Draws the same segments as Draw, but through only the first, min, max and
+    //   last points of each pixel column, in index order. The segments between
+    //   the points of a column are all in that column, so together they cover
+    //   the same pixels as the column's min to max, and the segment from one
+    //   column's last point to the next column's first point is unchanged.
+    //   The cost is proportional to the number of columns, not points.
+    int min_index, max_index;
+    if (!curve->GetMinMaxYIndexes(n_start, n_start, min_index, max_index))
+        return false;
+
+    INITIALIZE_FAST_GRAPHICS
+
+    wxRect2DDouble viewRect( GetPlotViewRect() );
+    const double *x_data = curve->GetXData();
+    const double *y_data = curve->GetYData();
+
+    int n, last, lo, hi, mid, column, k, count;
+    int indexes[4];
+    int i0, j0, i1, j1;        // curve coords in pixels
+    double x0, y0, x1, y1;     // original curve coords
+    double xx0, yy0, xx1, yy1; // clipped curve coords
+    int clipped;
+
+    x0 = x_data[n_start];
+    y0 = y_data[n_start];
+
+    for (n = n_start; n < n_end; n = last + 1)
+    {
+        // the points from n to last are in this pixel column
+        column = m_owner->GetClientCoordFromPlotX(x_data[n]);
+        lo = n;
+        hi = n_end - 1;
+        while (lo < hi)
+        {
+            mid = (lo + hi + 1)/2;
+            if (m_owner->GetClientCoordFromPlotX(x_data[mid]) > column)
+                hi = mid - 1;
+            else
+                lo = mid;
+        }
+        last = lo;
+
+        curve->GetMinMaxYIndexes(n, last, min_index, max_index);
+
+        count = 0;
+        indexes[count++] = n;
+        if (min_index > max_index)
+        {
+            int temp = min_index;
+            min_index = max_index;
+            max_index = temp;
+        }
+        if (min_index != indexes[count-1]) indexes[count++] = min_index;
+        if (max_index != indexes[count-1]) indexes[count++] = max_index;
+        if (last      != indexes[count-1]) indexes[count++] = last;
+
+        for (k = 0; k < count; k++)
+        {
+            x1 = x_data[indexes[k]];
+            y1 = y_data[indexes[k]];
+
+            xx0 = x0; yy0 = y0; xx1 = x1; yy1 = y1;
+            clipped = ClipLineToRect(xx0, yy0, xx1, yy1, viewRect);
+            if (clipped != ClippedOut)
+            {
+                i0 = m_owner->GetClientCoordFromPlotX(xx0);
+                j0 = m_owner->GetClientCoordFromPlotY(yy0);
+                i1 = m_owner->GetClientCoordFromPlotX(xx1);
+                j1 = m_owner->GetClientCoordFromPlotY(yy1);
+
+                if ((i0 != i1) || (j0 != j1))
+                {
+                    wxPLOTCTRL_DRAW_LINE(dc, window, pen, i0, j0, i1, j1);
+                }
+            }
+
+            x0 = x1;
+            y0 = y1;
+        }
+    }
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // wxPlotDrawerMarkers
 //-----------------------------------------------------------------------------